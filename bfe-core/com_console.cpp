@@ -41,6 +41,7 @@ CComConsole::CComConsole() : m_strRet(""),
                              m_strFind(""),
                              m_bFirstFind(true),
                              m_nICurrent(0),
+                             m_unCommandCount(0u),
                              m_State(ConsoleStateType::PACKAGE_COMPLETION),
                              m_ConsoleMode(ConsoleModeType::COM)
 {
@@ -64,6 +65,7 @@ void CComConsole::addCommand(const std::string& _strCom)
     
     m_CommandBuffer.push_back(_strCom);
     m_RetValBuffer.push_back(m_strRet);
+    ++m_unCommandCount;
     m_strCurrent = "";
     m_strFind = "";
     m_strFindLast = "";
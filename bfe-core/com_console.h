@@ -32,6 +32,7 @@
 #define COM_CONSOLE_H
 
 //--- Standard header --------------------------------------------------------//
+#include <cstdint>
 
 //--- Program header ---------------------------------------------------------//
 #include "log.h"
@@ -77,6 +78,7 @@ class CComConsole : public IComInterfaceUser
         CComConsole();
         
         //--- Constant Methods -----------------------------------------------//
+        std::uint32_t               getCommandCount() const {return m_unCommandCount;}
         const CommandBufferType&    getCommands() const;
         const std::string&          getCurrentCommand() const;
         ConsoleModeType             getMode() const {return m_ConsoleMode;}
@@ -108,6 +110,7 @@ class CComConsole : public IComInterfaceUser
         std::string         m_strFindLast;   ///< Last command found for completion
         bool                m_bFirstFind;    ///< Signals the first match of search
         int                 m_nICurrent;     ///< Index of currently selected command
+        std::uint32_t       m_unCommandCount;///< Total number of commands added, not limited by buffer capacity
         ConsoleStateType    m_State;         ///< Parsing state (domain, function,...)
         ConsoleModeType     m_ConsoleMode;   ///< Specifies console mode 
 };
@@ -281,6 +281,8 @@ class CComInterface : public bfe::ILogListener
         TRet                call(const std::string&, Args...);
         const std::string   call(const std::string&);
         void                callWriters(const std::string&);
+        template<class TRet, class... TArgs>
+        CCommand<TRet, TArgs...>* getCommand(const std::string&);
         void                help();
         void                help(int);
 
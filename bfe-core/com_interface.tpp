@@ -206,6 +206,28 @@ inline TRet CComInterface::call(const std::string& _strName, Args... _Args)
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Resolves a registered function, to be called without name lookup
+///
+/// The returned command stays valid as long as the com interface exists.
+/// Calling it directly skips callbacks registered to the function.
+///
+/// \param _strName Registered name of the function
+/// \return Command, nullptr if unknown or of different signature
+///
+///////////////////////////////////////////////////////////////////////////////
+template<class TRet, class... TArgs>
+CCommand<TRet, TArgs...>* CComInterface::getCommand(const std::string& _strName)
+{
+    METHOD_ENTRY("CComInterface::getCommand")
+    
+    const auto ci = m_RegisteredFunctions.find(_strName);
+    if (ci == m_RegisteredFunctions.end()) return nullptr;
+    
+    return dynamic_cast<CCommand<TRet, TArgs...>*>(ci->second);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Register the given callback to existing function
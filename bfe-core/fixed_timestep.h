@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       fixed_timestep.h
+/// \brief      Prototype of class "CFixedTimestep"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef FIXED_TIMESTEP_H
+#define FIXED_TIMESTEP_H
+
+//--- Standard header --------------------------------------------------------//
+#include <cmath>
+#include <cstdint>
+
+//--- Program header ---------------------------------------------------------//
+#include "log.h"
+
+/// BFEngine namespace
+namespace bfe
+{
+
+//--- Constants --------------------------------------------------------------//
+constexpr int FIXED_TIMESTEP_SUBSTEPS_MAX_DEFAULT = 8; ///< Default maximum number of steps per frame
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Accumulator, turning frame times into a number of fixed steps
+///
+/// Elapsed (simulation) time of each frame is accumulated and consumed in
+/// steps of constant size. Hence, results do not depend on frame rate or
+/// time acceleration. The number of steps per frame is limited to keep
+/// the cost of a frame bounded, time exceeding the limit is dropped. The
+/// remainder of the accumulator, relative to the step size, is the alpha
+/// value to interpolate between the previous and current state.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CFixedTimestep
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CFixedTimestep() = default;
+
+        //--- Constant Methods -----------------------------------------------//
+        double          getAlpha() const {return m_fAlpha;}
+        std::uint64_t   getNrOfSteps() const {return m_nNrOfSteps;}
+        int             getSubstepsMax() const {return m_nSubstepsMax;}
+        double          getTimeDropped() const {return m_fTimeDropped;}
+        double          getTimestep() const {return m_fTimestep;}
+
+        //--- Methods --------------------------------------------------------//
+        int             advance(const double&);
+        void            reset();
+        void            setSubstepsMax(const int);
+        void            setTimestep(const double&);
+
+    private:
+
+        //--- Variables [private] --------------------------------------------//
+        double          m_fTimestep = 0.0;      ///< Size of one step, 0 if not used
+        double          m_fAccumulator = 0.0;   ///< Time not yet consumed by steps
+        double          m_fAlpha = 0.0;         ///< Remainder of accumulator relative to step size
+        double          m_fTimeDropped = 0.0;   ///< Total time dropped, since steps per frame were limited
+        std::uint64_t   m_nNrOfSteps = 0u;      ///< Total number of steps
+        int             m_nSubstepsMax = FIXED_TIMESTEP_SUBSTEPS_MAX_DEFAULT; ///< Maximum number of steps per frame
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds time of a frame and returns number of steps to be done
+///
+/// Step size must be set.
+///
+/// \param _fTime Elapsed time of frame, including time acceleration
+///
+/// \return Number of steps, at most maximum number of steps per frame
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CFixedTimestep::advance(const double& _fTime)
+{
+    METHOD_ENTRY("CFixedTimestep::advance")
+
+    m_fAccumulator += _fTime;
+
+    double fNrOfSteps = std::floor(m_fAccumulator / m_fTimestep);
+    if (fNrOfSteps > m_nSubstepsMax)
+    {
+        const double fDropped = (fNrOfSteps - m_nSubstepsMax) * m_fTimestep;
+        m_fAccumulator -= fDropped;
+        m_fTimeDropped += fDropped;
+        fNrOfSteps = m_nSubstepsMax;
+    }
+    const int nNrOfSteps = int(fNrOfSteps);
+    m_fAccumulator -= nNrOfSteps * m_fTimestep;
+    if (m_fAccumulator < 0.0) m_fAccumulator = 0.0;
+
+    m_fAlpha = m_fAccumulator / m_fTimestep;
+    m_nNrOfSteps += nNrOfSteps;
+    return nNrOfSteps;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Clears accumulated time and statistics
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CFixedTimestep::reset()
+{
+    METHOD_ENTRY("CFixedTimestep::reset")
+
+    m_fAccumulator = 0.0;
+    m_fAlpha = 0.0;
+    m_fTimeDropped = 0.0;
+    m_nNrOfSteps = 0u;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets maximum number of steps per frame
+///
+/// Values less than 1 would stop the simulation and are rejected.
+///
+/// \param _nSubstepsMax Maximum number of steps per frame, at least 1
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CFixedTimestep::setSubstepsMax(const int _nSubstepsMax)
+{
+    METHOD_ENTRY("CFixedTimestep::setSubstepsMax")
+    
+    if (_nSubstepsMax < 1)
+    {
+        WARNING_MSG("Fixed Timestep", "Invalid maximum number of steps per frame " << _nSubstepsMax <<
+                                      ", must be at least 1.")
+        return;
+    }
+    m_nSubstepsMax = _nSubstepsMax;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets size of one step
+///
+/// Accumulated time is kept if it is less than the new step size, hence,
+/// interpolation stays in [0, 1).
+///
+/// \param _fTimestep Size of step, 0 if not used
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CFixedTimestep::setTimestep(const double& _fTimestep)
+{
+    METHOD_ENTRY("CFixedTimestep::setTimestep")
+
+    m_fTimestep = _fTimestep;
+    if (m_fTimestep > 0.0)
+    {
+        if (m_fAccumulator >= m_fTimestep) m_fAccumulator = 0.0;
+        m_fAlpha = m_fAccumulator / m_fTimestep;
+    }
+}
+
+} // namespace bfe
+
+#endif // FIXED_TIMESTEP_H
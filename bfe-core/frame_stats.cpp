@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       frame_stats.cpp
+/// \brief      Implementation of class "CFrameStats"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-14
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "frame_stats.h"
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <cmath>
+
+//--- Misc header ------------------------------------------------------------//
+
+using namespace bfe;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+////////////////////////////////////////////////////////////////////////////////
+CFrameStats::CFrameStats() : m_Samples(FRAME_STATS_NR_OF_SAMPLES_DEFAULT),
+                             m_strName("Frame Stats"),
+                             m_strUnit("s")
+{
+    METHOD_ENTRY("CFrameStats::CFrameStats")
+    CTOR_CALL("CFrameStats::CFrameStats")
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor, initialising members
+///
+/// \param _strName Name of measurement
+/// \param _strUnit Unit of measurement
+/// \param _nNrOfSamples Length of sample history
+///
+////////////////////////////////////////////////////////////////////////////////
+CFrameStats::CFrameStats(const std::string& _strName, const std::string& _strUnit,
+                         const int _nNrOfSamples) : m_Samples(std::max(1, _nNrOfSamples)),
+                                                    m_strName(_strName),
+                                                    m_strUnit(_strUnit)
+{
+    METHOD_ENTRY("CFrameStats::CFrameStats")
+    CTOR_CALL("CFrameStats::CFrameStats")
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns maximum of sample history
+///
+/// \return Maximum, 0.0 if there are no samples
+///
+////////////////////////////////////////////////////////////////////////////////
+double CFrameStats::getMax() const
+{
+    METHOD_ENTRY("CFrameStats::getMax")
+
+    m_Lock.acquireLock();
+    double fMax = m_Samples.size() > 0 ? m_Samples[0] : 0.0;
+    for (auto i=1u; i<m_Samples.size(); ++i)
+        fMax = std::max(fMax, m_Samples[i]);
+    m_Lock.releaseLock();
+
+    return fMax;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns mean of sample history
+///
+/// \return Mean, 0.0 if there are no samples
+///
+////////////////////////////////////////////////////////////////////////////////
+double CFrameStats::getMean() const
+{
+    METHOD_ENTRY("CFrameStats::getMean")
+
+    double fSum = 0.0;
+
+    m_Lock.acquireLock();
+    const auto nSize = m_Samples.size();
+    for (auto i=0u; i<nSize; ++i)
+        fSum += m_Samples[i];
+    m_Lock.releaseLock();
+
+    return nSize > 0 ? fSum / nSize : 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns minimum of sample history
+///
+/// \return Minimum, 0.0 if there are no samples
+///
+////////////////////////////////////////////////////////////////////////////////
+double CFrameStats::getMin() const
+{
+    METHOD_ENTRY("CFrameStats::getMin")
+
+    m_Lock.acquireLock();
+    double fMin = m_Samples.size() > 0 ? m_Samples[0] : 0.0;
+    for (auto i=1u; i<m_Samples.size(); ++i)
+        fMin = std::min(fMin, m_Samples[i]);
+    m_Lock.releaseLock();
+
+    return fMin;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns given percentile of sample history
+///
+/// The nearest rank method is used, i.e. the returned value is a sample that
+/// is not exceeded by the given percentage of samples.
+///
+/// \param _fPercent Percentile in percent, e.g. 95.0
+///
+/// \return Percentile, 0.0 if there are no samples
+///
+////////////////////////////////////////////////////////////////////////////////
+double CFrameStats::getPercentile(const double& _fPercent) const
+{
+    METHOD_ENTRY("CFrameStats::getPercentile")
+
+    std::vector<double> Samples;
+    this->getSamples(Samples);
+
+    if (Samples.empty()) return 0.0;
+
+    const double fPercent = std::min(std::max(_fPercent, 0.0), 100.0);
+    auto nRank = std::size_t(std::ceil(fPercent * 0.01 * Samples.size()));
+    if (nRank > 0) --nRank;
+
+    std::nth_element(Samples.begin(), Samples.begin()+nRank, Samples.end());
+    return Samples[nRank];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of samples currently in history
+///
+/// \return Number of samples
+///
+////////////////////////////////////////////////////////////////////////////////
+int CFrameStats::getNrOfSamples() const
+{
+    METHOD_ENTRY("CFrameStats::getNrOfSamples")
+
+    m_Lock.acquireLock();
+    const int nSize = int(m_Samples.size());
+    m_Lock.releaseLock();
+
+    return nSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Copies sample history, oldest sample first
+///
+/// \param _Samples Vector to copy samples to
+///
+////////////////////////////////////////////////////////////////////////////////
+void CFrameStats::getSamples(std::vector<double>& _Samples) const
+{
+    METHOD_ENTRY("CFrameStats::getSamples")
+
+    m_Lock.acquireLock();
+    _Samples.resize(m_Samples.size());
+    for (auto i=0u; i<m_Samples.size(); ++i)
+        _Samples[i] = m_Samples[i];
+    m_Lock.releaseLock();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds a sample, replacing the oldest if history is full
+///
+/// \param _fSample Sample to be added
+///
+////////////////////////////////////////////////////////////////////////////////
+void CFrameStats::addSample(const double& _fSample)
+{
+    METHOD_ENTRY("CFrameStats::addSample")
+
+    m_Lock.acquireLock();
+    m_Samples.push_back(_fSample);
+    m_Lock.releaseLock();
+}
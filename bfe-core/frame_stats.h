@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       frame_stats.h
+/// \brief      Prototype of class "CFrameStats"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-14
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+//--- Standard header --------------------------------------------------------//
+#include <string>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "circular_buffer.h"
+#include "log.h"
+#include "spinlock.h"
+
+//--- Misc header ------------------------------------------------------------//
+
+/// BFEngine namespace
+namespace bfe
+{
+
+//--- Constants --------------------------------------------------------------//
+constexpr int FRAME_STATS_NR_OF_SAMPLES_DEFAULT = 256; ///< Default length of sample history
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Rolling history of per frame measurements
+///
+/// The last samples of a measurement (e.g. frame time, vertices uploaded) are
+/// stored in a circular buffer. Statistics like mean or percentiles are
+/// calculated on request from the current history. Samples are usually
+/// written by one thread module and read by another (e.g. the performance
+/// HUD), hence, access is guarded by a spinlock.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CFrameStats
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CFrameStats();
+        CFrameStats(const std::string&, const std::string&,
+                    const int = FRAME_STATS_NR_OF_SAMPLES_DEFAULT);
+        CFrameStats(const CFrameStats&) = delete;
+        CFrameStats& operator=(const CFrameStats&) = delete;
+
+        //--- Constant Methods -----------------------------------------------//
+        double              getMax() const;
+        double              getMean() const;
+        double              getMin() const;
+        double              getPercentile(const double&) const;
+        const std::string&  getName() const {return m_strName;}
+        int                 getNrOfSamples() const;
+        void                getSamples(std::vector<double>&) const;
+        const std::string&  getUnit() const {return m_strUnit;}
+
+        //--- Methods --------------------------------------------------------//
+        void addSample(const double&);
+        void setName(const std::string& _strName) {m_strName = _strName;}
+        void setUnit(const std::string& _strUnit) {m_strUnit = _strUnit;}
+
+    private:
+
+        //--- Variables [private] --------------------------------------------//
+        mutable CSpinlock       m_Lock;     ///< Guards access to samples
+        CCircularBuffer<double> m_Samples;  ///< History of samples, oldest first
+        std::string             m_strName;  ///< Name of measurement, e.g. for display
+        std::string             m_strUnit;  ///< Unit of measurement, e.g. for display
+};
+
+} // namespace bfe
+
+#endif // FRAME_STATS_H
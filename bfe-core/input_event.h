@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       input_event.h
+/// \brief      Compact, timestamped input event records
+///
+/// Input events are captured by the input thread and handed over to
+/// consumers as plain records, independent of the window library.
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INPUT_EVENT_H
+#define INPUT_EVENT_H
+
+//--- Standard header --------------------------------------------------------//
+#include <chrono>
+#include <cstdint>
+
+/// BFEngine namespace
+namespace bfe
+{
+
+//--- Constants --------------------------------------------------------------//
+constexpr std::uint8_t INPUT_BUTTON_LEFT  = 0x01u;  ///< Flag of left mouse button
+constexpr std::uint8_t INPUT_BUTTON_RIGHT = 0x02u;  ///< Flag of right mouse button
+
+constexpr std::int32_t INPUT_MODIFIER_ALT     = 0x01;  ///< Flag of alt key
+constexpr std::int32_t INPUT_MODIFIER_CONTROL = 0x02;  ///< Flag of control key
+constexpr std::int32_t INPUT_MODIFIER_SHIFT   = 0x04;  ///< Flag of shift key
+constexpr std::int32_t INPUT_MODIFIER_SYSTEM  = 0x08;  ///< Flag of system key
+
+/// Specifies current UI mode
+enum class MouseModeType
+{
+    ABSOLUTE,
+    RELATIVE
+};
+
+/// Kind of input event, defines meaning of event data
+enum class InputEventKindType : std::uint8_t
+{
+    CLOSED,                 ///< Window closed, no data
+    RESIZED,                ///< Window resized, width and height
+    KEY_PRESSED,            ///< Key pressed, key code and modifiers
+    MOUSE_BUTTON_PRESSED,   ///< Mouse button pressed, button
+    MOUSE_BUTTON_RELEASED,  ///< Mouse button released, button
+    MOUSE_CURSOR,           ///< Absolute mouse position in window if changed, x and y
+    MOUSE_MOVED,            ///< Mouse moved in relative mode, accumulated movement of frame, x and y
+    MOUSE_WHEEL,            ///< Mouse wheel moved, delta
+    TEXT                    ///< Text entered, unicode character
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Input event record
+///
+////////////////////////////////////////////////////////////////////////////////
+struct InputEventType
+{
+    std::uint64_t       nTime;      ///< Time of capture in nanoseconds, see \ref getInputTime
+    std::int32_t        nA;         ///< First value, depending on kind
+    std::int32_t        nB;         ///< Second value, depending on kind
+    InputEventKindType  Kind;       ///< Kind of event
+    std::uint8_t        nButtons;   ///< Mouse buttons pressed at time of capture
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns current time for input events, monotonic
+///
+/// \return Time in nanoseconds
+///
+////////////////////////////////////////////////////////////////////////////////
+inline std::uint64_t getInputTime()
+{
+    return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace bfe
+
+#endif // INPUT_EVENT_H
@@ -0,0 +1,372 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       input_journal.cpp
+/// \brief      Implementation of class "CInputJournal"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <limits>
+
+#include "input_journal.h"
+
+using namespace bfe;
+
+static_assert(std::numeric_limits<double>::is_iec559 && sizeof(double) == sizeof(std::uint64_t),
+              "Input journal stores frequency as IEEE 754 double.");
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Reads unsigned value of given type little endian from given bytes
+///
+/// \param _pBytes Bytes to read from
+///
+/// \return Value
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T>
+static T loadLittleEndian(const unsigned char* const _pBytes)
+{
+    T Value = 0u;
+    for (auto i=0u; i<sizeof(T); ++i) Value |= T(_pBytes[i]) << (8u*i);
+    return Value;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Writes unsigned value of given type little endian to given bytes
+///
+/// \param _Value Value to be written
+/// \param _pBytes Bytes to write to
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T>
+static void storeLittleEndian(const T _Value, unsigned char* const _pBytes)
+{
+    for (auto i=0u; i<sizeof(T); ++i) _pBytes[i] = static_cast<unsigned char>(_Value >> (8u*i));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+///////////////////////////////////////////////////////////////////////////////
+CInputJournal::CInputJournal() : m_nNext(0u),
+                                 m_fFrequency(0.0),
+                                 m_bRecording(false),
+                                 m_bReplaying(false)
+{
+    METHOD_ENTRY("CInputJournal::CInputJournal")
+    CTOR_CALL("CInputJournal::CInputJournal")
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Destructor, writes remaining records
+///
+///////////////////////////////////////////////////////////////////////////////
+CInputJournal::~CInputJournal()
+{
+    METHOD_ENTRY("CInputJournal::~CInputJournal")
+    DTOR_CALL("CInputJournal::~CInputJournal")
+
+    this->stop();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns next event of given frame while replaying
+///
+/// \param _unFrame Input frame, relative to start of replay
+/// \param _nFrameTime Time of start of frame, used to restore timestamps
+/// \param _Event Event of given frame
+///
+/// \return Another event of given frame available?
+///
+///////////////////////////////////////////////////////////////////////////////
+bool CInputJournal::next(const std::uint32_t _unFrame, const std::uint64_t _nFrameTime,
+                         InputEventType& _Event)
+{
+    METHOD_ENTRY("CInputJournal::next")
+
+    if (!m_bReplaying) return false;
+
+    if (m_nNext == m_Records.size())
+    {
+        INFO_MSG("Input Journal", "Replay finished after " << _unFrame + 1u << " frames.")
+        this->stop();
+        return false;
+    }
+
+    const InputJournalRecord& Record = m_Records[m_nNext];
+    if (Record.unFrame > _unFrame) return false;
+
+    _Event.nTime = _nFrameTime + std::uint64_t(Record.unTime) * 1000u;
+    _Event.nA = Record.nA;
+    _Event.nB = Record.nB;
+    _Event.Kind = InputEventKindType(Record.unKind);
+    _Event.nButtons = Record.unButtons;
+    ++m_nNext;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds given event to journal while recording
+///
+/// Records are buffered and written in blocks.
+///
+/// \param _unFrame Input frame, relative to start of recording
+/// \param _nFrameTime Time of start of frame
+/// \param _Event Event to be recorded
+///
+///////////////////////////////////////////////////////////////////////////////
+void CInputJournal::record(const std::uint32_t _unFrame, const std::uint64_t _nFrameTime,
+                           const InputEventType& _Event)
+{
+    METHOD_ENTRY("CInputJournal::record")
+
+    if (!m_bRecording) return;
+
+    InputJournalRecord Record;
+    Record.unFrame = _unFrame;
+    Record.unTime = (_Event.nTime > _nFrameTime) ? std::uint32_t((_Event.nTime - _nFrameTime) / 1000u) : 0u;
+    Record.nA = _Event.nA;
+    Record.nB = _Event.nB;
+    Record.unKind = std::uint8_t(_Event.Kind);
+    Record.unButtons = _Event.nButtons;
+    m_Records.push_back(Record);
+
+    if (m_Records.size() >= INPUT_JOURNAL_BUFFER_SIZE) this->flush();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Starts recording to given file
+///
+/// \param _strFile File to record to, overwritten if existing
+/// \param _fFrequency Current input frequency, stored for replay
+///
+/// \return Success
+///
+///////////////////////////////////////////////////////////////////////////////
+bool CInputJournal::startRecording(const std::string& _strFile, const double& _fFrequency)
+{
+    METHOD_ENTRY("CInputJournal::startRecording")
+
+    this->stop();
+
+    m_OutStream.open(_strFile, std::ios::out|std::ios::binary|std::ios::trunc);
+    if (!m_OutStream.is_open())
+    {
+        WARNING_MSG("Input Journal", "Could not open " << _strFile << " for recording.")
+        return false;
+    }
+
+    InputJournalHeader Header;
+    Header.fFrequency = _fFrequency;
+    unsigned char aHeader[INPUT_JOURNAL_HEADER_SIZE];
+    encode(Header, aHeader);
+    m_OutStream.write(reinterpret_cast<const char*>(aHeader), INPUT_JOURNAL_HEADER_SIZE);
+
+    m_fFrequency = _fFrequency;
+    m_Records.clear();
+    m_Records.reserve(INPUT_JOURNAL_BUFFER_SIZE);
+    m_bRecording = true;
+
+    INFO_MSG("Input Journal", "Recording input to " << _strFile)
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Starts replay of given file
+///
+/// \param _strFile File to replay
+///
+/// \return Success
+///
+///////////////////////////////////////////////////////////////////////////////
+bool CInputJournal::startReplay(const std::string& _strFile)
+{
+    METHOD_ENTRY("CInputJournal::startReplay")
+
+    this->stop();
+
+    std::ifstream InStream(_strFile, std::ios::in|std::ios::binary|std::ios::ate);
+    if (!InStream.is_open())
+    {
+        WARNING_MSG("Input Journal", "Could not open " << _strFile << " for replay.")
+        return false;
+    }
+    const std::streamsize nSize = InStream.tellg();
+    InStream.seekg(0, std::ios::beg);
+
+    InputJournalHeader Header;
+    unsigned char aHeader[INPUT_JOURNAL_HEADER_SIZE];
+    InStream.read(reinterpret_cast<char*>(aHeader), INPUT_JOURNAL_HEADER_SIZE);
+    if (InStream) decode(aHeader, Header);
+    if (!InStream ||
+        Header.unMagic != INPUT_JOURNAL_MAGIC ||
+        Header.unVersion != INPUT_JOURNAL_VERSION)
+    {
+        WARNING_MSG("Input Journal", _strFile << " is not a valid input journal.")
+        return false;
+    }
+
+    const std::size_t nNrOfRecords = std::size_t(nSize - std::streamsize(INPUT_JOURNAL_HEADER_SIZE)) /
+                                     INPUT_JOURNAL_RECORD_SIZE;
+    std::vector<unsigned char> Bytes(nNrOfRecords * INPUT_JOURNAL_RECORD_SIZE);
+    InStream.read(reinterpret_cast<char*>(Bytes.data()), std::streamsize(Bytes.size()));
+    m_Records.resize(nNrOfRecords);
+    for (auto i=0u; i<nNrOfRecords; ++i)
+    {
+        decode(&Bytes[i * INPUT_JOURNAL_RECORD_SIZE], m_Records[i]);
+    }
+
+    m_fFrequency = Header.fFrequency;
+    m_nNext = 0u;
+    m_bReplaying = true;
+
+    INFO_MSG("Input Journal", "Replaying " << nNrOfRecords << " input events from " << _strFile)
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Stops recording or replay
+///
+///////////////////////////////////////////////////////////////////////////////
+void CInputJournal::stop()
+{
+    METHOD_ENTRY("CInputJournal::stop")
+
+    if (m_bRecording)
+    {
+        this->flush();
+        m_OutStream.close();
+        m_bRecording = false;
+        INFO_MSG("Input Journal", "Recording stopped.")
+    }
+    m_bReplaying = false;
+    m_Records.clear();
+    m_nNext = 0u;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Writes buffered records to file
+///
+///////////////////////////////////////////////////////////////////////////////
+void CInputJournal::flush()
+{
+    METHOD_ENTRY("CInputJournal::flush")
+
+    m_Bytes.resize(m_Records.size() * INPUT_JOURNAL_RECORD_SIZE);
+    for (auto i=0u; i<m_Records.size(); ++i)
+    {
+        encode(m_Records[i], &m_Bytes[i * INPUT_JOURNAL_RECORD_SIZE]);
+    }
+    m_OutStream.write(reinterpret_cast<const char*>(m_Bytes.data()), std::streamsize(m_Bytes.size()));
+    m_Records.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Reads header from bytes in file format
+///
+/// \param _pBytes Bytes of header, INPUT_JOURNAL_HEADER_SIZE
+/// \param _Header Decoded header
+///
+///////////////////////////////////////////////////////////////////////////////
+void CInputJournal::decode(const unsigned char* const _pBytes, InputJournalHeader& _Header)
+{
+    METHOD_ENTRY("CInputJournal::decode")
+
+    _Header.unMagic = loadLittleEndian<std::uint32_t>(_pBytes);
+    _Header.unVersion = loadLittleEndian<std::uint32_t>(_pBytes + 4);
+    const std::uint64_t unFrequency = loadLittleEndian<std::uint64_t>(_pBytes + 8);
+    std::memcpy(&_Header.fFrequency, &unFrequency, sizeof(double));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Reads record from bytes in file format
+///
+/// \param _pBytes Bytes of record, INPUT_JOURNAL_RECORD_SIZE
+/// \param _Record Decoded record
+///
+///////////////////////////////////////////////////////////////////////////////
+void CInputJournal::decode(const unsigned char* const _pBytes, InputJournalRecord& _Record)
+{
+    METHOD_ENTRY("CInputJournal::decode")
+
+    _Record.unFrame = loadLittleEndian<std::uint32_t>(_pBytes);
+    _Record.unTime = loadLittleEndian<std::uint32_t>(_pBytes + 4);
+    _Record.nA = std::int32_t(loadLittleEndian<std::uint32_t>(_pBytes + 8));
+    _Record.nB = std::int32_t(loadLittleEndian<std::uint32_t>(_pBytes + 12));
+    _Record.unKind = _pBytes[16];
+    _Record.unButtons = _pBytes[17];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Writes header to bytes in file format
+///
+/// \param _Header Header to be encoded
+/// \param _pBytes Bytes of header, INPUT_JOURNAL_HEADER_SIZE
+///
+///////////////////////////////////////////////////////////////////////////////
+void CInputJournal::encode(const InputJournalHeader& _Header, unsigned char* const _pBytes)
+{
+    METHOD_ENTRY("CInputJournal::encode")
+
+    std::uint64_t unFrequency = 0u;
+    std::memcpy(&unFrequency, &_Header.fFrequency, sizeof(double));
+    storeLittleEndian(_Header.unMagic, _pBytes);
+    storeLittleEndian(_Header.unVersion, _pBytes + 4);
+    storeLittleEndian(unFrequency, _pBytes + 8);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Writes record to bytes in file format
+///
+/// \param _Record Record to be encoded
+/// \param _pBytes Bytes of record, INPUT_JOURNAL_RECORD_SIZE
+///
+///////////////////////////////////////////////////////////////////////////////
+void CInputJournal::encode(const InputJournalRecord& _Record, unsigned char* const _pBytes)
+{
+    METHOD_ENTRY("CInputJournal::encode")
+
+    storeLittleEndian(_Record.unFrame, _pBytes);
+    storeLittleEndian(_Record.unTime, _pBytes + 4);
+    storeLittleEndian(std::uint32_t(_Record.nA), _pBytes + 8);
+    storeLittleEndian(std::uint32_t(_Record.nB), _pBytes + 12);
+    _pBytes[16] = _Record.unKind;
+    _pBytes[17] = _Record.unButtons;
+}
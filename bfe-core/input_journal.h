@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       input_journal.h
+/// \brief      Prototype of class "CInputJournal"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INPUT_JOURNAL_H
+#define INPUT_JOURNAL_H
+
+//--- Standard header --------------------------------------------------------//
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "input_event.h"
+#include "log.h"
+
+/// BFEngine namespace
+namespace bfe
+{
+
+//--- Constants --------------------------------------------------------------//
+constexpr std::uint32_t INPUT_JOURNAL_MAGIC = 0x49454642u;      ///< Magic number, identifying journal files ("BFEI")
+constexpr std::uint32_t INPUT_JOURNAL_VERSION = 2u;             ///< Version of file format
+constexpr std::size_t   INPUT_JOURNAL_BUFFER_SIZE = 4096u;      ///< Number of records buffered before writing
+constexpr std::size_t   INPUT_JOURNAL_HEADER_SIZE = 16u;        ///< Size of header in files in bytes
+constexpr std::size_t   INPUT_JOURNAL_RECORD_SIZE = 18u;        ///< Size of record in files in bytes
+
+/// Header of input journal files, stored as magic, version, frequency
+struct InputJournalHeader
+{
+    std::uint32_t unMagic = INPUT_JOURNAL_MAGIC;        ///< Magic number, identifying journal files
+    std::uint32_t unVersion = INPUT_JOURNAL_VERSION;    ///< Version of file format
+    double        fFrequency = 0.0;                     ///< Input frequency at time of recording
+};
+
+/// Record of one input event in journal files, stored as fields in order
+struct InputJournalRecord
+{
+    std::uint32_t unFrame;      ///< Input frame, relative to start of recording
+    std::uint32_t unTime;       ///< Time of capture relative to start of frame in microseconds
+    std::int32_t  nA;           ///< First value, depending on kind
+    std::int32_t  nB;           ///< Second value, depending on kind
+    std::uint8_t  unKind;       ///< Kind of event
+    std::uint8_t  unButtons;    ///< Mouse buttons pressed at time of capture
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Records input events to a binary file and replays them
+///
+/// Events are stored with the input frame they were captured in and their
+/// time relative to the start of that frame. On replay, events are returned
+/// frame by frame, independent of wall clock, hence, the same sequence of
+/// input frames receives the same events. The whole journal is loaded on
+/// start of replay, so reading does not touch the disk while replaying.
+///
+/// Files don't depend on platform: Header and record fields are written
+/// one by one in little endian byte order, without padding.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CInputJournal
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CInputJournal();
+        ~CInputJournal();
+
+        //--- Constant Methods -----------------------------------------------//
+        double      getFrequency() const {return m_fFrequency;}
+        bool        isRecording() const {return m_bRecording;}
+        bool        isReplaying() const {return m_bReplaying;}
+
+        //--- Methods --------------------------------------------------------//
+        bool        next(const std::uint32_t, const std::uint64_t, InputEventType&);
+        void        record(const std::uint32_t, const std::uint64_t, const InputEventType&);
+        bool        startRecording(const std::string&, const double&);
+        bool        startReplay(const std::string&);
+        void        stop();
+
+    private:
+
+        //--- Methods [private] ----------------------------------------------//
+        void        flush();
+
+        static void decode(const unsigned char* const, InputJournalHeader&);
+        static void decode(const unsigned char* const, InputJournalRecord&);
+        static void encode(const InputJournalHeader&, unsigned char* const);
+        static void encode(const InputJournalRecord&, unsigned char* const);
+
+        //--- Variables [private] --------------------------------------------//
+        std::ofstream                   m_OutStream;    ///< File stream for recording
+        std::vector<InputJournalRecord> m_Records;      ///< Records to be written or replayed
+        std::vector<unsigned char>      m_Bytes;        ///< Encoded records to be written
+        std::size_t                     m_nNext;        ///< Next record to be replayed
+        double                          m_fFrequency;   ///< Input frequency of recording
+        bool                            m_bRecording;   ///< Recording active?
+        bool                            m_bReplaying;   ///< Replay active?
+};
+
+} // namespace bfe
+
+#endif // INPUT_JOURNAL_H
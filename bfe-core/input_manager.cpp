@@ -38,7 +38,15 @@ using namespace bfe;
 ///
 ///////////////////////////////////////////////////////////////////////////////
 CInputManager::CInputManager() : m_pWindow(nullptr),
-                                 m_MouseMode(MouseModeType::RELATIVE)
+                                 m_MouseMode(MouseModeType::RELATIVE),
+                                 m_nButtons(0u),
+                                 m_LatencyStats("Input latency", "s"),
+                                 m_bDeferredDispatch(false),
+                                 m_bDispatching(false),
+                                 m_nNrOfDropped(0u),
+                                 m_unFrame(0u),
+                                 m_nFrameTime(0u),
+                                 m_bBindingsChanged(false)
 {
     METHOD_ENTRY("CInputManager::CInputManager")
     CTOR_CALL("CInputManager::CInputManager")
@@ -49,12 +57,68 @@ CInputManager::CInputManager() : m_pWindow(nullptr),
     
     m_vecMouse = {0,0};
     m_vecMouseCenter = {0,0};
+    m_vecMouseCursor = {-1,-1};
+    
+    m_KeyBindings.bindDefaults();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Handles all queued input events
+///
+/// Events are drained in batches. Called at the end of \ref processFrame or,
+/// with deferred dispatch, by the consumer at the start of its frame.
+/// Pending key bindings are applied first. If another thread is dispatching
+/// already, e.g. while deferred dispatch is switched, nothing is done.
+///
+/// \return Number of events handled
+///
+////////////////////////////////////////////////////////////////////////////////
+std::size_t CInputManager::dispatchEvents()
+{
+    METHOD_ENTRY("CInputManager::dispatchEvents")
+    
+    if (m_bDispatching.exchange(true, std::memory_order_acquire)) return 0u;
+    
+    if (m_bBindingsChanged.load(std::memory_order_acquire))
+    {
+        m_PendingBindingsLock.acquireLock();
+        for (const auto& Binding : m_PendingBindings)
+            m_KeyBindings.bind(Binding[0], Binding[1], Binding[2], Binding[3]);
+        m_PendingBindings.clear();
+        m_bBindingsChanged.store(false, std::memory_order_release);
+        m_PendingBindingsLock.releaseLock();
+    }
+    
+    InputEventType aEvents[INPUT_EVENT_BATCH_SIZE];
+    std::size_t nNrOfEvents = 0u;
+    std::size_t nNrOfBatch = 0u;
+    
+    while ((nNrOfBatch = m_Events.pop(aEvents, INPUT_EVENT_BATCH_SIZE)) > 0u)
+    {
+        const std::uint64_t nTime = getInputTime();
+        const int nCamMainUID = m_pComInterface->call<int>("get_main_camera");
+        
+        for (auto i=0u; i<nNrOfBatch; ++i)
+        {
+            m_LatencyStats.addSample(double(nTime - aEvents[i].nTime) * 1.0e-9);
+            this->handleEvent(aEvents[i], nCamMainUID);
+        }
+        nNrOfEvents += nNrOfBatch;
+    }
+    
+    m_bDispatching.store(false, std::memory_order_release);
+    return nNrOfEvents;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Processes one input frame
 ///
+/// The window is polled and events are queued. While replaying, events of
+/// the journal's current frame are queued instead. Unless dispatch is
+/// deferred, they are handled afterwards.
+///
 /// \return Success
 ///
 ////////////////////////////////////////////////////////////////////////////////
@@ -62,241 +126,259 @@ bool CInputManager::processFrame()
 {
     METHOD_ENTRY("CInputManager::processFrame")
     
-    sf::Vector2i vecMouse = sf::Mouse::getPosition(*m_pWindow);
-    m_vecMouse = m_vecMouseCenter-vecMouse;
-    m_vecMouse.x = -m_vecMouse.x; // Horizontal movements to the left should be negative
-    if (m_MouseMode == MouseModeType::RELATIVE)
-        sf::Mouse::setPosition(m_vecMouseCenter,*m_pWindow);
+    m_nFrameTime = getInputTime();
+    
+    if (m_Journal.isReplaying())
+    {
+        InputEventType Event;
+        while (m_Journal.next(m_unFrame, m_nFrameTime, Event))
+        {
+            m_nButtons = Event.nButtons;
+            this->pushEvent(Event.Kind, Event.nA, Event.nB, Event.nTime);
+        }
+    }
+    else if (m_pWindow != nullptr)
+    {
+        this->pollWindow(m_nFrameTime);
+    }
+    ++m_unFrame;
+    
+    if (!m_bDeferredDispatch) this->dispatchEvents();
     
-    m_pComInterface->call<void, int, int>("mouse_set_cursor", vecMouse.x, vecMouse.y);
+    m_pComInterface->callWriters("input");
+    
+    return true; 
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Polls the window and queues its events
+///
+/// \param _nTime Time of start of frame, i.e. capture
+///
+////////////////////////////////////////////////////////////////////////////////
+void CInputManager::pollWindow(const std::uint64_t _nTime)
+{
+    METHOD_ENTRY("CInputManager::pollWindow")
+    
+    // Buttons are polled once per frame, not per event
+    m_nButtons = (sf::Mouse::isButtonPressed(sf::Mouse::Left)  ? INPUT_BUTTON_LEFT  : 0u) |
+                 (sf::Mouse::isButtonPressed(sf::Mouse::Right) ? INPUT_BUTTON_RIGHT : 0u);
+    
+    //--- Coalesce mouse movement ---//
+    // Only the latest position of this frame is queued, and only if it
+    // changed. In relative mode, the cursor is re-centred once per frame,
+    // hence, its offset is the accumulated movement of all move events.
+    const sf::Vector2i vecMouse = sf::Mouse::getPosition(*m_pWindow);
+    if (vecMouse != m_vecMouseCursor)
+    {
+        m_vecMouseCursor = vecMouse;
+        this->pushEvent(InputEventKindType::MOUSE_CURSOR, vecMouse.x, vecMouse.y, _nTime);
+    }
+    if (m_MouseMode == MouseModeType::RELATIVE && vecMouse != m_vecMouseCenter)
+    {
+        m_vecMouse = m_vecMouseCenter-vecMouse;
+        m_vecMouse.x = -m_vecMouse.x; // Horizontal movements to the left should be negative
+        sf::Mouse::setPosition(m_vecMouseCenter,*m_pWindow);
+        this->pushEvent(InputEventKindType::MOUSE_MOVED, m_vecMouse.x, m_vecMouse.y, _nTime);
+    }
 
-    //--- Handle events ---//
+    //--- Queue events ---//
     sf::Event Event;
     while (m_pWindow->pollEvent(Event))
     {
-        int nCamMainUID = m_pComInterface->call<int>("get_main_camera");
-        
         switch (Event.type)
         {
             case sf::Event::Closed:
-            {
-                // End the program
-                m_pComInterface->call<void>("quit");
+                this->pushEvent(InputEventKindType::CLOSED, 0, 0, _nTime);
                 break;
-            }
             case sf::Event::Resized:
-            {
-                // Adjust the viewport when the window is resized
                 m_vecMouseCenter = sf::Vector2i(m_pWindow->getSize().x >> 1, m_pWindow->getSize().y >> 1);
-                m_pComInterface->call<void,double,double>("win_main_resize_viewport", Event.size.width, Event.size.height);
-                
-                m_pComInterface->call<void,double,double>("e_resize", Event.size.width, Event.size.height);
+                this->pushEvent(InputEventKindType::RESIZED, Event.size.width, Event.size.height, _nTime);
                 break;
-            }
             case sf::Event::KeyPressed:
+                this->pushEvent(InputEventKindType::KEY_PRESSED, Event.key.code,
+                                (Event.key.alt     ? INPUT_MODIFIER_ALT     : 0) |
+                                (Event.key.control ? INPUT_MODIFIER_CONTROL : 0) |
+                                (Event.key.shift   ? INPUT_MODIFIER_SHIFT   : 0) |
+                                (Event.key.system  ? INPUT_MODIFIER_SYSTEM  : 0), _nTime);
+                break;
+            case sf::Event::MouseButtonPressed:
+                this->pushEvent(InputEventKindType::MOUSE_BUTTON_PRESSED, Event.mouseButton.button, 0, _nTime);
+                break;
+            case sf::Event::MouseButtonReleased:
+                this->pushEvent(InputEventKindType::MOUSE_BUTTON_RELEASED, Event.mouseButton.button, 0, _nTime);
+                break;
+            case sf::Event::MouseWheelMoved:
+                this->pushEvent(InputEventKindType::MOUSE_WHEEL, Event.mouseWheel.delta, 0, _nTime);
+                break;
+            case sf::Event::TextEntered:
+                this->pushEvent(InputEventKindType::TEXT, Event.text.unicode, 0, _nTime);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Handles one input event
+///
+/// \param _Event Event to be handled
+/// \param _nCamMainUID UID of main camera, 0 if none
+///
+////////////////////////////////////////////////////////////////////////////////
+void CInputManager::handleEvent(const InputEventType& _Event, const int _nCamMainUID)
+{
+    METHOD_ENTRY("CInputManager::handleEvent")
+    
+    switch (_Event.Kind)
+    {
+        case InputEventKindType::MOUSE_CURSOR:
+        {
+            m_pComInterface->call<void, int, int>("mouse_set_cursor", _Event.nA, _Event.nB);
+            break;
+        }
+        case InputEventKindType::CLOSED:
+        {
+            // End the program
+            m_pComInterface->call<void>("quit");
+            break;
+        }
+        case InputEventKindType::RESIZED:
+        {
+            // Adjust the viewport when the window is resized
+            m_pComInterface->call<void,double,double>("win_main_resize_viewport", _Event.nA, _Event.nB);
+            
+            m_pComInterface->call<void,double,double>("e_resize", _Event.nA, _Event.nB);
+            break;
+        }
+        case InputEventKindType::KEY_PRESSED:
+        {
+            if (m_MouseMode == MouseModeType::RELATIVE)
+                m_pComInterface->call<void, int>("e_key_pressed", _Event.nA);
+            
+            // Home switches mouse mode, which selects the set of bindings
+            if (_Event.nA == sf::Keyboard::Home)
             {
-                if (Event.key.code == sf::Keyboard::Escape) m_pComInterface->call<void>("exit");
-                    
                 if (m_MouseMode == MouseModeType::ABSOLUTE)
                 {
-                    switch (Event.key.code)
-                    {
-                        case sf::Keyboard::F2:
-                        {
-                            m_pComInterface->call<void>("toggle_debug_info");
-                            break;
-                        }
-                        case sf::Keyboard::F3:
-                        {
-                            m_pComInterface->call<void>("toggle_debug_render");
-                            break;
-                        }
-                        case sf::Keyboard::BackSpace:
-                        {
-                            m_pComInterface->call<void>("com_console_backspace");
-                            break;
-                        }
-                        case sf::Keyboard::Home:
-                        {
-                            m_MouseMode = MouseModeType::RELATIVE;
-                            m_pComInterface->call<void>("mouse_cursor_off");
-                            m_pComInterface->call<void>("com_console_off");
-                            break;
-                        }
-                        case sf::Keyboard::Up:
-                        {
-                            m_pComInterface->call<void>("com_console_prev");
-                            break;
-                        }
-                        case sf::Keyboard::Down:
-                        {
-                            m_pComInterface->call<void>("com_console_next");
-                            break;
-                        }
-                        case sf::Keyboard::Return:
-                        {
-                            m_pComInterface->call<void>("com_console_execute");
-                            break;
-                        }
-                        case sf::Keyboard::Tab:
-                        {
-                            m_pComInterface->call<void>("com_console_complement");
-                            break;
-                        }
-                        case sf::Keyboard::U:
-                        {
-                            
-                            if (sf::Keyboard::isKeyPressed(sf::Keyboard::LControl))
-                            {
-                                m_pComInterface->call<void>("uid_vis_toggle");
-                            }
-                            break;
-                        }
-                        case sf::Keyboard::W:
-                        {
-                            if (sf::Keyboard::isKeyPressed(sf::Keyboard::LControl))
-                            {
-                                m_pComInterface->call<void>("win_show_all");
-                            }
-                            if (sf::Keyboard::isKeyPressed(sf::Keyboard::LAlt))
-                            {
-                                m_pComInterface->call<void>("win_hide_all");
-                            }
-                            break;
-                        }
-                        default:
-                            break;
-                    }
+                    m_MouseMode = MouseModeType::RELATIVE;
+                    m_pComInterface->call<void>("mouse_cursor_off");
+                    m_pComInterface->call<void>("com_console_off");
                 }
                 else
                 {
-                    m_pComInterface->call<void, int>("e_key_pressed", Event.key.code);
-                    
-                    switch (Event.key.code)
-                    {
-                        case sf::Keyboard::Home:
-                        {
-                            m_MouseMode = MouseModeType::ABSOLUTE;
-                            m_pComInterface->call<void>("mouse_cursor_on");
-                            m_pComInterface->call<void>("com_console_on");
-                            break;
-                        }
-                        case sf::Keyboard::F2:
-                        {
-                            m_pComInterface->call<void>("toggle_debug_info");
-                            break;
-                        }
-                        case sf::Keyboard::F3:
-                        {
-                            m_pComInterface->call<void>("toggle_debug_render");
-                            break;
-                        }
-                        case sf::Keyboard::U:
-                        {
-                            if (sf::Keyboard::isKeyPressed(sf::Keyboard::LControl))
-                            {
-                                m_pComInterface->call<void>("uid_vis_toggle");
-                            }
-                            break;
-                        }
-                        case sf::Keyboard::W:
-                        {
-                            if (sf::Keyboard::isKeyPressed(sf::Keyboard::LControl))
-                            {
-                                m_pComInterface->call<void>("win_show_all");
-                            }
-                            if (sf::Keyboard::isKeyPressed(sf::Keyboard::LAlt))
-                            {
-                                m_pComInterface->call<void>("win_hide_all");
-                                
-                            }
-                            break;
-                        }
-                        default:
-                            break;
-                    }
+                    m_MouseMode = MouseModeType::ABSOLUTE;
+                    m_pComInterface->call<void>("mouse_cursor_on");
+                    m_pComInterface->call<void>("com_console_on");
                 }
                 break;
             }
-            case sf::Event::MouseButtonPressed:
+            
+            m_KeyBindings.dispatch(m_pComInterface, m_MouseMode, _Event.nA, _Event.nB);
+            break;
+        }
+        case InputEventKindType::MOUSE_BUTTON_PRESSED:
+        {
+            if (m_MouseMode == MouseModeType::ABSOLUTE)
             {
-                if (m_MouseMode == MouseModeType::ABSOLUTE)
+                if (_Event.nA == sf::Mouse::Left)
                 {
-                    if (Event.mouseButton.button == sf::Mouse::Left)
-                    {
-                        m_pComInterface->call<void>("mouse_mbl_pressed");
-                    }
+                    m_pComInterface->call<void>("mouse_mbl_pressed");
                 }
-                break;
             }
-            case sf::Event::MouseButtonReleased:
+            break;
+        }
+        case InputEventKindType::MOUSE_BUTTON_RELEASED:
+        {
+            if (m_MouseMode == MouseModeType::ABSOLUTE)
             {
-                if (m_MouseMode == MouseModeType::ABSOLUTE)
+                if (_Event.nA == sf::Mouse::Left)
                 {
-                    if (Event.mouseButton.button == sf::Mouse::Left)
-                    {
-                        m_pComInterface->call<void>("mouse_mbl_released");
-                    }
+                    m_pComInterface->call<void>("mouse_mbl_released");
                 }
-                break;
             }
-            case sf::Event::MouseMoved:
+            break;
+        }
+        case InputEventKindType::MOUSE_MOVED:
+        {
+            if (m_MouseMode == MouseModeType::RELATIVE && _nCamMainUID != 0)
             {
-                if (m_MouseMode == MouseModeType::RELATIVE && nCamMainUID != 0)
+                if (_Event.nButtons & INPUT_BUTTON_LEFT)
                 {
-                    if (sf::Mouse::isButtonPressed(sf::Mouse::Left))
-                    {
-                        double fZoom = m_pComInterface->call<double, int>("cam_get_zoom", nCamMainUID);
-                        m_pComInterface->call<void, int, double, double>("cam_translate_by", nCamMainUID,
-                                        0.2/2.0*double(m_vecMouse.x)/fZoom,
-                                        0.2/2.0*double(m_vecMouse.y)/fZoom);
-                    }
-                    if (sf::Mouse::isButtonPressed(sf::Mouse::Right))
-                    {
-                        m_pComInterface->call<void, int, double>("cam_rotate_by", nCamMainUID, -double(m_vecMouse.x)*0.001);
-                        m_pComInterface->call<void, int, double>("cam_zoom_by", nCamMainUID, 1.0+double(m_vecMouse.y)*0.001);
-                        double fZoom = m_pComInterface->call<double, int>("cam_get_zoom", nCamMainUID);
-                        if (fZoom < 1.0e-18)
-                            m_pComInterface->call<void, int, double>("cam_zoom_to", nCamMainUID, 1.0e-18);
-                        else if (fZoom > 1.0e3)
-                            m_pComInterface->call<void, int, double>("cam_zoom_to", nCamMainUID, 1.0e3);
-                    }
+                    double fZoom = m_pComInterface->call<double, int>("cam_get_zoom", _nCamMainUID);
+                    m_pComInterface->call<void, int, double, double>("cam_translate_by", _nCamMainUID,
+                                    0.2/2.0*double(_Event.nA)/fZoom,
+                                    0.2/2.0*double(_Event.nB)/fZoom);
                 }
-                break;
-            }
-            case sf::Event::MouseWheelMoved:
-            {
-                if (nCamMainUID != 0)
+                if (_Event.nButtons & INPUT_BUTTON_RIGHT)
                 {
-                    m_pComInterface->call<void, int, double>("cam_zoom_by", nCamMainUID, 1.0+double(Event.mouseWheel.delta)*0.1);
-                    double fZoom = m_pComInterface->call<double, int>("cam_get_zoom", nCamMainUID);
+                    m_pComInterface->call<void, int, double>("cam_rotate_by", _nCamMainUID, -double(_Event.nA)*0.001);
+                    m_pComInterface->call<void, int, double>("cam_zoom_by", _nCamMainUID, 1.0+double(_Event.nB)*0.001);
+                    double fZoom = m_pComInterface->call<double, int>("cam_get_zoom", _nCamMainUID);
                     if (fZoom < 1.0e-18)
-                        m_pComInterface->call<void, int, double>("cam_zoom_to", nCamMainUID, 1.0e-18);
+                        m_pComInterface->call<void, int, double>("cam_zoom_to", _nCamMainUID, 1.0e-18);
                     else if (fZoom > 1.0e3)
-                        m_pComInterface->call<void, int, double>("cam_zoom_to", nCamMainUID, 1.0e3);
+                        m_pComInterface->call<void, int, double>("cam_zoom_to", _nCamMainUID, 1.0e3);
                 }
-                break;
             }
-            case sf::Event::TextEntered:
+            break;
+        }
+        case InputEventKindType::MOUSE_WHEEL:
+        {
+            if (_nCamMainUID != 0)
             {
-                if (m_MouseMode == MouseModeType::ABSOLUTE)
+                m_pComInterface->call<void, int, double>("cam_zoom_by", _nCamMainUID, 1.0+double(_Event.nA)*0.1);
+                double fZoom = m_pComInterface->call<double, int>("cam_get_zoom", _nCamMainUID);
+                if (fZoom < 1.0e-18)
+                    m_pComInterface->call<void, int, double>("cam_zoom_to", _nCamMainUID, 1.0e-18);
+                else if (fZoom > 1.0e3)
+                    m_pComInterface->call<void, int, double>("cam_zoom_to", _nCamMainUID, 1.0e3);
+            }
+            break;
+        }
+        case InputEventKindType::TEXT:
+        {
+            if (m_MouseMode == MouseModeType::ABSOLUTE)
+            {
+                if (_Event.nA > 31 && _Event.nA < 127)
                 {
-                    if (Event.text.unicode > 31 && Event.text.unicode < 127)
-                    {
-                        m_pComInterface->call<void, std::string>("com_console_expand", sf::String(Event.text.unicode).toAnsiString());
-                    }
+                    m_pComInterface->call<void, std::string>("com_console_expand", sf::String(sf::Uint32(_Event.nA)).toAnsiString());
                 }
-                break;
             }
-            default:
-                break;
+            break;
         }
     }
-    m_pComInterface->callWriters("input");
-    
-    return true; 
 }
 
+#ifdef BFE_MULTITHREADING
+  ///////////////////////////////////////////////////////////////////////////////
+  ///
+  /// \brief Reports frequency adapted to load
+  ///
+  ///////////////////////////////////////////////////////////////////////////////
+  void CInputManager::frequencyChanged()
+  {
+      METHOD_ENTRY("CInputManager::frequencyChanged")
+      m_pComInterface->call<void, double>("e_frequency_changed_input", m_fFrequency);
+  }
+  
+  ///////////////////////////////////////////////////////////////////////////////
+  ///
+  /// \brief Reports level of work to shed, to be handled by listeners
+  ///
+  /// \param _nLevel Level of work to shed, 0: full work
+  ///
+  ///////////////////////////////////////////////////////////////////////////////
+  void CInputManager::shedLoad(const int _nLevel)
+  {
+      METHOD_ENTRY("CInputManager::shedLoad")
+      m_pComInterface->call<void, int>("e_load_level_changed_input", _nLevel);
+  }
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Initialise the command interface
@@ -321,12 +403,79 @@ void CInputManager::myInitComInterface()
                                         {ParameterType::DOUBLE, "Size_Y"}},
                                     "system");
     
+    #ifdef BFE_MULTITHREADING
+        m_pComInterface->registerEvent<double>("e_frequency_changed_input",
+                                        "Event, indicating that the frequency of the input thread was adapted to load.",
+                                        {{ParameterType::NONE, "No return value"},
+                                            {ParameterType::DOUBLE, "Frequency"}},
+                                        "system");
+        m_pComInterface->registerEvent<int>("e_load_level_changed_input",
+                                        "Event, indicating that the level of optional work the input thread should shed changed.",
+                                        {{ParameterType::NONE, "No return value"},
+                                            {ParameterType::INT, "Level of work to shed, 0: full work"}},
+                                        "system");
+    #endif
     // System package
+    m_pComInterface->registerFunction("get_input_latency",
+                                        CCommand<double>([&]() -> double {return this->m_LatencyStats.getMean();}),
+                                        "Provides mean time from capture to dispatch of input events.",
+                                        {{ParameterType::DOUBLE, "Mean input latency [s]"}},
+                                        "system");
     m_pComInterface->registerFunction("get_input_frequency",
                                         CCommand<double>([&]() -> double {return this->m_fFrequency;}),
                                         "Provides processing frequency of Input module.",
                                         {{ParameterType::DOUBLE, "Processing frequency of Input module"}},
                                         "system");
+    m_pComInterface->registerFunction("input_record",
+                                        CCommand<void, std::string>([&](const std::string& _strFile)
+                                        {
+                                            this->startRecording(_strFile);
+                                        }),
+                                        "Starts recording of input events to given journal file.",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::STRING, "Journal file"}},
+                                        "system", "input");
+    m_pComInterface->registerFunction("input_replay",
+                                        CCommand<void, std::string>([&](const std::string& _strFile)
+                                        {
+                                            this->startReplay(_strFile);
+                                        }),
+                                        "Replays input events from given journal file instead of polling the window.",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::STRING, "Journal file"}},
+                                        "system", "input");
+    m_pComInterface->registerFunction("input_bind_key",
+                                        CCommand<void, std::string, std::string, std::string, std::string>(
+                                            [&](const std::string& _strMode, const std::string& _strKey,
+                                                const std::string& _strModifiers, const std::string& _strCommand)
+                                        {
+                                            m_PendingBindingsLock.acquireLock();
+                                            m_PendingBindings.push_back({{_strMode, _strKey, _strModifiers, _strCommand}});
+                                            m_bBindingsChanged.store(true, std::memory_order_release);
+                                            m_PendingBindingsLock.releaseLock();
+                                        }),
+                                        "Binds a command without parameters to a key. Modifiers are combined by '+' "
+                                        "(Alt, Ctrl, Shift, System), '*' matches any. An empty command removes the binding.",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::STRING, "Mouse mode (ui, world, all)"},
+                                        {ParameterType::STRING, "Key name, e.g. F2"},
+                                        {ParameterType::STRING, "Modifiers, e.g. Ctrl+Shift"},
+                                        {ParameterType::STRING, "Command"}},
+                                        "system");
+    m_pComInterface->registerFunction("input_dispatch_events",
+                                        CCommand<int>([&]() -> int
+                                        {
+                                            if (!m_bDeferredDispatch) return 0;
+                                            return int(this->dispatchEvents());
+                                        }),
+                                        "Handles queued input events on the calling thread if dispatch is deferred.",
+                                        {{ParameterType::INT, "Number of events handled"}},
+                                        "system");
+    m_pComInterface->registerFunction("input_journal_stop",
+                                        CCommand<void>([&](){this->stopJournal();}),
+                                        "Stops recording or replay of input events.",
+                                        {{ParameterType::NONE, "No return value"}},
+                                        "system", "input");
     m_pComInterface->registerFunction("key_is_pressed",
                                         CCommand<bool, int>([&](const int _nCode) -> bool
                                         {
@@ -336,6 +485,51 @@ void CInputManager::myInitComInterface()
                                         {{ParameterType::BOOL, "Is given key pressed?"},
                                         {ParameterType::INT, "Key code"}},
                                         "system");
+    #ifdef BFE_MULTITHREADING
+        m_pComInterface->registerFunction("get_thread_placement_input",
+                                            CCommand<std::string>([&]() -> std::string {return this->getPlacement();}),
+                                            "Provides CPU affinity and scheduling granted to the input thread.",
+                                            {{ParameterType::STRING, "Placement of input thread"}},
+                                            "system");
+        m_pComInterface->registerFunction("set_frequency_range_input",
+                                            CCommand<void, double, double>([&](const double& _fMin, const double& _fMax)
+                                            {
+                                                this->setFrequencyRange(_fMin, _fMax);
+                                            }),
+                                            "Lets the frequency of the input thread adapt to load within given range, maximum 0 switches off.",
+                                            {{ParameterType::NONE, "No return value"},
+                                            {ParameterType::DOUBLE, "Minimum frequency"},
+                                            {ParameterType::DOUBLE, "Maximum frequency"}},
+                                            "system", "input");
+        m_pComInterface->registerFunction("set_thread_affinity_input",
+                                            CCommand<void, std::string>([&](const std::string& _strCPUs)
+                                            {
+                                                this->setAffinity(_strCPUs);
+                                            }),
+                                            "Sets CPUs the input thread may run on, e.g. \"0,2-3\", empty for all.",
+                                            {{ParameterType::NONE, "No return value"},
+                                            {ParameterType::STRING, "List of CPUs"}},
+                                            "system");
+        m_pComInterface->registerFunction("set_thread_scheduling_input",
+                                            CCommand<void, std::string, int>([&](const std::string& _strPolicy, const int _nPriority)
+                                            {
+                                                this->setScheduling(_strPolicy, _nPriority);
+                                            }),
+                                            "Sets scheduling policy (default, fifo, rr) and priority of the input thread.",
+                                            {{ParameterType::NONE, "No return value"},
+                                            {ParameterType::STRING, "Policy"},
+                                            {ParameterType::INT, "Priority"}},
+                                            "system");
+    #endif
+    m_pComInterface->registerFunction("input_set_deferred_dispatch",
+                                        CCommand<void, bool>([&](const bool _bDeferred)
+                                        {
+                                            this->setDeferredDispatch(_bDeferred);
+                                        }),
+                                        "Defers handling of input events to the consumer's frame (see input_dispatch_events).",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::BOOL, "Deferred dispatch?"}},
+                                        "system");
     m_pComInterface->registerFunction("set_frequency_input",
                                         CCommand<void, double>([&](const double& _fFrequency)
                                         {
@@ -365,3 +559,85 @@ void CInputManager::myInitComInterface()
                                         {{ParameterType::NONE, "No return value"}},
                                         "system", "input");
 }
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Starts recording of input events to given file
+///
+/// \param _strFile Journal file, overwritten if existing
+///
+/// \return Success
+///
+////////////////////////////////////////////////////////////////////////////////
+bool CInputManager::startRecording(const std::string& _strFile)
+{
+    METHOD_ENTRY("CInputManager::startRecording")
+    
+    m_unFrame = 0u;
+    return m_Journal.startRecording(_strFile, m_fFrequency);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Starts replay of input events from given file
+///
+/// The window is not polled while replaying. The input frequency is set to
+/// the frequency of the recording.
+///
+/// \param _strFile Journal file
+///
+/// \return Success
+///
+////////////////////////////////////////////////////////////////////////////////
+bool CInputManager::startReplay(const std::string& _strFile)
+{
+    METHOD_ENTRY("CInputManager::startReplay")
+    
+    m_unFrame = 0u;
+    if (!m_Journal.startReplay(_strFile)) return false;
+    
+    if (m_Journal.getFrequency() > 0.0) this->setFrequency(m_Journal.getFrequency());
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Stops recording or replay of input events
+///
+////////////////////////////////////////////////////////////////////////////////
+void CInputManager::stopJournal()
+{
+    METHOD_ENTRY("CInputManager::stopJournal")
+    m_Journal.stop();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Queues an input event, never blocks
+///
+/// If the queue is full, since the consumer does not dispatch, the event is
+/// dropped.
+///
+/// \param _Kind Kind of event
+/// \param _nA First value, depending on kind
+/// \param _nB Second value, depending on kind
+/// \param _nTime Time of capture
+///
+////////////////////////////////////////////////////////////////////////////////
+void CInputManager::pushEvent(const InputEventKindType _Kind, const std::int32_t _nA,
+                              const std::int32_t _nB, const std::uint64_t _nTime)
+{
+    METHOD_ENTRY("CInputManager::pushEvent")
+    
+    const InputEventType Event{_nTime, _nA, _nB, _Kind, m_nButtons};
+    
+    if (m_Journal.isRecording()) m_Journal.record(m_unFrame, m_nFrameTime, Event);
+    
+    if (!m_Events.push(Event))
+    {
+        if (m_nNrOfDropped++ == 0u)
+        {
+            WARNING_MSG("Input Manager", "Event queue is full, dropping input events.")
+        }
+    }
+}
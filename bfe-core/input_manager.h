@@ -32,10 +32,21 @@
 #define INPUT_MANAGER_H
 
 //--- Standard header --------------------------------------------------------//
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
 
 //--- Program header ---------------------------------------------------------//
 #include "com_console.h"
 #include "com_interface_provider.h"
+#include "frame_stats.h"
+#include "input_event.h"
+#include "input_journal.h"
+#include "key_bindings.h"
+#include "spinlock.h"
+#include "spsc_queue.h"
 #include "thread_module.h"
 
 //--- Misc header ------------------------------------------------------------//
@@ -46,18 +57,33 @@ namespace bfe
 {
 
 const double INPUT_DEFAULT_FREQUENCY = 120.0;   ///< Default frequency for input update
-
-/// Specifies current UI mode
-enum class MouseModeType
-{
-    ABSOLUTE,
-    RELATIVE
-};
+constexpr std::size_t INPUT_EVENT_QUEUE_SIZE = 1024u;   ///< Capacity of event queue, power of two
+constexpr std::size_t INPUT_EVENT_BATCH_SIZE = 64u;     ///< Number of events drained from queue at once
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Class for managing the input (mouse, keyboard)
 ///
+/// The input thread (\ref processFrame) only polls the window and pushes
+/// compact, timestamped event records into a lock free queue, it never
+/// waits for consumers. Events are handled, i.e. commands of the com
+/// interface are called, by \ref dispatchEvents in batches. By default,
+/// this is done at the end of \ref processFrame. With deferred dispatch
+/// (com function "input_set_deferred_dispatch"), a consumer calls
+/// "input_dispatch_events" at the start of its own frame instead, and
+/// callbacks run on the consumer's thread. The Lua manager does so for each
+/// of its frames. Only one thread dispatches at a time, hence, switching is
+/// safe while both threads are running. Latency from capture to dispatch is
+/// recorded per event.
+///
+/// Keys are dispatched by a binding table (\ref CKeyBindings), which can be
+/// changed by the com function "input_bind_key". Changes are applied by the
+/// dispatching thread before handling the next events.
+///
+/// Captured events can be recorded to a journal file. On replay, the
+/// journal's events are queued frame by frame instead of polling the window,
+/// hence, no window is needed and benchmark runs get identical input.
+///
 ////////////////////////////////////////////////////////////////////////////////
 class CInputManager : public IComInterfaceProvider,
                       public IThreadModule
@@ -69,24 +95,55 @@ class CInputManager : public IComInterfaceProvider,
         CInputManager();
         
         //--- Constant Methods -----------------------------------------------//
+        const CFrameStats& getLatencyStats() const {return m_LatencyStats;}
+        bool isReplaying() const {return m_Journal.isReplaying();}
                 
         //--- Methods --------------------------------------------------------//
+        std::size_t dispatchEvents();
         bool processFrame();
+        void setDeferredDispatch(const bool _bDeferred) {m_bDeferredDispatch = _bDeferred;}
         void setWindow(sf::Window* const _pWindow);
+        bool startRecording(const std::string&);
+        bool startReplay(const std::string&);
+        void stopJournal();
         
     private:
 
         //--- Constant methods [private] -------------------------------------//
         
         //--- Methods [private] ----------------------------------------------//
+        #ifdef BFE_MULTITHREADING
+          void frequencyChanged() override;
+          void shedLoad(const int) override;
+        #endif
+        void handleEvent(const InputEventType&, const int);
         void myInitComInterface();
+        void pollWindow(const std::uint64_t);
+        void pushEvent(const InputEventKindType, const std::int32_t, const std::int32_t, const std::uint64_t);
         
         //--- Variables [private] --------------------------------------------//
         sf::Window*     m_pWindow;              ///< Window with input focus
         
-        sf::Vector2i    m_vecMouse;             ///< Current mouse position
+        sf::Vector2i    m_vecMouse;             ///< Mouse movement of current frame
         sf::Vector2i    m_vecMouseCenter;       ///< Mouse position at window center
-        MouseModeType   m_MouseMode;            ///< Currently active mouse mode
+        sf::Vector2i    m_vecMouseCursor;       ///< Mouse position last queued
+        std::atomic<MouseModeType> m_MouseMode; ///< Currently active mouse mode
+        std::uint8_t    m_nButtons;             ///< Mouse buttons pressed in current frame
+        
+        CSpscQueue<InputEventType, INPUT_EVENT_QUEUE_SIZE> m_Events; ///< Events from input thread to consumer
+        CFrameStats         m_LatencyStats;         ///< Time from capture to dispatch of events
+        std::atomic<bool>   m_bDeferredDispatch;    ///< Events are dispatched by consumer?
+        std::atomic<bool>   m_bDispatching;         ///< Events are being dispatched, only one consumer at a time
+        std::size_t         m_nNrOfDropped;         ///< Number of events dropped, since queue was full
+        
+        CInputJournal       m_Journal;              ///< Journal for recording and replay of events
+        std::uint32_t       m_unFrame;              ///< Input frame since start of recording or replay
+        std::uint64_t       m_nFrameTime;           ///< Time of start of current input frame
+        
+        CKeyBindings        m_KeyBindings;          ///< Commands bound to keys, owned by dispatching thread
+        std::vector<std::array<std::string, 4>> m_PendingBindings; ///< Bindings to be applied on next dispatch
+        CSpinlock           m_PendingBindingsLock;  ///< Guards pending bindings
+        std::atomic<bool>   m_bBindingsChanged;     ///< Pending bindings available?
 };
 
 //--- Implementation is done here for inline optimisation --------------------//
@@ -102,6 +159,7 @@ inline void CInputManager::setWindow(sf::Window* const _pWindow)
 {
     METHOD_ENTRY("CInputManager::setWindow")
     m_pWindow = _pWindow;
+    if (m_pWindow == nullptr) return;
     m_vecMouseCenter = sf::Vector2i(m_pWindow->getSize().x >> 1, m_pWindow->getSize().y >> 1);
 }
 
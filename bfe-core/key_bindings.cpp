@@ -0,0 +1,306 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       key_bindings.cpp
+/// \brief      Implementation of class "CKeyBindings"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <sstream>
+
+#include <SFML/Window.hpp>
+
+#include "key_bindings.h"
+
+using namespace bfe;
+
+/// Names of keys, as used for bindings
+static const struct
+{
+    const char*         pcName;
+    sf::Keyboard::Key   Key;
+} s_KeyNames[] =
+{
+    {"A", sf::Keyboard::A}, {"B", sf::Keyboard::B}, {"C", sf::Keyboard::C}, {"D", sf::Keyboard::D},
+    {"E", sf::Keyboard::E}, {"F", sf::Keyboard::F}, {"G", sf::Keyboard::G}, {"H", sf::Keyboard::H},
+    {"I", sf::Keyboard::I}, {"J", sf::Keyboard::J}, {"K", sf::Keyboard::K}, {"L", sf::Keyboard::L},
+    {"M", sf::Keyboard::M}, {"N", sf::Keyboard::N}, {"O", sf::Keyboard::O}, {"P", sf::Keyboard::P},
+    {"Q", sf::Keyboard::Q}, {"R", sf::Keyboard::R}, {"S", sf::Keyboard::S}, {"T", sf::Keyboard::T},
+    {"U", sf::Keyboard::U}, {"V", sf::Keyboard::V}, {"W", sf::Keyboard::W}, {"X", sf::Keyboard::X},
+    {"Y", sf::Keyboard::Y}, {"Z", sf::Keyboard::Z},
+    {"0", sf::Keyboard::Num0}, {"1", sf::Keyboard::Num1}, {"2", sf::Keyboard::Num2}, {"3", sf::Keyboard::Num3},
+    {"4", sf::Keyboard::Num4}, {"5", sf::Keyboard::Num5}, {"6", sf::Keyboard::Num6}, {"7", sf::Keyboard::Num7},
+    {"8", sf::Keyboard::Num8}, {"9", sf::Keyboard::Num9},
+    {"Escape", sf::Keyboard::Escape}, {"Menu", sf::Keyboard::Menu},
+    {"LBracket", sf::Keyboard::LBracket}, {"RBracket", sf::Keyboard::RBracket},
+    {"SemiColon", sf::Keyboard::SemiColon}, {"Comma", sf::Keyboard::Comma}, {"Period", sf::Keyboard::Period},
+    {"Quote", sf::Keyboard::Quote}, {"Slash", sf::Keyboard::Slash}, {"BackSlash", sf::Keyboard::BackSlash},
+    {"Tilde", sf::Keyboard::Tilde}, {"Equal", sf::Keyboard::Equal}, {"Dash", sf::Keyboard::Dash},
+    {"Space", sf::Keyboard::Space}, {"Return", sf::Keyboard::Return}, {"BackSpace", sf::Keyboard::BackSpace},
+    {"Tab", sf::Keyboard::Tab}, {"PageUp", sf::Keyboard::PageUp}, {"PageDown", sf::Keyboard::PageDown},
+    {"End", sf::Keyboard::End}, {"Home", sf::Keyboard::Home}, {"Insert", sf::Keyboard::Insert},
+    {"Delete", sf::Keyboard::Delete}, {"Add", sf::Keyboard::Add}, {"Subtract", sf::Keyboard::Subtract},
+    {"Multiply", sf::Keyboard::Multiply}, {"Divide", sf::Keyboard::Divide},
+    {"Left", sf::Keyboard::Left}, {"Right", sf::Keyboard::Right}, {"Up", sf::Keyboard::Up}, {"Down", sf::Keyboard::Down},
+    {"Numpad0", sf::Keyboard::Numpad0}, {"Numpad1", sf::Keyboard::Numpad1}, {"Numpad2", sf::Keyboard::Numpad2},
+    {"Numpad3", sf::Keyboard::Numpad3}, {"Numpad4", sf::Keyboard::Numpad4}, {"Numpad5", sf::Keyboard::Numpad5},
+    {"Numpad6", sf::Keyboard::Numpad6}, {"Numpad7", sf::Keyboard::Numpad7}, {"Numpad8", sf::Keyboard::Numpad8},
+    {"Numpad9", sf::Keyboard::Numpad9},
+    {"F1", sf::Keyboard::F1}, {"F2", sf::Keyboard::F2}, {"F3", sf::Keyboard::F3}, {"F4", sf::Keyboard::F4},
+    {"F5", sf::Keyboard::F5}, {"F6", sf::Keyboard::F6}, {"F7", sf::Keyboard::F7}, {"F8", sf::Keyboard::F8},
+    {"F9", sf::Keyboard::F9}, {"F10", sf::Keyboard::F10}, {"F11", sf::Keyboard::F11}, {"F12", sf::Keyboard::F12},
+    {"F13", sf::Keyboard::F13}, {"F14", sf::Keyboard::F14}, {"F15", sf::Keyboard::F15},
+    {"Pause", sf::Keyboard::Pause}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+///////////////////////////////////////////////////////////////////////////////
+CKeyBindings::CKeyBindings() : m_Table(KEY_BINDINGS_NR_OF_MODES * sf::Keyboard::KeyCount * KEY_BINDINGS_NR_OF_MODIFIERS,
+                                       KEY_BINDINGS_UNBOUND)
+{
+    METHOD_ENTRY("CKeyBindings::CKeyBindings")
+    CTOR_CALL("CKeyBindings::CKeyBindings")
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Binds a command to a key, given by names
+///
+/// Modifiers are given as combination of "Alt", "Ctrl", "Shift", and
+/// "System", separated by '+', e.g. "Ctrl+Shift". An empty string means no
+/// modifiers, "*" means any combination of modifiers. An empty command
+/// removes the binding. Bindings of the home key have no effect, since it
+/// is reserved for switching mouse modes.
+///
+/// \param _strMode Mouse mode, "ui", "world", or "all"
+/// \param _strKey Name of key, e.g. "F2", "Return", "U"
+/// \param _strModifiers Modifiers to be pressed
+/// \param _strCommand Name of command, e.g. "toggle_debug_info"
+///
+/// \return Success
+///
+///////////////////////////////////////////////////////////////////////////////
+bool CKeyBindings::bind(const std::string& _strMode, const std::string& _strKey,
+                        const std::string& _strModifiers, const std::string& _strCommand)
+{
+    METHOD_ENTRY("CKeyBindings::bind")
+
+    //--- Key ---//
+    std::int32_t nKey = sf::Keyboard::Unknown;
+    for (const auto& KeyName : s_KeyNames)
+    {
+        if (_strKey == KeyName.pcName)
+        {
+            nKey = KeyName.Key;
+            break;
+        }
+    }
+    if (nKey == sf::Keyboard::Unknown)
+    {
+        WARNING_MSG("Key Bindings", "Unknown key <" << _strKey << ">.")
+        return false;
+    }
+
+    //--- Modifiers ---//
+    std::int32_t nModifiers = 0;
+    if (_strModifiers == "*")
+    {
+        nModifiers = KEY_BINDINGS_MODIFIERS_ANY;
+    }
+    else
+    {
+        std::istringstream iss(_strModifiers);
+        std::string strModifier;
+        while (std::getline(iss, strModifier, '+'))
+        {
+            if      (strModifier == "Alt")    nModifiers |= INPUT_MODIFIER_ALT;
+            else if (strModifier == "Ctrl")   nModifiers |= INPUT_MODIFIER_CONTROL;
+            else if (strModifier == "Shift")  nModifiers |= INPUT_MODIFIER_SHIFT;
+            else if (strModifier == "System") nModifiers |= INPUT_MODIFIER_SYSTEM;
+            else
+            {
+                WARNING_MSG("Key Bindings", "Unknown modifier <" << strModifier << ">.")
+                return false;
+            }
+        }
+    }
+
+    //--- Mode ---//
+    if (_strMode == "ui" || _strMode == "all")
+        this->bind(MouseModeType::ABSOLUTE, nKey, nModifiers, _strCommand);
+    if (_strMode == "world" || _strMode == "all")
+        this->bind(MouseModeType::RELATIVE, nKey, nModifiers, _strCommand);
+    if (_strMode != "ui" && _strMode != "world" && _strMode != "all")
+    {
+        WARNING_MSG("Key Bindings", "Unknown mode <" << _strMode << ">, use ui, world, or all.")
+        return false;
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Binds a command to a key
+///
+/// \param _Mode Mouse mode
+/// \param _nKey Key code
+/// \param _nModifiers Modifier mask, or \ref KEY_BINDINGS_MODIFIERS_ANY
+/// \param _strCommand Name of command, empty to remove binding
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKeyBindings::bind(const MouseModeType _Mode, const std::int32_t _nKey,
+                        const std::int32_t _nModifiers, const std::string& _strCommand)
+{
+    METHOD_ENTRY("CKeyBindings::bind")
+
+    std::uint16_t unCommand = KEY_BINDINGS_UNBOUND;
+    if (!_strCommand.empty())
+    {
+        // Commands are shared by all keys they are bound to
+        std::size_t i = 0u;
+        while (i < m_Commands.size() && m_Commands[i].strName != _strCommand) ++i;
+        if (i == m_Commands.size())
+        {
+            m_Commands.emplace_back();
+            m_Commands.back().strName = _strCommand;
+        }
+        unCommand = std::uint16_t(i + 1u);
+    }
+
+    if (_nModifiers == KEY_BINDINGS_MODIFIERS_ANY)
+    {
+        for (auto i=0; i<KEY_BINDINGS_NR_OF_MODIFIERS; ++i)
+            m_Table[this->getEntry(_Mode, _nKey, i)] = unCommand;
+    }
+    else
+    {
+        m_Table[this->getEntry(_Mode, _nKey, _nModifiers)] = unCommand;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Binds default commands
+///
+/// The home key is not part of the table, it switches mouse modes and is
+/// handled by the input manager.
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKeyBindings::bindDefaults()
+{
+    METHOD_ENTRY("CKeyBindings::bindDefaults")
+
+    this->bind("all", "Escape", "*", "exit");
+    this->bind("all", "F2", "*", "toggle_debug_info");
+    this->bind("all", "F3", "*", "toggle_debug_render");
+    this->bind("all", "U", "Ctrl", "uid_vis_toggle");
+    this->bind("all", "W", "Ctrl", "win_show_all");
+    this->bind("all", "W", "Alt", "win_hide_all");
+
+    this->bind("ui", "BackSpace", "*", "com_console_backspace");
+    this->bind("ui", "Up", "*", "com_console_prev");
+    this->bind("ui", "Down", "*", "com_console_next");
+    this->bind("ui", "Return", "*", "com_console_execute");
+    this->bind("ui", "Tab", "*", "com_console_complement");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Removes all bindings
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKeyBindings::clear()
+{
+    METHOD_ENTRY("CKeyBindings::clear")
+
+    std::fill(m_Table.begin(), m_Table.end(), KEY_BINDINGS_UNBOUND);
+    m_Commands.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Calls command bound to given key
+///
+/// Commands are resolved on first call. Unknown commands are reported and
+/// resolved again on the next call, since they might be registered later.
+/// Commands are called through the com interface to run their callbacks.
+///
+/// \param _pComInterface Com interface providing the commands
+/// \param _Mode Current mouse mode
+/// \param _nKey Key code
+/// \param _nModifiers Modifier mask
+///
+/// \return A command was called?
+///
+///////////////////////////////////////////////////////////////////////////////
+bool CKeyBindings::dispatch(CComInterface* const _pComInterface, const MouseModeType _Mode,
+                            const std::int32_t _nKey, const std::int32_t _nModifiers)
+{
+    METHOD_ENTRY("CKeyBindings::dispatch")
+
+    if (_nKey < 0 || _nKey >= sf::Keyboard::KeyCount) return false;
+
+    const std::uint16_t unCommand = m_Table[this->getEntry(_Mode, _nKey, _nModifiers)];
+    if (unCommand == KEY_BINDINGS_UNBOUND) return false;
+
+    KeyBindingCommandType& Command = m_Commands[unCommand - 1u];
+    if (Command.pCommand == nullptr)
+    {
+        Command.pCommand = _pComInterface->getCommand<void>(Command.strName);
+        if (Command.pCommand == nullptr)
+        {
+            WARNING_MSG("Key Bindings", "Unknown command <" << Command.strName << "> or command has parameters.")
+            return false;
+        }
+    }
+
+    _pComInterface->call<void>(Command.strName);
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns table entry of given mode, key, and modifiers
+///
+/// \param _Mode Mouse mode
+/// \param _nKey Key code
+/// \param _nModifiers Modifier mask
+///
+/// \return Index of table entry
+///
+///////////////////////////////////////////////////////////////////////////////
+std::size_t CKeyBindings::getEntry(const MouseModeType _Mode, const std::int32_t _nKey,
+                                   const std::int32_t _nModifiers) const
+{
+    METHOD_ENTRY("CKeyBindings::getEntry")
+
+    const std::size_t nMode = (_Mode == MouseModeType::ABSOLUTE) ? 0u : 1u;
+    return (nMode * sf::Keyboard::KeyCount + std::size_t(_nKey)) * KEY_BINDINGS_NR_OF_MODIFIERS +
+           std::size_t(_nModifiers & (KEY_BINDINGS_NR_OF_MODIFIERS-1));
+}
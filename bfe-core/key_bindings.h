@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       key_bindings.h
+/// \brief      Prototype of class "CKeyBindings"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef KEY_BINDINGS_H
+#define KEY_BINDINGS_H
+
+//--- Standard header --------------------------------------------------------//
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "com_interface.h"
+#include "input_event.h"
+
+/// BFEngine namespace
+namespace bfe
+{
+
+//--- Constants --------------------------------------------------------------//
+constexpr int           KEY_BINDINGS_NR_OF_MODES = 2;           ///< Number of mouse modes with separate bindings
+constexpr int           KEY_BINDINGS_NR_OF_MODIFIERS = 16;      ///< Number of modifier combinations
+constexpr std::int32_t  KEY_BINDINGS_MODIFIERS_ANY = -1;        ///< Binding applies to all modifier combinations
+constexpr std::uint16_t KEY_BINDINGS_UNBOUND = 0u;              ///< Table entry of unbound keys
+
+/// Command bound to one or more keys
+struct KeyBindingCommandType
+{
+    std::string     strName;            ///< Name of command at com interface
+    CCommand<void>* pCommand = nullptr; ///< Resolved command, nullptr if not resolved (yet)
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Table of key bindings, mapping keys to commands of the com interface
+///
+/// Each combination of mouse mode, key, and modifier mask has one entry,
+/// which holds the index of the bound command. Hence, dispatching a key is a
+/// flat array lookup. Commands are resolved on first use, so unknown
+/// commands are skipped without calling the com interface. Known commands
+/// are called through the com interface, running callbacks registered to
+/// them. Bindings are given by names (see \ref bind), thus, they can be
+/// changed by configuration scripts.
+///
+/// Not thread safe, changing and dispatching must be done by the same
+/// thread.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CKeyBindings
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CKeyBindings();
+
+        //--- Methods --------------------------------------------------------//
+        bool bind(const std::string&, const std::string&, const std::string&, const std::string&);
+        void bind(const MouseModeType, const std::int32_t, const std::int32_t, const std::string&);
+        void bindDefaults();
+        void clear();
+        bool dispatch(CComInterface* const, const MouseModeType, const std::int32_t, const std::int32_t);
+
+    private:
+
+        //--- Methods [private] ----------------------------------------------//
+        std::size_t getEntry(const MouseModeType, const std::int32_t, const std::int32_t) const;
+
+        //--- Variables [private] --------------------------------------------//
+        std::vector<std::uint16_t>          m_Table;    ///< Command index + 1 for each mode, key, and modifiers
+        std::vector<KeyBindingCommandType>  m_Commands; ///< All commands bound so far
+};
+
+} // namespace bfe
+
+#endif // KEY_BINDINGS_H
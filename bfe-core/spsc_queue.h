@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       spsc_queue.h
+/// \brief      Prototype of class "CSpscQueue"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+//--- Standard header --------------------------------------------------------//
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+//--- Program header ---------------------------------------------------------//
+#include "log.h"
+
+/// BFEngine namespace
+namespace bfe
+{
+
+//--- Constants --------------------------------------------------------------//
+constexpr std::size_t SPSC_QUEUE_CACHE_LINE_SIZE = 64u; ///< Size of cache line, separating producer and consumer data
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Lock free ring buffer, passing elements from one producer to one
+///        consumer
+///
+/// The capacity N must be a power of two. Producer and consumer each own an
+/// index, which is only read by the other side. Both keep a cached copy of
+/// the other side's index, so the shared cache line is only touched if the
+/// queue seems to be full or empty. Indices are padded to separate cache
+/// lines to avoid false sharing. If the queue is full, \ref push fails
+/// instead of blocking the producer.
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, std::size_t N>
+class CSpscQueue
+{
+
+    static_assert(N > 1u && (N & (N-1u)) == 0u, "Capacity of CSpscQueue must be a power of two.");
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CSpscQueue() = default;
+        CSpscQueue(const CSpscQueue<T, N>&) = delete;
+        CSpscQueue<T, N>& operator=(const CSpscQueue<T, N>&) = delete;
+
+        //--- Constant Methods -----------------------------------------------//
+        std::size_t size() const;
+
+        //--- Methods --------------------------------------------------------//
+        bool        pop(T&);
+        std::size_t pop(T* const, const std::size_t);
+        bool        push(const T&);
+
+    private:
+
+        //--- Variables [private] --------------------------------------------//
+        std::array<T, N>            m_Elements;                 ///< Ring of elements
+
+        std::atomic<std::size_t>    m_nTail{0u};                ///< Next element to be written, owned by producer
+        std::size_t                 m_nHeadCached = 0u;         ///< Producers copy of consumer index
+        char m_acPadTail[SPSC_QUEUE_CACHE_LINE_SIZE - sizeof(std::atomic<std::size_t>) - sizeof(std::size_t)]; ///< Padding
+
+        std::atomic<std::size_t>    m_nHead{0u};                ///< Next element to be read, owned by consumer
+        std::size_t                 m_nTailCached = 0u;         ///< Consumers copy of producer index
+        char m_acPadHead[SPSC_QUEUE_CACHE_LINE_SIZE - sizeof(std::atomic<std::size_t>) - sizeof(std::size_t)]; ///< Padding
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of queued elements
+///
+/// The number is a snapshot and might be outdated when used by a thread
+/// other than producer or consumer.
+///
+/// \return Number of elements
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, std::size_t N>
+inline std::size_t CSpscQueue<T, N>::size() const
+{
+    METHOD_ENTRY("CSpscQueue::size")
+    return m_nTail.load(std::memory_order_acquire) - m_nHead.load(std::memory_order_acquire);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Removes oldest element, called by consumer only
+///
+/// \param _Element Element that was removed
+///
+/// \return Element available?
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, std::size_t N>
+inline bool CSpscQueue<T, N>::pop(T& _Element)
+{
+    METHOD_ENTRY("CSpscQueue::pop")
+    return this->pop(&_Element, 1u) == 1u;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Removes a batch of oldest elements, called by consumer only
+///
+/// \param _pElements Array to copy removed elements to
+/// \param _nMax Maximum number of elements to be removed
+///
+/// \return Number of elements removed
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, std::size_t N>
+inline std::size_t CSpscQueue<T, N>::pop(T* const _pElements, const std::size_t _nMax)
+{
+    METHOD_ENTRY("CSpscQueue::pop")
+
+    const std::size_t nHead = m_nHead.load(std::memory_order_relaxed);
+    if (m_nTailCached - nHead < _nMax)
+        m_nTailCached = m_nTail.load(std::memory_order_acquire);
+
+    std::size_t nNr = m_nTailCached - nHead;
+    if (nNr > _nMax) nNr = _nMax;
+
+    for (auto i=0u; i<nNr; ++i)
+        _pElements[i] = m_Elements[(nHead + i) & (N-1u)];
+
+    m_nHead.store(nHead + nNr, std::memory_order_release);
+    return nNr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds an element, called by producer only
+///
+/// \param _Element Element to be added
+///
+/// \return Element was added, i.e. queue was not full?
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, std::size_t N>
+inline bool CSpscQueue<T, N>::push(const T& _Element)
+{
+    METHOD_ENTRY("CSpscQueue::push")
+
+    const std::size_t nTail = m_nTail.load(std::memory_order_relaxed);
+    if (nTail - m_nHeadCached == N)
+    {
+        m_nHeadCached = m_nHead.load(std::memory_order_acquire);
+        if (nTail - m_nHeadCached == N) return false;
+    }
+
+    m_Elements[nTail & (N-1u)] = _Element;
+    m_nTail.store(nTail + 1u, std::memory_order_release);
+    return true;
+}
+
+} // namespace bfe
+
+#endif // SPSC_QUEUE_H
@@ -28,10 +28,23 @@
 ///
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+#ifdef __linux__
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
 #include "thread_module.h"
 
 using namespace bfe;
 
+#ifdef __linux__
+    static_assert(THREAD_MODULE_CPUS_MAX <= CPU_SETSIZE, "CPUs for affinity exceed cpu_set_t.");
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Constructor
@@ -50,6 +63,23 @@ IThreadModule::IThreadModule() : m_fFrequency(THREAD_MODULE_DEFAULT_FREQUENCY),
 }
 
 #ifdef BFE_MULTITHREADING
+  ////////////////////////////////////////////////////////////////////////////////
+  ///
+  /// \brief Returns placement of module thread, granted by the OS
+  ///
+  /// \return Description of CPU affinity, scheduling, and current CPU
+  ///
+  ////////////////////////////////////////////////////////////////////////////////
+  std::string IThreadModule::getPlacement() const
+  {
+      METHOD_ENTRY("IThreadModule::getPlacement")
+      
+      m_PlacementLock.acquireLock();
+      const std::string strPlacement = m_strPlacement;
+      m_PlacementLock.releaseLock();
+      return strPlacement;
+  }
+  
   ////////////////////////////////////////////////////////////////////////////////
   ///
   /// \brief Runs the visuals engine, called as a thread.
@@ -62,23 +92,380 @@ IThreadModule::IThreadModule() : m_fFrequency(THREAD_MODULE_DEFAULT_FREQUENCY),
       INFO_MSG("Thread Module", m_strModuleName << " started.")
       
       this->preRun();
+      m_FrameStats.setName(m_strModuleName);
       m_bRunning = true;
       
+      #ifdef __linux__
+          pthread_setname_np(pthread_self(), m_strModuleName.substr(0u, THREAD_MODULE_NAME_LENGTH_MAX).c_str());
+      #endif
+      
       CTimer ThreadModuleTimer;
+      auto TimeLast = std::chrono::steady_clock::now();
       
       ThreadModuleTimer.start();
       while (m_bRunning)
       {
-          if (!this->processFrame()) m_bRunning = false;
-          m_fTimeSlept = ThreadModuleTimer.sleepRemaining(m_fFrequency*m_fTimeAccel);
+          if (m_bPlacementChanged.load(std::memory_order_acquire)) this->applyPlacement();
+          
+          const auto Time = std::chrono::steady_clock::now();
+          const double fTime = std::chrono::duration<double>(Time - TimeLast).count();
+          TimeLast = Time;
+          
+          if (m_FixedTimestep.getTimestep() > 0.0)
+          {
+              // Fixed steps: time acceleration changes the number of steps,
+              // not the frequency of the loop
+              const int nNrOfSteps = m_FixedTimestep.advance(fTime*m_fTimeAccel);
+              for (auto i=0; i<nNrOfSteps && m_bRunning; ++i)
+              {
+                  if (!this->processFrame()) m_bRunning = false;
+              }
+              m_fInterpolationAlpha.store(m_FixedTimestep.getAlpha(), std::memory_order_release);
+              
+              m_fTimeSlept = ThreadModuleTimer.sleepRemaining(m_fFrequency);
+              m_FrameStats.addSample(1.0/m_fFrequency - m_fTimeSlept);
+          }
+          else
+          {
+              if (!this->processFrame()) m_bRunning = false;
+              m_fTimeSlept = ThreadModuleTimer.sleepRemaining(m_fFrequency*m_fTimeAccel);
+              m_FrameStats.addSample(1.0/(m_fFrequency*m_fTimeAccel) - m_fTimeSlept);
+          }
           
           if (m_fTimeSlept < 0.0)
           {
               DEBUG_MSG("Thread Module", "Execution time of thread " << m_strModuleName << " is too large: " << 1.0/m_fFrequency - m_fTimeSlept << 
                                           "s of " << 1.0/m_fFrequency << "s max.")
           }
+          if (m_fFrequencyMax > 0.0) this->adaptFrequency();
       }
       INFO_MSG("Thread Module", m_strModuleName << " stopped.")
   }
-#endif
 
+  ////////////////////////////////////////////////////////////////////////////////
+  ///
+  /// \brief Sets fixed timestep, simulated by each call of \ref processFrame
+  ///
+  /// Must be called by the module thread, e.g. as queued writer, or before
+  /// \ref run.
+  ///
+  /// \param _fTimestep Size of step, 0 switches fixed steps off
+  /// \param _nSubstepsMax Maximum number of steps per loop, at least 1
+  ///
+  ////////////////////////////////////////////////////////////////////////////////
+  void IThreadModule::setFixedTimestep(const double& _fTimestep, const int _nSubstepsMax)
+  {
+      METHOD_ENTRY("IThreadModule::setFixedTimestep")
+      
+      if (_nSubstepsMax < 1)
+      {
+          WARNING_MSG("Thread Module", "Invalid maximum number of steps per loop " << _nSubstepsMax <<
+                                       " for " << m_strModuleName << ", must be at least 1.")
+          return;
+      }
+      
+      m_FixedTimestep.setTimestep(_fTimestep);
+      m_FixedTimestep.setSubstepsMax(_nSubstepsMax);
+      if (_fTimestep <= 0.0) m_fInterpolationAlpha.store(0.0, std::memory_order_release);
+  }
+  
+  ////////////////////////////////////////////////////////////////////////////////
+  ///
+  /// \brief Sets range of frequency adapting to load
+  ///
+  /// Must be called by the module thread, e.g. as queued writer. If maximum
+  /// frequency is 0, adaption is switched off and shed work is restored.
+  ///
+  /// \param _fFrequencyMin Minimum frequency
+  /// \param _fFrequencyMax Maximum frequency
+  ///
+  ////////////////////////////////////////////////////////////////////////////////
+  void IThreadModule::setFrequencyRange(const double& _fFrequencyMin, const double& _fFrequencyMax)
+  {
+      METHOD_ENTRY("IThreadModule::setFrequencyRange")
+      
+      if (_fFrequencyMax > 0.0 && (_fFrequencyMin <= 0.0 || _fFrequencyMin > _fFrequencyMax))
+      {
+          WARNING_MSG("Thread Module", "Invalid frequency range " << _fFrequencyMin << "Hz - " <<
+                                       _fFrequencyMax << "Hz for " << m_strModuleName << ".")
+          return;
+      }
+      
+      m_fFrequencyMin = _fFrequencyMin;
+      m_fFrequencyMax = _fFrequencyMax;
+      m_nNrOfOverruns = 0;
+      m_nNrOfSlack = 0;
+      m_nNrOfRestoreSlack = 0;
+      
+      if (m_fFrequencyMax <= 0.0)
+      {
+          if (m_nLoadLevel.exchange(0, std::memory_order_relaxed) != 0) this->shedLoad(0);
+          return;
+      }
+      
+      const double fFrequency = std::min(std::max(m_fFrequency, m_fFrequencyMin), m_fFrequencyMax);
+      if (fFrequency != m_fFrequency)
+      {
+          m_fFrequency = fFrequency;
+          this->frequencyChanged();
+      }
+  }
+  
+  ////////////////////////////////////////////////////////////////////////////////
+  ///
+  /// \brief Sets CPUs the module thread may run on
+  ///
+  /// CPUs are given as list of numbers and ranges, e.g. "0,2-3", below
+  /// THREAD_MODULE_CPUS_MAX. An empty list removes the restriction. Applied by the module thread before its
+  /// next frame.
+  ///
+  /// \param _strCPUs List of CPUs
+  ///
+  /// \return List was valid?
+  ///
+  ////////////////////////////////////////////////////////////////////////////////
+  bool IThreadModule::setAffinity(const std::string& _strCPUs)
+  {
+      METHOD_ENTRY("IThreadModule::setAffinity")
+      
+      std::vector<int> CPUs;
+      std::istringstream iss(_strCPUs);
+      std::string strRange;
+      while (std::getline(iss, strRange, ','))
+      {
+          int nFirst = -1;
+          int nLast = -1;
+          char cDash = '-';
+          std::istringstream issRange(strRange);
+          bool bValid = static_cast<bool>(issRange >> nFirst);
+          if (bValid && issRange >> cDash) bValid = static_cast<bool>(issRange >> nLast);
+          else nLast = nFirst;
+          char cTrailing = ' ';
+          if (bValid && issRange >> cTrailing) bValid = false;
+          
+          if (!bValid || cDash != '-' || nFirst < 0 || nLast < nFirst || nLast >= THREAD_MODULE_CPUS_MAX)
+          {
+              WARNING_MSG("Thread Module", "Invalid CPU list <" << _strCPUs << "> for " << m_strModuleName << ".")
+              return false;
+          }
+          for (auto i=nFirst; i<=nLast; ++i) CPUs.push_back(i);
+      }
+      
+      m_PlacementLock.acquireLock();
+      m_AffinityCPUs = CPUs;
+      m_bAffinityRequested = true;
+      m_bPlacementChanged.store(true, std::memory_order_release);
+      m_PlacementLock.releaseLock();
+      return true;
+  }
+  
+  ////////////////////////////////////////////////////////////////////////////////
+  ///
+  /// \brief Sets scheduling policy and priority of the module thread
+  ///
+  /// Real time policies usually need according privileges, if not granted
+  /// a warning is given and the thread keeps its scheduling. Applied by the
+  /// module thread before its next frame.
+  ///
+  /// \param _strPolicy Policy, "default", "fifo", or "rr"
+  /// \param _nPriority Priority for real time policies
+  ///
+  /// \return Policy was valid?
+  ///
+  ////////////////////////////////////////////////////////////////////////////////
+  bool IThreadModule::setScheduling(const std::string& _strPolicy, const int _nPriority)
+  {
+      METHOD_ENTRY("IThreadModule::setScheduling")
+      
+      ThreadPolicyType Policy = ThreadPolicyType::DEFAULT;
+      if (_strPolicy == "fifo") Policy = ThreadPolicyType::FIFO;
+      else if (_strPolicy == "rr") Policy = ThreadPolicyType::ROUND_ROBIN;
+      else if (_strPolicy != "default")
+      {
+          WARNING_MSG("Thread Module", "Unknown scheduling policy <" << _strPolicy << ">, use default, fifo, or rr.")
+          return false;
+      }
+      
+      m_PlacementLock.acquireLock();
+      m_Policy = Policy;
+      m_nPriority = _nPriority;
+      m_bSchedulingRequested = true;
+      m_bPlacementChanged.store(true, std::memory_order_release);
+      m_PlacementLock.releaseLock();
+      return true;
+  }
+  
+  ////////////////////////////////////////////////////////////////////////////////
+  ///
+  /// \brief Adapts frequency or shed work to load of last frames
+  ///
+  ////////////////////////////////////////////////////////////////////////////////
+  void IThreadModule::adaptFrequency()
+  {
+      METHOD_ENTRY("IThreadModule::adaptFrequency")
+      
+      // With fixed timestep, the loop is paced by the frequency alone and
+      // the frequency is kept, since lowering it doesn't reduce the work
+      const bool bFixedTimestep = m_FixedTimestep.getTimestep() > 0.0;
+      const double fFrequencyPaced = bFixedTimestep ? m_fFrequency : m_fFrequency*m_fTimeAccel;
+      
+      if (m_fTimeSlept < 0.0)
+      {
+          ++m_nNrOfOverruns;
+          m_nNrOfSlack = 0;
+          m_nNrOfRestoreSlack = 0;
+      }
+      else
+      {
+          m_nNrOfOverruns = 0;
+          if (m_fTimeSlept > THREAD_MODULE_ADAPT_SLACK / fFrequencyPaced) ++m_nNrOfSlack;
+          else m_nNrOfSlack = 0;
+          if (m_fTimeSlept > THREAD_MODULE_RESTORE_SLACK / fFrequencyPaced) ++m_nNrOfRestoreSlack;
+          else m_nNrOfRestoreSlack = 0;
+      }
+      
+      const double fFrequency = m_fFrequency;
+      const int nLoadLevel = m_nLoadLevel.load(std::memory_order_relaxed);
+      if (m_nNrOfOverruns >= THREAD_MODULE_ADAPT_FRAMES)
+      {
+          m_nNrOfOverruns = 0;
+          if (m_fFrequency > m_fFrequencyMin && !bFixedTimestep)
+          {
+              m_fFrequency = std::max(m_fFrequencyMin, m_fFrequency * THREAD_MODULE_ADAPT_DECREASE);
+          }
+          else if (nLoadLevel < THREAD_MODULE_LOAD_LEVEL_MAX)
+          {
+              m_nLoadLevel.store(nLoadLevel+1, std::memory_order_relaxed);
+              this->shedLoad(nLoadLevel+1);
+              INFO_MSG("Thread Module", m_strModuleName << " overrunning, load level " << nLoadLevel+1 << ".")
+          }
+      }
+      else if (nLoadLevel > 0)
+      {
+          // Shed work is restored with hysteresis, otherwise, restored
+          // work would overrun again right away
+          if (m_nNrOfRestoreSlack >= THREAD_MODULE_RESTORE_FRAMES)
+          {
+              m_nNrOfRestoreSlack = 0;
+              m_nNrOfSlack = 0;
+              m_nLoadLevel.store(nLoadLevel-1, std::memory_order_relaxed);
+              this->shedLoad(nLoadLevel-1);
+              INFO_MSG("Thread Module", m_strModuleName << " has slack, load level " << nLoadLevel-1 << ".")
+          }
+      }
+      else if (m_nNrOfSlack >= THREAD_MODULE_ADAPT_FRAMES)
+      {
+          m_nNrOfSlack = 0;
+          if (m_fFrequency < m_fFrequencyMax && !bFixedTimestep)
+          {
+              m_fFrequency = std::min(m_fFrequencyMax, m_fFrequency * THREAD_MODULE_ADAPT_INCREASE);
+          }
+      }
+      
+      if (m_fFrequency != fFrequency)
+      {
+          INFO_MSG("Thread Module", m_strModuleName << " frequency adapted to load: " << fFrequency << "Hz -> " << m_fFrequency << "Hz")
+          this->frequencyChanged();
+      }
+  }
+  
+  ////////////////////////////////////////////////////////////////////////////////
+  ///
+  /// \brief Applies affinity and scheduling to calling thread, reports result
+  ///
+  /// Only requested settings are applied, otherwise the thread keeps the
+  /// placement it inherited, e.g. from the process' affinity mask.
+  ///
+  ////////////////////////////////////////////////////////////////////////////////
+  void IThreadModule::applyPlacement()
+  {
+      METHOD_ENTRY("IThreadModule::applyPlacement")
+      
+      m_PlacementLock.acquireLock();
+      m_bPlacementChanged.store(false, std::memory_order_relaxed);
+      const std::vector<int> AffinityCPUs = m_AffinityCPUs;
+      const ThreadPolicyType Policy = m_Policy;
+      const int nPriority = m_nPriority;
+      const bool bAffinityRequested = m_bAffinityRequested;
+      const bool bSchedulingRequested = m_bSchedulingRequested;
+      m_bAffinityRequested = false;
+      m_bSchedulingRequested = false;
+      m_PlacementLock.releaseLock();
+      
+      std::ostringstream ossPlacement;
+      
+      #ifdef __linux__
+          const pthread_t Thread = pthread_self();
+          
+          //--- Affinity ---//
+          cpu_set_t CPUSet;
+          if (bAffinityRequested)
+          {
+              CPU_ZERO(&CPUSet);
+              if (AffinityCPUs.empty())
+              {
+                  for (auto i=0; i<CPU_SETSIZE; ++i) CPU_SET(i, &CPUSet);
+              }
+              else
+              {
+                  for (const auto nCPU : AffinityCPUs)
+                      if (nCPU < CPU_SETSIZE) CPU_SET(nCPU, &CPUSet);
+              }
+              if (pthread_setaffinity_np(Thread, sizeof(cpu_set_t), &CPUSet) != 0)
+              {
+                  WARNING_MSG("Thread Module", "Could not set CPU affinity of " << m_strModuleName << ".")
+              }
+          }
+          
+          //--- Scheduling ---//
+          int nPolicy = SCHED_OTHER;
+          sched_param Param;
+          if (bSchedulingRequested)
+          {
+              if (Policy == ThreadPolicyType::FIFO) nPolicy = SCHED_FIFO;
+              else if (Policy == ThreadPolicyType::ROUND_ROBIN) nPolicy = SCHED_RR;
+              Param.sched_priority = (nPolicy == SCHED_OTHER) ? 0 : nPriority;
+              if (pthread_setschedparam(Thread, nPolicy, &Param) != 0)
+              {
+                  WARNING_MSG("Thread Module", "Could not set scheduling of " << m_strModuleName <<
+                                               ", missing privileges?")
+              }
+          }
+          
+          //--- Report placement actually granted ---//
+          ossPlacement << "CPUs";
+          if (pthread_getaffinity_np(Thread, sizeof(cpu_set_t), &CPUSet) == 0)
+          {
+              int nNrOfCPUs = 0;
+              for (auto i=0; i<CPU_SETSIZE; ++i)
+              {
+                  if (CPU_ISSET(i, &CPUSet))
+                  {
+                      ossPlacement << (nNrOfCPUs++ == 0 ? " " : ",") << i;
+                  }
+              }
+          }
+          if (pthread_getschedparam(Thread, &nPolicy, &Param) == 0)
+          {
+              ossPlacement << ", policy " << (nPolicy == SCHED_FIFO ? "fifo" : nPolicy == SCHED_RR ? "rr" : "default")
+                  << ", priority " << Param.sched_priority;
+          }
+          ossPlacement << ", running on CPU " << sched_getcpu();
+      #else
+          if (bAffinityRequested || bSchedulingRequested)
+          {
+              WARNING_MSG("Thread Module", "CPU affinity and scheduling are not supported on this platform.")
+          }
+          static_cast<void>(AffinityCPUs);
+          static_cast<void>(Policy);
+          static_cast<void>(nPriority);
+          ossPlacement << "default";
+      #endif
+      
+      m_PlacementLock.acquireLock();
+      m_strPlacement = ossPlacement.str();
+      m_PlacementLock.releaseLock();
+      
+      INFO_MSG("Thread Module", m_strModuleName << " placement: " << ossPlacement.str())
+  }
+#endif
@@ -32,21 +32,70 @@
 #define THREAD_MODULE_H
 
 //--- Standard header --------------------------------------------------------//
+#include <atomic>
+#include <string>
+#include <vector>
 
 //--- Program header ---------------------------------------------------------//
 #include "conf_bfengine.h"
+#include "fixed_timestep.h"
+#include "frame_stats.h"
 #include "log.h"
+#include "spinlock.h"
 
 /// BFEngine namespace
 namespace bfe
 {
 
 const double THREAD_MODULE_DEFAULT_FREQUENCY = 60.0;   ///< Default frequency for module
+constexpr std::size_t THREAD_MODULE_NAME_LENGTH_MAX = 15u; ///< Maximum length of thread names given to the OS
+constexpr int    THREAD_MODULE_CPUS_MAX = 1024;         ///< Maximum number of CPUs for affinity (size of Linux' cpu_set_t)
+constexpr int    THREAD_MODULE_ADAPT_FRAMES = 10;       ///< Consecutive frames of overrun or slack before adapting
+constexpr double THREAD_MODULE_ADAPT_DECREASE = 0.8;    ///< Factor for frequency under sustained overrun
+constexpr double THREAD_MODULE_ADAPT_INCREASE = 1.1;    ///< Factor for frequency with sustained slack
+constexpr double THREAD_MODULE_ADAPT_SLACK = 0.5;       ///< Minimum fraction of frame slept to count as slack
+constexpr int    THREAD_MODULE_LOAD_LEVEL_MAX = 4;      ///< Maximum level of work to shed
+constexpr int    THREAD_MODULE_RESTORE_FRAMES = 50;     ///< Consecutive frames of restore slack before restoring shed work
+constexpr double THREAD_MODULE_RESTORE_SLACK = 0.75;    ///< Minimum fraction of frame slept to restore shed work
+
+/// Scheduling policy of module thread
+enum class ThreadPolicyType
+{
+    DEFAULT,        ///< Default time sharing scheduling
+    FIFO,           ///< Real time, first in first out
+    ROUND_ROBIN     ///< Real time, round robin
+};
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Interface defining a general thread module
 ///
+/// With multithreading, the module's thread can be given a CPU affinity and a
+/// scheduling policy. Both may be requested from any thread, they are
+/// applied by the module thread itself at the start of \ref run and before
+/// the next frame. The thread is named after the module. The placement
+/// actually granted by the OS is reported by \ref getPlacement.
+///
+/// If a frequency range is given (\ref setFrequencyRange), the frequency
+/// adapts to the load: It is lowered after sustained overrun of the frame
+/// time and raised again after sustained slack. At minimum frequency,
+/// modules are asked to shed optional work (\ref shedLoad) with increasing
+/// level instead, up to THREAD_MODULE_LOAD_LEVEL_MAX, which is reverted
+/// first once there is slack. To avoid oscillation, restoring shed work
+/// requires more slack over a longer time (THREAD_MODULE_RESTORE_SLACK,
+/// THREAD_MODULE_RESTORE_FRAMES) than adapting the frequency. Derived
+/// modules are notified of each change by \ref frequencyChanged and
+/// \ref shedLoad.
+///
+/// With a fixed timestep (\ref setFixedTimestep), the frequency only paces
+/// the loop. Elapsed time, scaled by time acceleration, is accumulated and
+/// \ref processFrame is called once per step, at most a given number of
+/// times per loop. The interpolation value between previous and current
+/// state is provided for rendering by \ref getInterpolationAlpha. Since a
+/// lower frequency does not reduce the work per simulated time, a module
+/// with fixed timestep sheds work under overrun instead of adapting the
+/// frequency.
+///
 ////////////////////////////////////////////////////////////////////////////////
 class IThreadModule
 {
@@ -58,16 +107,25 @@ class IThreadModule
         virtual ~IThreadModule() {}
         
         //--- Constant Methods -----------------------------------------------//
+        const CFrameStats& getFrameStats() const {return m_FrameStats;}
         const double&   getFrequency() const;
               double    getTimePerFrame() const;
               double    getTimeProcessed() const;
                 
         //--- Methods --------------------------------------------------------//
+        CFrameStats&    getFrameStats() {return m_FrameStats;}
         virtual bool    processFrame() = 0;
         void            setFrequency(const double&);
 
         #ifdef BFE_MULTITHREADING
+          double getInterpolationAlpha() const {return m_fInterpolationAlpha.load(std::memory_order_acquire);}
+          int  getLoadLevel() const {return m_nLoadLevel.load(std::memory_order_relaxed);}
+          std::string getPlacement() const;
           void run();
+          bool setAffinity(const std::string&);
+          void setFixedTimestep(const double&, const int = FIXED_TIMESTEP_SUBSTEPS_MAX_DEFAULT);
+          void setFrequencyRange(const double&, const double&);
+          bool setScheduling(const std::string&, const int);
           void terminate();
         #endif
         
@@ -75,15 +133,46 @@ class IThreadModule
 
         //--- Methods [private] ----------------------------------------------//
         #ifdef BFE_MULTITHREADING
+          virtual void  frequencyChanged() {}   ///< Called after frequency was adapted to load
           virtual void  preRun() {}         ///< Everything that needs to be done before run()
+          virtual void  shedLoad(const int) {}  ///< Called with level of work to shed, 0: full work
           
           std::string   m_strModuleName;    ///< Name of module
           bool          m_bRunning = false; ///< Indicates if thread is running
         #endif
         
+        CFrameStats     m_FrameStats;       ///< History of processing time per frame
         double          m_fFrequency;       ///< Frequency of module update
         double          m_fTimeSlept;       ///< Sleep time of thread
         double          m_fTimeAccel;       ///< Time acceleration of module
+        
+    private:
+        
+        //--- Methods [private] ----------------------------------------------//
+        #ifdef BFE_MULTITHREADING
+          void          adaptFrequency();
+          void          applyPlacement();
+          
+          double            m_fFrequencyMin = 0.0;      ///< Minimum frequency when adapting
+          double            m_fFrequencyMax = 0.0;      ///< Maximum frequency when adapting, 0: no adaption
+          int               m_nNrOfOverruns = 0;        ///< Consecutive frames exceeding frame time
+          int               m_nNrOfSlack = 0;           ///< Consecutive frames with slack
+          int               m_nNrOfRestoreSlack = 0;    ///< Consecutive frames with slack to restore shed work
+          std::atomic<int>  m_nLoadLevel{0};            ///< Current level of shed work
+          
+          CFixedTimestep      m_FixedTimestep;              ///< Accumulator for fixed steps, if used
+          std::atomic<double> m_fInterpolationAlpha{0.0};   ///< Interpolation value of last frame, for readers
+          
+          //--- Variables [private] ------------------------------------------//
+          std::vector<int>  m_AffinityCPUs;             ///< CPUs the thread may run on, all if empty
+          ThreadPolicyType  m_Policy = ThreadPolicyType::DEFAULT; ///< Scheduling policy
+          int               m_nPriority = 0;            ///< Priority for real time policies
+          bool              m_bAffinityRequested = false;   ///< Affinity to be applied?
+          bool              m_bSchedulingRequested = false; ///< Scheduling to be applied?
+          std::string       m_strPlacement;             ///< Placement granted by the OS
+          mutable CSpinlock m_PlacementLock;            ///< Guards placement configuration and report
+          std::atomic<bool> m_bPlacementChanged{true};  ///< Placement has to be applied?
+        #endif
 };
 
 //--- Implementation is done here for inline optimisation --------------------//
@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       thread_pool.cpp
+/// \brief      Implementation of class "CThreadPool"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "thread_pool.h"
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+
+using namespace bfe;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+////////////////////////////////////////////////////////////////////////////////
+CThreadPool::CThreadPool()
+{
+    METHOD_ENTRY("CThreadPool::CThreadPool")
+    CTOR_CALL("CThreadPool::CThreadPool")
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Destructor, stopping workers
+///
+////////////////////////////////////////////////////////////////////////////////
+CThreadPool::~CThreadPool()
+{
+    METHOD_ENTRY("CThreadPool::~CThreadPool")
+    DTOR_CALL("CThreadPool::~CThreadPool")
+
+    this->stop();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Runs given number of tasks and waits for them to be done
+///
+/// \param _nNrOfTasks Number of tasks
+/// \param _Task Task, called with index of task
+///
+////////////////////////////////////////////////////////////////////////////////
+void CThreadPool::run(const std::size_t _nNrOfTasks,
+                      const std::function<void(const std::size_t)>& _Task)
+{
+    METHOD_ENTRY("CThreadPool::run")
+
+    #ifdef BFE_MULTITHREADING
+        if (!m_Workers.empty() && _nNrOfTasks > 1u)
+        {
+            {
+                std::lock_guard<std::mutex> Lock(m_MutexTasks);
+                m_pTask = &_Task;
+                m_nNrOfTasks = _nNrOfTasks;
+                m_nNextTask = 0u;
+                m_nWorkersBusy = int(m_Workers.size());
+                ++m_nGeneration;
+            }
+            m_CVStart.notify_all();
+
+            this->runTasks();
+
+            std::unique_lock<std::mutex> Lock(m_MutexTasks);
+            m_CVDone.wait(Lock, [this]{return m_nWorkersBusy == 0;});
+            m_pTask = nullptr;
+            return;
+        }
+    #endif
+
+    for (auto i=0u; i<_nNrOfTasks; ++i) _Task(i);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Starts worker threads
+///
+/// Without multithreading, only the calling thread is used.
+///
+/// \param _nNrOfThreads Number of threads including caller, 0 for number of
+///                      hardware threads
+///
+/// \return Success?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool CThreadPool::start(const int _nNrOfThreads)
+{
+    METHOD_ENTRY("CThreadPool::start")
+
+    #ifdef BFE_MULTITHREADING
+        this->stop();
+
+        int nNrOfThreads = _nNrOfThreads;
+        if (nNrOfThreads <= 0) nNrOfThreads = std::max(1u, std::thread::hardware_concurrency());
+
+        m_bRunning = true;
+        for (auto i=1; i<nNrOfThreads; ++i)
+        {
+            m_Workers.emplace_back(&CThreadPool::runWorker, this, m_nGeneration);
+        }
+        m_nNrOfThreads = nNrOfThreads;
+
+        DEBUG_MSG("Thread Pool", "Started with " << m_nNrOfThreads << " threads.")
+    #else
+        if (_nNrOfThreads > 1)
+        {
+            NOTICE_MSG("Thread Pool", "Multithreading disabled, using calling thread only.")
+        }
+        m_nNrOfThreads = 1;
+    #endif
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Stops worker threads
+///
+////////////////////////////////////////////////////////////////////////////////
+void CThreadPool::stop()
+{
+    METHOD_ENTRY("CThreadPool::stop")
+
+    #ifdef BFE_MULTITHREADING
+        {
+            std::lock_guard<std::mutex> Lock(m_MutexTasks);
+            m_bRunning = false;
+        }
+        m_CVStart.notify_all();
+        for (auto& Worker : m_Workers) Worker.join();
+        m_Workers.clear();
+    #endif
+    m_nNrOfThreads = 1;
+}
+
+#ifdef BFE_MULTITHREADING
+  ////////////////////////////////////////////////////////////////////////////////
+  ///
+  /// \brief Processes tasks of current run until none is left
+  ///
+  ////////////////////////////////////////////////////////////////////////////////
+  void CThreadPool::runTasks()
+  {
+      METHOD_ENTRY("CThreadPool::runTasks")
+
+      std::size_t nTask = m_nNextTask.fetch_add(1u, std::memory_order_relaxed);
+      while (nTask < m_nNrOfTasks)
+      {
+          (*m_pTask)(nTask);
+          nTask = m_nNextTask.fetch_add(1u, std::memory_order_relaxed);
+      }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ///
+  /// \brief Runs a worker, called as a thread
+  ///
+  /// \param _nGeneration Run counter at start of worker
+  ///
+  ////////////////////////////////////////////////////////////////////////////////
+  void CThreadPool::runWorker(const std::uint64_t _nGeneration)
+  {
+      METHOD_ENTRY("CThreadPool::runWorker")
+
+      std::uint64_t nGeneration = _nGeneration;
+      std::unique_lock<std::mutex> Lock(m_MutexTasks);
+      while (true)
+      {
+          m_CVStart.wait(Lock, [&]{return m_nGeneration != nGeneration || !m_bRunning;});
+          if (!m_bRunning) break;
+          nGeneration = m_nGeneration;
+
+          Lock.unlock();
+          this->runTasks();
+          Lock.lock();
+
+          if (--m_nWorkersBusy == 0) m_CVDone.notify_one();
+      }
+  }
+#endif
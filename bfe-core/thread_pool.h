@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       thread_pool.h
+/// \brief      Prototype of class "CThreadPool"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+//--- Standard header --------------------------------------------------------//
+#include <cstddef>
+#include <functional>
+#ifdef BFE_MULTITHREADING
+  #include <atomic>
+  #include <condition_variable>
+  #include <cstdint>
+  #include <mutex>
+  #include <thread>
+  #include <vector>
+#endif
+
+//--- Program header ---------------------------------------------------------//
+#include "conf_bfengine.h"
+#include "log.h"
+
+/// BFEngine namespace
+namespace bfe
+{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Pool of worker threads processing indexed tasks
+///
+/// A call of \ref run distributes a number of tasks, given by their index,
+/// to the workers and blocks until all of them are done. The calling thread
+/// processes tasks as well. Which thread processes which task is not
+/// defined, hence, tasks must be independent of each other. Without
+/// multithreading, all tasks are processed by the calling thread.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CThreadPool
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CThreadPool();
+        CThreadPool(const CThreadPool&) = delete;
+        CThreadPool& operator=(const CThreadPool&) = delete;
+        ~CThreadPool();
+
+        //--- Constant Methods -----------------------------------------------//
+        int getNrOfThreads() const {return m_nNrOfThreads;}
+
+        //--- Methods --------------------------------------------------------//
+        void run(const std::size_t, const std::function<void(const std::size_t)>&);
+        bool start(const int = 0);
+        void stop();
+
+    private:
+
+        //--- Methods [private] ----------------------------------------------//
+        #ifdef BFE_MULTITHREADING
+          void runTasks();
+          void runWorker(const std::uint64_t);
+        #endif
+
+        //--- Variables [private] --------------------------------------------//
+        int m_nNrOfThreads = 1;                             ///< Number of threads, including caller
+
+        #ifdef BFE_MULTITHREADING
+          std::vector<std::thread>  m_Workers;              ///< Worker threads
+          std::mutex                m_MutexTasks;           ///< Mutex, guarding task state
+          std::condition_variable   m_CVStart;              ///< Notifies workers of new tasks
+          std::condition_variable   m_CVDone;               ///< Notifies caller of workers being done
+          std::atomic<std::size_t>  m_nNextTask{0u};        ///< Index of next task to be processed
+          std::size_t               m_nNrOfTasks = 0u;      ///< Number of tasks of current run
+          std::uint64_t             m_nGeneration = 0u;     ///< Counter of runs, wakes up workers
+          int                       m_nWorkersBusy = 0;     ///< Number of workers not done with current run
+          bool                      m_bRunning = false;     ///< Indicates, if workers are running
+          const std::function<void(const std::size_t)>* m_pTask = nullptr; ///< Task of current run
+        #endif
+};
+
+} // namespace bfe
+
+#endif // THREAD_POOL_H
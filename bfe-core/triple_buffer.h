@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       triple_buffer.h
+/// \brief      Prototype of class "CTripleBuffer"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-15
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+//--- Standard header --------------------------------------------------------//
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+//--- Program header ---------------------------------------------------------//
+#include "log.h"
+
+/// BFEngine namespace
+namespace bfe
+{
+
+//--- Constants --------------------------------------------------------------//
+constexpr std::uint8_t TRIPLE_BUFFER_INDEX_MASK = 0x03u;  ///< Bits of shared state holding the index
+constexpr std::uint8_t TRIPLE_BUFFER_FRESH_FLAG = 0x04u;  ///< Bit of shared state indicating a new packet
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Lock free triple buffer, handing over packets from one producer to
+///        one consumer
+///
+/// The producer (e.g. simulation) fills the write buffer and publishes it as
+/// a complete packet at the end of a step. The consumer (e.g. graphics)
+/// updates to the latest published packet once per frame and reads only
+/// from there. Since both sides own a buffer of their own and only the
+/// index of the third buffer is exchanged atomically, neither side waits and
+/// a packet is never read while being written. Packets that are published
+/// faster than consumed are skipped.
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+class CTripleBuffer
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CTripleBuffer() = default;
+        CTripleBuffer(const CTripleBuffer<T>&) = delete;
+        CTripleBuffer<T>& operator=(const CTripleBuffer<T>&) = delete;
+
+        //--- Constant Methods -----------------------------------------------//
+        const T& getReadBuffer() const;
+
+        //--- Methods --------------------------------------------------------//
+        T&   getWriteBuffer();
+        void publish();
+        bool update();
+
+    private:
+
+        //--- Variables [private] --------------------------------------------//
+        std::array<T, 3>            m_Buffers;                  ///< Read, write and shared buffer
+        std::atomic<std::uint8_t>   m_unShared{2u};             ///< Index of shared buffer and fresh flag
+        std::uint8_t                m_unRead = 0u;              ///< Index of buffer owned by consumer
+        std::uint8_t                m_unWrite = 1u;             ///< Index of buffer owned by producer
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns packet currently owned by consumer
+///
+/// The packet stays the same until \ref update is called.
+///
+/// \return Latest packet at the time of last update
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline const T& CTripleBuffer<T>::getReadBuffer() const
+{
+    METHOD_ENTRY("CTripleBuffer::getReadBuffer")
+    return m_Buffers[m_unRead];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns buffer currently owned by producer
+///
+/// The buffer does not necessarily hold the last published packet, hence,
+/// it should be written completely before publishing.
+///
+/// \return Buffer to write next packet to
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline T& CTripleBuffer<T>::getWriteBuffer()
+{
+    METHOD_ENTRY("CTripleBuffer::getWriteBuffer")
+    return m_Buffers[m_unWrite];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Publishes write buffer as latest packet
+///
+/// The write buffer is exchanged with the shared buffer, which becomes the
+/// new write buffer.
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline void CTripleBuffer<T>::publish()
+{
+    METHOD_ENTRY("CTripleBuffer::publish")
+    m_unWrite = m_unShared.exchange(m_unWrite | TRIPLE_BUFFER_FRESH_FLAG,
+                                    std::memory_order_acq_rel) & TRIPLE_BUFFER_INDEX_MASK;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Takes over latest published packet, if any
+///
+/// \return New packet available?
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline bool CTripleBuffer<T>::update()
+{
+    METHOD_ENTRY("CTripleBuffer::update")
+
+    if ((m_unShared.load(std::memory_order_relaxed) & TRIPLE_BUFFER_FRESH_FLAG) == 0u) return false;
+
+    m_unRead = m_unShared.exchange(m_unRead, std::memory_order_acq_rel) & TRIPLE_BUFFER_INDEX_MASK;
+    return true;
+}
+
+} // namespace bfe
+
+#endif // TRIPLE_BUFFER_H
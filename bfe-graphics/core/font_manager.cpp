@@ -31,7 +31,25 @@
 #include "font_manager.h"
 
 //--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+// Use memory mapping for reading font atlas cache where available
+#if defined(__unix__) || defined(__APPLE__)
+    #define FONT_MGR_USE_MMAP
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+//--- Program header ---------------------------------------------------------//
+#include "hash.h"
 
 //--- Misc-Header ------------------------------------------------------------//
 
@@ -53,6 +71,38 @@ CFontManager::~CFontManager()
     METHOD_ENTRY("CFontManager::~CFontManager")
     DTOR_CALL("CFontManager::~CFontManager")
     
+    #ifdef BFE_MULTITHREADING
+        if (m_bWorkerRunning)
+        {
+            {
+                std::lock_guard<std::mutex> Lock(m_MutexJobs);
+                m_bWorkerRunning = false;
+            }
+            m_CVJobs.notify_one();
+            m_Worker.join();
+        }
+        // Free prepared fonts that were never uploaded. Queued jobs don't
+        // hold any memory, yet.
+        for (auto& Job : m_JobsDone)
+        {
+            if (Job.pFontMemLoaded != nullptr)
+            {
+                delete[] Job.pFontMemLoaded;
+                MEM_FREED("char")
+            }
+            if (Job.pAtlas != nullptr)
+            {
+                delete[] Job.pAtlas;
+                MEM_FREED("std::uint8_t")
+            }
+            if (Job.pCharInfo != nullptr)
+            {
+                delete[] Job.pCharInfo;
+                MEM_FREED("stbtt_packedchar")
+            }
+        }
+    #endif
+    
     for (auto FontMem : m_FontsMemByName)
     {
         if (FontMem.second != nullptr)
@@ -112,38 +162,120 @@ bool CFontManager::addFont(const std::string& _strFontName,
 {
     METHOD_ENTRY("CFontManager::addFont")
     
-    char* pMemFont = nullptr;
-   
     //--------------------------------------------------------------------------
     // Load font from given file
     //--------------------------------------------------------------------------
-    std::streampos nSize;
-    std::ifstream  inStream(_strFile, std::ios::in|std::ios::binary|std::ios::ate);
-    if (inStream.is_open())
-    {
-        nSize = inStream.tellg();
-        pMemFont = new char[nSize];
-        MEM_ALLOC("char")
-        inStream.seekg (0, std::ios::beg);
-        inStream.read(pMemFont, nSize);
-        inStream.close();
+    FontAtlasJob Job;
+    Job.strFontName = _strFontName;
+    Job.strFile = _strFile;
+    if (!this->loadFontFile(Job)) return false;
+    
+    m_FontsMemByName[_strFontName] = Job.pFontMemLoaded;
+    m_FontsHashByName[_strFontName] = Job.unHash;
+    
+    m_strFont = _strFontName;
+    
+    this->rasterize(_strFontName, _nSize);
+    
+    return true;
+}
 
-        m_FontsMemByName[_strFontName] = pMemFont;
-        
-        DOM_FIO(INFO_MSG("Font Manager", "Font " << _strFile << " successfully loaded to memory."))
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Prepares given font and size in the background
+///
+/// With multithreading enabled, the font atlas is loaded from cache or
+/// rasterised by the worker thread, and uploaded by the GL thread with the
+/// next text drawn (see \ref uploadPreparedFonts). Otherwise, the font is
+/// rasterised immediately. Current font and size are not changed.
+///
+/// \param _strFontName Name of font, which has to be added or preloaded before
+/// \param _nSize       Size of font when rasterized
+///
+/// \return Success?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool CFontManager::preloadFont(const std::string& _strFontName, const int _nSize)
+{
+    METHOD_ENTRY("CFontManager::preloadFont")
+    
+    const std::string strFontDesignator = this->getDesignator(_strFontName, _nSize);
+    
+    if (m_FontsByName.find(strFontDesignator) != m_FontsByName.end() ||
+        m_FontsPending.find(strFontDesignator) != m_FontsPending.end())
+    {
+        return true;
     }
-    else
+    
+    const auto ciMem  = m_FontsMemByName.find(_strFontName);
+    const auto ciFile = m_FontsFilePending.find(_strFontName);
+    if (ciMem == m_FontsMemByName.end() && ciFile == m_FontsFilePending.end())
     {
-        DOM_FIO(ERROR_MSG("Font Manager", "Could not load font " << _strFile << "."))
+        WARNING_MSG("Font Manager", "Font <" << _strFontName << "> unknown.")
         return false;
     }
-    m_strFont = _strFontName;
     
-    this->rasterize(_strFontName, _nSize);
+    #ifdef BFE_MULTITHREADING
+        FontAtlasJob Job;
+        this->initJob(Job, _strFontName, _nSize);
+        
+        // Font data is still loaded by another job, hence, it has to be
+        // loaded again. Duplicates are discarded on upload.
+        if (ciMem == m_FontsMemByName.end()) Job.strFile = ciFile->second;
+        
+        m_FontsPending.insert(strFontDesignator);
+        {
+            std::lock_guard<std::mutex> Lock(m_MutexJobs);
+            if (!m_bWorkerRunning)
+            {
+                m_bWorkerRunning = true;
+                m_Worker = std::thread(&CFontManager::runWorker, this);
+            }
+            m_JobsQueued.push_back(Job);
+        }
+        m_CVJobs.notify_one();
+    #else
+        this->rasterize(_strFontName, _nSize);
+    #endif
     
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Loads given font file and prepares given size in the background
+///
+/// \param _strFontName Name to register font with
+/// \param _strFile     Path and name of truetype font
+/// \param _nSize       Size of font when rasterized
+///
+/// \return Success?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool CFontManager::preloadFont(const std::string& _strFontName,
+                               const std::string& _strFile,
+                               const int _nSize)
+{
+    METHOD_ENTRY("CFontManager::preloadFont")
+    
+    if (m_FontsMemByName.find(_strFontName) == m_FontsMemByName.end() &&
+        m_FontsFilePending.find(_strFontName) == m_FontsFilePending.end())
+    {
+        #ifdef BFE_MULTITHREADING
+            m_FontsFilePending[_strFontName] = _strFile;
+        #else
+            FontAtlasJob Job;
+            Job.strFontName = _strFontName;
+            Job.strFile = _strFile;
+            if (!this->loadFontFile(Job)) return false;
+            
+            m_FontsMemByName[_strFontName] = Job.pFontMemLoaded;
+            m_FontsHashByName[_strFontName] = Job.unHash;
+        #endif
+    }
+    return this->preloadFont(_strFontName, _nSize);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Draws given text, i.e. buffering textured quads for GL to be called
@@ -184,6 +316,7 @@ void CFontManager::drawText(const std::string& _strText,
 {
     METHOD_ENTRY("CFontManager::drawText")
     
+    this->uploadPreparedFonts();
     if (m_bChanged) this->changeFont();
     
     glActiveTexture(GL_TEXTURE0);
@@ -203,13 +336,15 @@ void CFontManager::drawText(const std::string& _strText,
             b = m_pFontCharInfo + Ch-ASCII_FIRST;
             fSize += b->xadvance;
         }
+        fSize *= m_fScale;
     }
+    // Offsets are given in atlas space, hence, scale is applied to output
     for (const auto Ch : _strText)
     {
         if (Ch == 10) // Line feed
         {
             fOffsetX = 0.0f;
-            fOffsetY += m_nSize;
+            fOffsetY += m_nSize / m_fScale;
         }
         else
         {
@@ -217,10 +352,10 @@ void CFontManager::drawText(const std::string& _strText,
                                 m_nAtlasSize, m_nAtlasSize,
                                 Ch - ASCII_FIRST,
                                 &fOffsetX, &fOffsetY, &GlyphQuad, 1);
-            if (fOffsetX > _nWrap && _nWrap > 0) // Word wrap
+            if (fOffsetX * m_fScale > _nWrap && _nWrap > 0) // Word wrap
             {
                 fOffsetX = 0.0f;
-                fOffsetY += m_nSize;
+                fOffsetY += m_nSize / m_fScale;
                 stbtt_GetPackedQuad(m_pFontCharInfo,
                                     m_nAtlasSize, m_nAtlasSize,
                                     Ch - ASCII_FIRST,
@@ -232,14 +367,63 @@ void CFontManager::drawText(const std::string& _strText,
                       GlyphQuad.s0, GlyphQuad.t1,
                       GlyphQuad.s1, GlyphQuad.t1};
                     
-            m_Graphics.texturedRect(Vector2d(GlyphQuad.x0, GlyphQuad.y0)+Vector2d(_fPosX-fSize/2, _fPosY),
-                                    Vector2d(GlyphQuad.x1, GlyphQuad.y1)+Vector2d(_fPosX-fSize/2, _fPosY),
+            m_Graphics.texturedRect(Vector2d(GlyphQuad.x0, GlyphQuad.y0)*m_fScale+Vector2d(_fPosX-fSize/2, _fPosY),
+                                    Vector2d(GlyphQuad.x1, GlyphQuad.y1)*m_fScale+Vector2d(_fPosX-fSize/2, _fPosY),
                                     &vecUVs);
         }
     }
     
-    m_fLastPosX = fOffsetX + _fPosX;
-    m_fLastPosY = fOffsetY + _fPosY;
+    m_fLastPosX = fOffsetX * m_fScale + _fPosX;
+    m_fLastPosY = fOffsetY * m_fScale + _fPosY;
+    
+    m_FontsIdleTime[m_unTexID]->restart();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Draws given text layout, i.e. buffering the cached textured quads
+///        for GL to be called by graphics update.
+///
+/// Since glyph placement is already done in \ref layoutText, this is a plain
+/// copy of quads, avoiding the per glyph lookup. If the layout was created
+/// with another atlas, e.g. a previous one while the font was prepared, it
+/// is recreated first.
+///
+/// \param _Layout      Text layout to be drawn, recreated if outdated
+/// \param _fPosX       Position X
+/// \param _fPosY       Position Y
+///
+////////////////////////////////////////////////////////////////////////////////
+void CFontManager::drawText(TextLayout& _Layout,
+                            const float& _fPosX,
+                            const float& _fPosY)
+{
+    METHOD_ENTRY("CFontManager::drawText")
+    
+    this->setFont(_Layout.strFont);
+    this->setSize(_Layout.nSize);
+    this->uploadPreparedFonts();
+    if (m_bChanged) this->changeFont();
+    
+    if (_Layout.unAtlasGeneration != m_unAtlasGeneration)
+    {
+        this->layoutText(_Layout.strText, _Layout, _Layout.nWrap);
+    }
+    
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_unTexID);
+    
+    std::vector<GLfloat> vecUVs; vecUVs.resize(8);
+    
+    auto j = 0u;
+    for (auto i = 0u; i < _Layout.Quads.size(); i += 4)
+    {
+        vecUVs.assign(_Layout.UVs.begin()+j, _Layout.UVs.begin()+j+8);
+        m_Graphics.texturedRect(Vector2d(_Layout.Quads[i]  +_fPosX, _Layout.Quads[i+1]+_fPosY),
+                                Vector2d(_Layout.Quads[i+2]+_fPosX, _Layout.Quads[i+3]+_fPosY),
+                                &vecUVs);
+        j += 8;
+    }
     
     m_FontsIdleTime[m_unTexID]->restart();
 }
@@ -264,15 +448,17 @@ float CFontManager::getTextLength(const std::string& _strText,
     const auto ci = m_FontsMemByName.find(_strFont);
     if (ci != m_FontsMemByName.end())
     {
-        std::string strFontDesignator = std::to_string(_nSize)+_strFont;
+        std::string strFontDesignator = this->getDesignator(_strFont, _nSize);
         
         auto nID = 0u;
 
+        // Measuring has to be exact, hence, fonts are rasterised immediately
         auto it = m_FontsByName.find(strFontDesignator);
         if (it == m_FontsByName.end())
         {
             this->rasterize(_strFont, _nSize);
             it = m_FontsByName.find(strFontDesignator);
+            if (it == m_FontsByName.end()) return 0.0f;
         }
         
         nID = it->second;
@@ -300,7 +486,7 @@ float CFontManager::getTextLength(const std::string& _strText,
         
         m_FontsIdleTime[nID]->restart();
         
-        return fLengthMax;
+        return fLengthMax * float(_nSize) / m_AtlasFontSizes[nID];
     }
     else
     {
@@ -309,6 +495,95 @@ float CFontManager::getTextLength(const std::string& _strText,
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Creates the layout of given text, using current font and size
+///
+/// The layout can be cached by the caller and drawn repeatedly by
+/// \ref drawText without recalculating glyph positions.
+///
+/// \param _strText Text to create layout for
+/// \param _Layout  Text layout to be written to
+/// \param _nWrap   Word wrap position
+///
+////////////////////////////////////////////////////////////////////////////////
+void CFontManager::layoutText(const std::string& _strText,
+                              TextLayout& _Layout,
+                              const int _nWrap)
+{
+    METHOD_ENTRY("CFontManager::layoutText")
+    
+    this->uploadPreparedFonts();
+    if (m_bChanged) this->changeFont();
+    
+    _Layout.Quads.clear();
+    _Layout.UVs.clear();
+    _Layout.Quads.reserve(_strText.size()*4);
+    _Layout.UVs.reserve(_strText.size()*8);
+    _Layout.strText = _strText;
+    _Layout.strFont = m_strFont;
+    _Layout.nSize = m_nSize;
+    _Layout.nWrap = _nWrap;
+    _Layout.nLines = 1;
+    _Layout.unAtlasGeneration = m_unAtlasGeneration;
+    
+    stbtt_aligned_quad GlyphQuad;
+    float fOffsetX = 0.0f;
+    float fOffsetY = 0.0f;
+    
+    for (const auto Ch : _strText)
+    {
+        if (Ch == 10) // Line feed
+        {
+            fOffsetX = 0.0f;
+            fOffsetY += m_nSize / m_fScale;
+            ++_Layout.nLines;
+        }
+        else
+        {
+            stbtt_GetPackedQuad(m_pFontCharInfo,
+                                m_nAtlasSize, m_nAtlasSize,
+                                Ch - ASCII_FIRST,
+                                &fOffsetX, &fOffsetY, &GlyphQuad, 1);
+            if (fOffsetX * m_fScale > _nWrap && _nWrap > 0) // Word wrap
+            {
+                fOffsetX = 0.0f;
+                fOffsetY += m_nSize / m_fScale;
+                ++_Layout.nLines;
+                stbtt_GetPackedQuad(m_pFontCharInfo,
+                                    m_nAtlasSize, m_nAtlasSize,
+                                    Ch - ASCII_FIRST,
+                                    &fOffsetX, &fOffsetY, &GlyphQuad, 1);
+            }
+            
+            _Layout.Quads.insert(_Layout.Quads.end(), {GlyphQuad.x0*m_fScale, GlyphQuad.y0*m_fScale,
+                                                       GlyphQuad.x1*m_fScale, GlyphQuad.y1*m_fScale});
+            _Layout.UVs.insert(_Layout.UVs.end(), {GlyphQuad.s0, GlyphQuad.t0,
+                                                   GlyphQuad.s1, GlyphQuad.t0,
+                                                   GlyphQuad.s0, GlyphQuad.t1,
+                                                   GlyphQuad.s1, GlyphQuad.t1});
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets directory for font atlas cache
+///
+/// Rasterised font atlases are stored here and reused on next start. The
+/// directory has to exist, an empty string disables caching.
+///
+/// \param _strDir Directory for font atlas cache
+///
+////////////////////////////////////////////////////////////////////////////////
+void CFontManager::setCacheDirectory(const std::string& _strDir)
+{
+    METHOD_ENTRY("CFontManager::setCacheDirectory")
+    m_strCacheDir = _strDir;
+    if (m_strCacheDir != "" && m_strCacheDir.back() != '/') m_strCacheDir += "/";
+    DOM_FIO(INFO_MSG("Font Manager", "Using font atlas cache directory " << m_strCacheDir))
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Set the given font for usage
@@ -355,6 +630,8 @@ void CFontManager::triggerMaintenance()
 {
     METHOD_ENTRY("CFontManager::triggerMaintenance")
     
+    this->uploadPreparedFonts();
+    
     if (m_FontsByName.size() > FONT_MGR_MAX_FONTS_BEFORE_REMOVAL)
     {
         std::vector<GLuint> IDs;
@@ -383,117 +660,384 @@ void CFontManager::changeFont()
 {
     METHOD_ENTRY("CFontManager::changeFont")
     
-    const auto ci = m_FontsMemByName.find(m_strFont);
-    if (ci != m_FontsMemByName.end())
+    const std::string strFontDesignator = this->getDesignator(m_strFont, m_nSize);
+    
+    auto it = m_FontsByName.find(strFontDesignator);
+    if (it == m_FontsByName.end())
     {
-        std::string strFontDesignator = std::to_string(m_nSize)+m_strFont;
-        
-        const auto ci = m_FontsByName.find(strFontDesignator);
-        if (ci != m_FontsByName.end())
-        {
-            m_unTexID = ci->second;
-        }
-        else
+        bool bPreparing = false;
+        #ifdef BFE_MULTITHREADING
+            // Font is prepared by worker thread, previous atlas is scaled to
+            // requested size meanwhile
+            bPreparing = (m_AtlasFontSizes.find(m_unTexID) != m_AtlasFontSizes.end() &&
+                          this->preloadFont(m_strFont, m_nSize));
+        #endif
+        if (!bPreparing && m_FontsMemByName.find(m_strFont) != m_FontsMemByName.end())
         {
             this->rasterize(m_strFont, m_nSize);
-            m_unTexID = m_FontsByName[strFontDesignator];
+            it = m_FontsByName.find(strFontDesignator);
         }
-
-        // End current render batch since it is bound to the font texture
-        m_Graphics.restartRenderBatch(m_strRenderModeName);
-        
-        m_pFontCharInfo = m_FontsCharInfo[m_unTexID];
-        m_nAtlasSize    = m_AtlasSizes[m_unTexID];
-    
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, m_unTexID);
-        
-        m_FontsIdleTime[m_unTexID]->restart();
+        m_bFallback = bPreparing;
     }
     else
+    {
+        m_bFallback = false;
+    }
+    
+    if (it == m_FontsByName.end() && !m_bFallback)
     {
         WARNING_MSG("Font Manager", "Font <" << m_strFont << "> unknown.")
+        m_bChanged = false;
+        return;
     }
+    if (it != m_FontsByName.end()) m_unTexID = it->second;
+
+    // End current render batch since it is bound to the font texture
+    m_Graphics.restartRenderBatch(m_strRenderModeName);
+    
+    m_pFontCharInfo = m_FontsCharInfo[m_unTexID];
+    m_nAtlasSize    = m_AtlasSizes[m_unTexID];
+    m_fScale        = float(m_nSize) / m_AtlasFontSizes[m_unTexID];
+    m_unAtlasGeneration = m_AtlasGenerations[m_unTexID];
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_unTexID);
+    
+    m_FontsIdleTime[m_unTexID]->restart();
+    
     m_bChanged = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
-/// \brief Rasterizes font
+/// \brief Converts a rasterised glyph atlas into a signed distance field
 ///
-/// \param _strFontName Name of font to rasterize
-/// \param _nSize Size for rasterized font
+/// The exact euclidean distance transform (Felzenszwalb/Huttenlocher) is
+/// computed for inside and outside of glyphs. Signed distances are mapped to
+/// [0, 255] with 128 representing the outline and a range of
+/// \ref FONT_MGR_SDF_SPREAD on each side.
+///
+/// \param _pAtlas      Atlas bitmap, overwritten by distance field
+/// \param _nAtlasSize  Size of atlas (both dimensions)
 ///
 ////////////////////////////////////////////////////////////////////////////////
-void CFontManager::rasterize(const std::string& _strFontName, const int _nSize)
+void CFontManager::computeDistanceField(std::uint8_t* const _pAtlas, const int _nAtlasSize) const
 {
-    METHOD_ENTRY("CFontManager::rasterize")
+    METHOD_ENTRY("CFontManager::computeDistanceField")
     
-    DEBUG_MSG("Font manager", "Rasterising font " << _strFontName << ", Size: " << _nSize)
+    constexpr float fInf = 1.0e20f;
+    const int nN = _nAtlasSize;
     
-    std::string strFontDesignator = std::to_string(_nSize)+_strFontName;
-    GLuint unIDTex = 0u;
-    if (m_FontsByName.find(strFontDesignator) == m_FontsByName.end())
+    std::vector<float> vecF(nN);
+    std::vector<float> vecD(nN);
+    std::vector<float> vecZ(nN+1);
+    std::vector<int>   vecV(nN);
+    
+    // One dimensional squared distance transform of sampled function
+    auto transform1D = [&](const int _nLength)
     {
-        glGenTextures(1, &unIDTex);
-        m_FontsByName[strFontDesignator] = unIDTex;
+        int k = 0;
+        vecV[0] = 0;
+        vecZ[0] = -fInf;
+        vecZ[1] = +fInf;
+        for (auto q=1; q < _nLength; ++q)
+        {
+            float fS = ((vecF[q]+q*q) - (vecF[vecV[k]]+vecV[k]*vecV[k])) / (2*q-2*vecV[k]);
+            while (fS <= vecZ[k])
+            {
+                --k;
+                fS = ((vecF[q]+q*q) - (vecF[vecV[k]]+vecV[k]*vecV[k])) / (2*q-2*vecV[k]);
+            }
+            ++k;
+            vecV[k] = q;
+            vecZ[k] = fS;
+            vecZ[k+1] = +fInf;
+        }
+        k = 0;
+        for (auto q=0; q < _nLength; ++q)
+        {
+            while (vecZ[k+1] < q) ++k;
+            vecD[q] = (q-vecV[k])*(q-vecV[k]) + vecF[vecV[k]];
+        }
+    };
+    
+    // Two dimensional squared distance transform, separated by columns and rows
+    auto transform2D = [&](std::vector<float>& _vecGrid)
+    {
+        for (auto x=0; x < nN; ++x)
+        {
+            for (auto y=0; y < nN; ++y) vecF[y] = _vecGrid[y*nN+x];
+            transform1D(nN);
+            for (auto y=0; y < nN; ++y) _vecGrid[y*nN+x] = vecD[y];
+        }
+        for (auto y=0; y < nN; ++y)
+        {
+            for (auto x=0; x < nN; ++x) vecF[x] = _vecGrid[y*nN+x];
+            transform1D(nN);
+            for (auto x=0; x < nN; ++x) _vecGrid[y*nN+x] = vecD[x];
+        }
+    };
+    
+    std::vector<float> vecOutside(nN*nN);
+    std::vector<float> vecInside(nN*nN);
+    for (auto i=0; i < nN*nN; ++i)
+    {
+        const bool bInside = (_pAtlas[i] > 127);
+        vecOutside[i] = bInside ? 0.0f : fInf;
+        vecInside[i]  = bInside ? fInf : 0.0f;
     }
-    else
+    transform2D(vecOutside);
+    transform2D(vecInside);
+    
+    for (auto i=0; i < nN*nN; ++i)
     {
-        WARNING_MSG("Font Manager", "Font with name " << _strFontName << " already existing.")
-        unIDTex = m_FontsByName[strFontDesignator];
+        float fDist = std::sqrt(vecOutside[i]) - std::sqrt(vecInside[i]);
+        float fValue = 0.5f - fDist / (2.0f*FONT_MGR_SDF_SPREAD);
+        if (fValue < 0.0f) fValue = 0.0f;
+        if (fValue > 1.0f) fValue = 1.0f;
+        _pAtlas[i] = std::uint8_t(fValue * 255.0f);
     }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns filename of font atlas cache for given job
+///
+/// \param _Job Font atlas job, providing font hash, size and atlas type
+///
+/// \return Filename including cache directory
+///
+////////////////////////////////////////////////////////////////////////////////
+const std::string CFontManager::getAtlasCacheFile(const FontAtlasJob& _Job) const
+{
+    METHOD_ENTRY("CFontManager::getAtlasCacheFile")
     
-    DOM_VAR(DEBUG_BLK(
-        std::cout << "  Font memory: " << std::endl;
-        for (const auto Font : m_FontsByName)
+    std::ostringstream oss;
+    oss << _Job.strCacheDir << std::hex << std::setw(16) << std::setfill('0')
+        << _Job.unHash << std::dec << "_"
+        << (_Job.bSDF ? FONT_MGR_SDF_PREFIX : "") << this->getAtlasFontSize(_Job)
+        << "_" << FONT_MGR_ATLAS_SIZE_DEFAULT << ".atlas";
+    return oss.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Initialises font atlas job from current font manager state
+///
+/// \param _Job         Font atlas job to be initialised
+/// \param _strFontName Name of font
+/// \param _nSize       Font size of atlas
+///
+////////////////////////////////////////////////////////////////////////////////
+void CFontManager::initJob(FontAtlasJob& _Job, const std::string& _strFontName, const int _nSize) const
+{
+    METHOD_ENTRY("CFontManager::initJob")
+    
+    _Job.strFontName = _strFontName;
+    _Job.strCacheDir = m_strCacheDir;
+    _Job.nSize = _nSize;
+    _Job.bSDF = m_bSDF;
+    
+    const auto ciMem = m_FontsMemByName.find(_strFontName);
+    if (ciMem != m_FontsMemByName.end()) _Job.pFontMem = ciMem->second;
+    const auto ciHash = m_FontsHashByName.find(_strFontName);
+    if (ciHash != m_FontsHashByName.end()) _Job.unHash = ciHash->second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Loads font atlas and glyph metrics from disk cache
+///
+/// Cache files are keyed by font file hash, font size, SDF mode and initial
+/// atlas size. They are mapped to memory (if supported by the platform) and
+/// validated against their header before being copied in one go.
+///
+/// \param _Job Font atlas job, atlas memory is allocated and glyph metrics
+///             are written if successfully loaded
+///
+/// \return Success?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool CFontManager::loadAtlasCache(FontAtlasJob& _Job) const
+{
+    METHOD_ENTRY("CFontManager::loadAtlasCache")
+    
+    if (_Job.strCacheDir == "") return false;
+    
+    const std::string strFile = this->getAtlasCacheFile(_Job);
+    
+    const std::uint8_t* pData = nullptr;
+    std::size_t nDataSize = 0u;
+    
+    #ifdef FONT_MGR_USE_MMAP
+        int nFD = open(strFile.c_str(), O_RDONLY);
+        if (nFD < 0) return false;
+        struct stat FileStat;
+        if (fstat(nFD, &FileStat) != 0 || FileStat.st_size < off_t(sizeof(FontAtlasCacheHeader)))
         {
-            std::cout << "  - " << Font.first << std::endl;
+            close(nFD);
+            return false;
         }
-    ))
+        nDataSize = FileStat.st_size;
+        void* pMap = mmap(nullptr, nDataSize, PROT_READ, MAP_PRIVATE, nFD, 0);
+        close(nFD);
+        if (pMap == MAP_FAILED) return false;
+        pData = static_cast<const std::uint8_t*>(pMap);
+    #else
+        std::ifstream InStream(strFile, std::ios::in|std::ios::binary|std::ios::ate);
+        if (!InStream.is_open()) return false;
+        nDataSize = InStream.tellg();
+        std::vector<char> vecData(nDataSize);
+        InStream.seekg(0, std::ios::beg);
+        InStream.read(vecData.data(), nDataSize);
+        InStream.close();
+        pData = reinterpret_cast<const std::uint8_t*>(vecData.data());
+    #endif
     
-    //--------------------------------------------------------------------------
-    // Use stb_truetype to rasterise font
-    //--------------------------------------------------------------------------
-    m_pFontCharInfo = new stbtt_packedchar[ASCII_NR];
-    m_FontsCharInfo[unIDTex] = m_pFontCharInfo;
-    MEM_ALLOC("stbtt_packedchar")
+    bool bValid = false;
+    FontAtlasCacheHeader Header;
+    if (nDataSize >= sizeof(FontAtlasCacheHeader))
+    {
+        std::memcpy(&Header, pData, sizeof(FontAtlasCacheHeader));
+        
+        bValid = (Header.unMagic == FONT_MGR_CACHE_MAGIC &&
+                  Header.unVersion == FONT_MGR_CACHE_VERSION &&
+                  Header.unHash == _Job.unHash &&
+                  Header.nSize == this->getAtlasFontSize(_Job) &&
+                  Header.nSDF == int(_Job.bSDF) &&
+                  Header.nNrOfChars == ASCII_NR &&
+                  Header.nAtlasSize > 0 &&
+                  nDataSize == sizeof(FontAtlasCacheHeader) +
+                               sizeof(stbtt_packedchar) * ASCII_NR +
+                               std::size_t(Header.nAtlasSize) * Header.nAtlasSize);
+    }
+    if (bValid)
+    {
+        _Job.nAtlasSize = Header.nAtlasSize;
+        _Job.pAtlas = new std::uint8_t[_Job.nAtlasSize*_Job.nAtlasSize];
+        MEM_ALLOC("std::uint8_t")
+        
+        const std::uint8_t* pCharInfo = pData + sizeof(FontAtlasCacheHeader);
+        std::memcpy(_Job.pCharInfo, pCharInfo, sizeof(stbtt_packedchar) * ASCII_NR);
+        std::memcpy(_Job.pAtlas, pCharInfo + sizeof(stbtt_packedchar) * ASCII_NR,
+                    std::size_t(_Job.nAtlasSize) * _Job.nAtlasSize);
+        
+        DOM_FIO(DEBUG_MSG("Font Manager", "Font atlas loaded from cache " << strFile))
+    }
+    else
+    {
+        DOM_FIO(NOTICE_MSG("Font Manager", "Font atlas cache " << strFile << " invalid, rasterising."))
+    }
+    
+    #ifdef FONT_MGR_USE_MMAP
+        munmap(const_cast<std::uint8_t*>(pData), nDataSize);
+    #endif
+    
+    return bValid;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Loads truetype font file of given job to memory
+///
+/// The font data is hashed (FNV-1a), the hash is used as key for the font
+/// atlas cache.
+///
+/// \param _Job Font atlas job, font data is allocated if successfully loaded
+///
+/// \return Success?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool CFontManager::loadFontFile(FontAtlasJob& _Job) const
+{
+    METHOD_ENTRY("CFontManager::loadFontFile")
+    
+    std::ifstream inStream(_Job.strFile, std::ios::in|std::ios::binary|std::ios::ate);
+    if (inStream.is_open())
+    {
+        std::streampos nSize = inStream.tellg();
+        _Job.pFontMemLoaded = new char[nSize];
+        MEM_ALLOC("char")
+        inStream.seekg (0, std::ios::beg);
+        inStream.read(_Job.pFontMemLoaded, nSize);
+        inStream.close();
+        
+        _Job.unHash = fnv1a(_Job.pFontMemLoaded, std::size_t(nSize));
+        
+        DOM_FIO(INFO_MSG("Font Manager", "Font " << _Job.strFile << " successfully loaded to memory."))
+        return true;
+    }
+    else
+    {
+        DOM_FIO(ERROR_MSG("Font Manager", "Could not load font " << _Job.strFile << "."))
+        return false;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Packs font atlas using stb_truetype
+///
+/// The atlas is enlarged if glyphs don't fit. This method is independent of
+/// the font manager's state, apart from the (read only) font memory.
+///
+/// \param _pFontMem    Truetype font data
+/// \param _nSize       Font size of atlas
+/// \param _bSDF        Create signed distance field atlas?
+/// \param _ppAtlas     Atlas memory, allocated if successfully packed
+/// \param _pCharInfo   Glyph metrics to be written to
+/// \param _nAtlasSize  Size of packed atlas
+///
+/// \return Success?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool CFontManager::packAtlas(const char* const _pFontMem, const int _nSize, const bool _bSDF,
+                             std::uint8_t** const _ppAtlas,
+                             stbtt_packedchar* const _pCharInfo,
+                             int& _nAtlasSize) const
+{
+    METHOD_ENTRY("CFontManager::packAtlas")
     
     bool bPacked = false;
     int  nAtlasScale = 1;
     
+    // Distance field atlases are rasterised at reference size, glyphs are
+    // padded to leave room for the distance field around outlines
+    const int nSize    = _bSDF ? FONT_MGR_SDF_SIZE : _nSize;
+    const int nPadding = _bSDF ? FONT_MGR_SDF_SPREAD*2 : 1;
+    
     // Pack atlas. Retry with bigger texture if neccessary
     while (!bPacked && nAtlasScale <= 8)
     {
-        auto it = m_FontsMemAtlas.find(unIDTex);
-        if (it != m_FontsMemAtlas.end())
+        if (*_ppAtlas != nullptr)
         {
-            if (m_FontsMemAtlas[unIDTex] != nullptr)
-            {
-                delete m_FontsMemAtlas[unIDTex];
-                MEM_FREED("std::uint8_t")
-                m_FontsMemAtlas[unIDTex] = nullptr;
-            }
+            delete[] *_ppAtlas;
+            MEM_FREED("std::uint8_t")
+            *_ppAtlas = nullptr;
         }
-        m_FontsMemAtlas[unIDTex] = new std::uint8_t[FONT_MGR_ATLAS_SIZE_DEFAULT*
-                                                    FONT_MGR_ATLAS_SIZE_DEFAULT*
-                                                    nAtlasScale*nAtlasScale];
+        _nAtlasSize = FONT_MGR_ATLAS_SIZE_DEFAULT*nAtlasScale;
+        *_ppAtlas = new std::uint8_t[_nAtlasSize*_nAtlasSize];
         MEM_ALLOC("std::uint8_t")
         
+        // Glyphs of distance field atlases are packed with an offset, so that
+        // glyph boxes can be extended to the left and top afterwards
+        const int nOffset = _bSDF ? FONT_MGR_SDF_SPREAD : 0;
+        std::fill(*_ppAtlas, *_ppAtlas+_nAtlasSize*_nAtlasSize, 0u);
+        
         bPacked = true;
         stbtt_pack_context Context;
-        if (!stbtt_PackBegin(&Context, m_FontsMemAtlas[unIDTex],
-                             FONT_MGR_ATLAS_SIZE_DEFAULT*nAtlasScale,
-                             FONT_MGR_ATLAS_SIZE_DEFAULT*nAtlasScale, 0, 1, nullptr))
+        if (!stbtt_PackBegin(&Context, *_ppAtlas+nOffset*_nAtlasSize+nOffset,
+                             _nAtlasSize-2*nOffset, _nAtlasSize-2*nOffset,
+                             _nAtlasSize, nPadding, nullptr))
         {
             WARNING_MSG("Font Manager", "Could not initialise font.")
             bPacked = true;
         }
         
         stbtt_PackSetOversampling(&Context, 1, 1);
-        if (!stbtt_PackFontRange(&Context, reinterpret_cast<unsigned char*>(m_FontsMemByName[_strFontName]), 0,
-                                FONT_MGR_SCALE * float(_nSize),
-                                ASCII_FIRST, ASCII_NR, m_pFontCharInfo))
+        if (!stbtt_PackFontRange(&Context, reinterpret_cast<unsigned char*>(const_cast<char*>(_pFontMem)), 0,
+                                FONT_MGR_SCALE * float(nSize),
+                                ASCII_FIRST, ASCII_NR, _pCharInfo))
         {
             DEBUG_MSG("Font Manager", "Could not pack font, trying larger texture size.")
             nAtlasScale *= 2;
@@ -504,72 +1048,149 @@ void CFontManager::rasterize(const std::string& _strFontName, const int _nSize)
     if (nAtlasScale > 8 && !bPacked)
     {
         WARNING_MSG("Font Manager", "Could not pack font, try to reduce font size.")
-        
-//         if (m_FontsCharInfo[unIDTex] != nullptr)
-//         {
-//             delete m_FontsCharInfo[unIDTex];
-//             MEM_FREED("stbtt_packedchar")
-//             m_FontsCharInfo[unIDTex] = nullptr;
-//         }
-//         m_FontsCharInfo.erase(unIDTex);
-//         
-//         if (m_FontsMemAtlas[unIDTex] != nullptr)
-//         {
-//             delete m_FontsMemAtlas[unIDTex];
-//             MEM_FREED("std::uint8_t")
-//             m_FontsMemAtlas[unIDTex] = nullptr;
-//         }
-//         m_FontsMemAtlas.erase(unIDTex);
-//         m_FontsByName.erase(strFontDesignator);
-//         
-//         m_pFontCharInfo = pFontCharInfo;
+        return false;
     }
-    else
-    {
-        DEBUG_BLK(
-            for (auto i=0u; i < _nSize*3; ++i)
+    
+    DEBUG_BLK(
+        for (auto i=0; i < _nSize*3; ++i)
+        {
+            for (auto j=0; j < 60; ++j)
             {
-                for (auto j=0u; j < 60u; ++j)
-                {
-                    if (m_FontsMemAtlas[unIDTex][i*FONT_MGR_ATLAS_SIZE_DEFAULT*nAtlasScale+j] > 200)
-                        std::cout << "# ";
-                    else if (m_FontsMemAtlas[unIDTex][i*FONT_MGR_ATLAS_SIZE_DEFAULT*nAtlasScale+j] > 100)
-                        std::cout << "* ";
-                    else if (m_FontsMemAtlas[unIDTex][i*FONT_MGR_ATLAS_SIZE_DEFAULT*nAtlasScale+j] > 50)
-                        std::cout << ". ";
-                    else
-                        std::cout << "  ";
-                }
-                std::cout << std::endl;
+                if ((*_ppAtlas)[i*_nAtlasSize+j] > 200)
+                    std::cout << "# ";
+                else if ((*_ppAtlas)[i*_nAtlasSize+j] > 100)
+                    std::cout << "* ";
+                else if ((*_ppAtlas)[i*_nAtlasSize+j] > 50)
+                    std::cout << ". ";
+                else
+                    std::cout << "  ";
             }
-        )
-        
-        m_AtlasSizes[unIDTex] = FONT_MGR_ATLAS_SIZE_DEFAULT * nAtlasScale;
-        
-        //--------------------------------------------------------------------------
-        // Set GL parameters for font atlas texture
-        //--------------------------------------------------------------------------
-        glBindTexture(GL_TEXTURE_2D, unIDTex);
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-        glTexStorage2D(GL_TEXTURE_2D, 4, GL_RGBA8,
-                       FONT_MGR_ATLAS_SIZE_DEFAULT*nAtlasScale,
-                       FONT_MGR_ATLAS_SIZE_DEFAULT*nAtlasScale);
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0,
-                        FONT_MGR_ATLAS_SIZE_DEFAULT*nAtlasScale,
-                        FONT_MGR_ATLAS_SIZE_DEFAULT*nAtlasScale,
-                        GL_RED, GL_UNSIGNED_BYTE, m_FontsMemAtlas[unIDTex]);
-        
-        glHint(GL_GENERATE_MIPMAP_HINT, GL_NICEST);
-        glGenerateMipmap(GL_TEXTURE_2D);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            std::cout << std::endl;
+        }
+    )
+    
+    if (_bSDF)
+    {
+        this->computeDistanceField(*_ppAtlas, _nAtlasSize);
         
-        m_FontsIdleTime[unIDTex] = new CTimer;
-        MEM_ALLOC("CTimer")
-        m_FontsIdleTime[unIDTex]->start();
+        // Extend glyph quads by distance field range, since anti-aliased
+        // outlines are computed from the distance field beyond glyph box.
+        // Packing offset and extension to the left/top cancel out.
+        for (auto i=0; i < ASCII_NR; ++i)
+        {
+            _pCharInfo[i].x1 += 2*FONT_MGR_SDF_SPREAD;
+            _pCharInfo[i].y1 += 2*FONT_MGR_SDF_SPREAD;
+            _pCharInfo[i].xoff  -= FONT_MGR_SDF_SPREAD;
+            _pCharInfo[i].yoff  -= FONT_MGR_SDF_SPREAD;
+            _pCharInfo[i].xoff2 += FONT_MGR_SDF_SPREAD;
+            _pCharInfo[i].yoff2 += FONT_MGR_SDF_SPREAD;
+        }
     }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Prepares font atlas of given job in CPU memory
+///
+/// The atlas is taken from disk cache if available, otherwise it is packed
+/// and written to cache. Since only the job is accessed, this might be called
+/// by the worker thread.
+///
+/// \param _Job Font atlas job to prepare
+///
+////////////////////////////////////////////////////////////////////////////////
+void CFontManager::prepareAtlas(FontAtlasJob& _Job) const
+{
+    METHOD_ENTRY("CFontManager::prepareAtlas")
+    
+    if (_Job.pFontMem == nullptr)
+    {
+        if (!this->loadFontFile(_Job)) return;
+        _Job.pFontMem = _Job.pFontMemLoaded;
+    }
+    
+    _Job.pCharInfo = new stbtt_packedchar[ASCII_NR];
+    MEM_ALLOC("stbtt_packedchar")
+    
+    _Job.bSuccess = this->loadAtlasCache(_Job);
+    if (!_Job.bSuccess)
+    {
+        _Job.bSuccess = this->packAtlas(_Job.pFontMem, _Job.nSize, _Job.bSDF,
+                                        &_Job.pAtlas, _Job.pCharInfo, _Job.nAtlasSize);
+        if (_Job.bSuccess) this->saveAtlasCache(_Job);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Rasterizes font immediately
+///
+/// \param _strFontName Name of font to rasterize
+/// \param _nSize Size for rasterized font
+///
+////////////////////////////////////////////////////////////////////////////////
+void CFontManager::rasterize(const std::string& _strFontName, const int _nSize)
+{
+    METHOD_ENTRY("CFontManager::rasterize")
+    
+    DEBUG_MSG("Font manager", "Rasterising font " << _strFontName << ", Size: " << _nSize)
+    
+    FontAtlasJob Job;
+    this->initJob(Job, _strFontName, _nSize);
+    this->prepareAtlas(Job);
+    if (this->uploadAtlas(Job))
+    {
+        m_pFontCharInfo = m_FontsCharInfo[m_FontsByName[this->getDesignator(_strFontName, _nSize)]];
+    }
+    
+    DOM_VAR(DEBUG_BLK(
+        std::cout << "  Font memory: " << std::endl;
+        for (const auto Font : m_FontsByName)
+        {
+            std::cout << "  - " << Font.first << std::endl;
+        }
+    ))
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Writes font atlas and glyph metrics to disk cache
+///
+/// \param _Job Font atlas job, providing atlas and glyph metrics
+///
+/// \return Success?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool CFontManager::saveAtlasCache(const FontAtlasJob& _Job) const
+{
+    METHOD_ENTRY("CFontManager::saveAtlasCache")
+    
+    if (_Job.strCacheDir == "") return false;
+    
+    const std::string strFile = this->getAtlasCacheFile(_Job);
+    
+    FontAtlasCacheHeader Header;
+    Header.unHash = _Job.unHash;
+    Header.nSize = this->getAtlasFontSize(_Job);
+    Header.nSDF = int(_Job.bSDF);
+    Header.nNrOfChars = ASCII_NR;
+    Header.nAtlasSize = _Job.nAtlasSize;
+    
+    std::ofstream OutStream(strFile, std::ios::out|std::ios::binary|std::ios::trunc);
+    if (!OutStream.is_open())
+    {
+        DOM_FIO(WARNING_MSG("Font Manager", "Could not write font atlas cache " << strFile << "."))
+        return false;
+    }
+    OutStream.write(reinterpret_cast<const char*>(&Header), sizeof(FontAtlasCacheHeader));
+    OutStream.write(reinterpret_cast<const char*>(_Job.pCharInfo), sizeof(stbtt_packedchar) * ASCII_NR);
+    OutStream.write(reinterpret_cast<const char*>(_Job.pAtlas), std::size_t(_Job.nAtlasSize) * _Job.nAtlasSize);
+    OutStream.close();
+    
+    DOM_FIO(DEBUG_MSG("Font Manager", "Font atlas written to cache " << strFile))
+    
+    return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -601,6 +1222,8 @@ bool CFontManager::removeFont(const GLuint _unTexID)
         m_AtlasSizes.erase(it2);
     }
     else bSuccess = false;
+    m_AtlasFontSizes.erase(_unTexID);
+    m_AtlasGenerations.erase(_unTexID);
     
     auto it3 = m_FontsCharInfo.find(_unTexID);
     if (it3 != m_FontsCharInfo.end())
@@ -627,3 +1250,168 @@ bool CFontManager::removeFont(const GLuint _unTexID)
     return bSuccess;
 }
 
+#ifdef BFE_MULTITHREADING
+  ////////////////////////////////////////////////////////////////////////////////
+  ///
+  /// \brief Runs the font worker, called as a thread
+  ///
+  /// Queued jobs are prepared in CPU memory and handed over for upload by the
+  /// GL thread.
+  ///
+  ////////////////////////////////////////////////////////////////////////////////
+  void CFontManager::runWorker()
+  {
+      METHOD_ENTRY("CFontManager::runWorker")
+      
+      INFO_MSG("Font Manager", "Font worker started.")
+      
+      std::unique_lock<std::mutex> Lock(m_MutexJobs);
+      while (true)
+      {
+          m_CVJobs.wait(Lock, [this]{return !m_JobsQueued.empty() || !m_bWorkerRunning;});
+          if (!m_bWorkerRunning) break;
+          
+          FontAtlasJob Job = m_JobsQueued.front();
+          m_JobsQueued.pop_front();
+          
+          Lock.unlock();
+          this->prepareAtlas(Job);
+          Lock.lock();
+          
+          m_JobsDone.push_back(Job);
+          ++m_nJobsDone;
+      }
+      
+      INFO_MSG("Font Manager", "Font worker stopped.")
+  }
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Uploads prepared font atlas of given job to GL texture
+///
+/// Ownership of atlas, glyph metrics and loaded font data is taken over by
+/// font manager or freed.
+///
+/// \param _Job Prepared font atlas job
+///
+/// \return Success?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool CFontManager::uploadAtlas(FontAtlasJob& _Job)
+{
+    METHOD_ENTRY("CFontManager::uploadAtlas")
+    
+    // Register font data loaded by job, unless it was loaded meanwhile
+    if (_Job.pFontMemLoaded != nullptr)
+    {
+        if (m_FontsMemByName.find(_Job.strFontName) == m_FontsMemByName.end())
+        {
+            m_FontsMemByName[_Job.strFontName] = _Job.pFontMemLoaded;
+            m_FontsHashByName[_Job.strFontName] = _Job.unHash;
+        }
+        else
+        {
+            delete[] _Job.pFontMemLoaded;
+            MEM_FREED("char")
+        }
+        _Job.pFontMemLoaded = nullptr;
+    }
+    // Font file is no longer pending, even if loading failed. Hence, loading
+    // is retried when the font is preloaded with its file again.
+    if (!_Job.strFile.empty()) m_FontsFilePending.erase(_Job.strFontName);
+    
+    const std::string strFontDesignator = this->getDesignator(_Job.strFontName, _Job.nSize, _Job.bSDF);
+    
+    if (!_Job.bSuccess || m_FontsByName.find(strFontDesignator) != m_FontsByName.end())
+    {
+        if (!_Job.bSuccess)
+        {
+            WARNING_MSG("Font Manager", "Could not prepare font " << _Job.strFontName << ", Size: " << _Job.nSize)
+        }
+        if (_Job.pAtlas != nullptr)
+        {
+            delete[] _Job.pAtlas;
+            MEM_FREED("std::uint8_t")
+            _Job.pAtlas = nullptr;
+        }
+        if (_Job.pCharInfo != nullptr)
+        {
+            delete[] _Job.pCharInfo;
+            MEM_FREED("stbtt_packedchar")
+            _Job.pCharInfo = nullptr;
+        }
+        return _Job.bSuccess;
+    }
+    
+    GLuint unIDTex = 0u;
+    glGenTextures(1, &unIDTex);
+    m_FontsByName[strFontDesignator] = unIDTex;
+    m_FontsCharInfo[unIDTex] = _Job.pCharInfo;
+    m_FontsMemAtlas[unIDTex] = _Job.pAtlas;
+    m_AtlasSizes[unIDTex] = _Job.nAtlasSize;
+    m_AtlasFontSizes[unIDTex] = _Job.bSDF ? FONT_MGR_SDF_SIZE : _Job.nSize;
+    m_AtlasGenerations[unIDTex] = ++m_unAtlasGenerationLast;
+    _Job.pCharInfo = nullptr;
+    _Job.pAtlas = nullptr;
+    
+    //--------------------------------------------------------------------------
+    // Set GL parameters for font atlas texture
+    //--------------------------------------------------------------------------
+    glBindTexture(GL_TEXTURE_2D, unIDTex);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexStorage2D(GL_TEXTURE_2D, 4, GL_RGBA8, _Job.nAtlasSize, _Job.nAtlasSize);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _Job.nAtlasSize, _Job.nAtlasSize,
+                    GL_RED, GL_UNSIGNED_BYTE, m_FontsMemAtlas[unIDTex]);
+    
+    glHint(GL_GENERATE_MIPMAP_HINT, GL_NICEST);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    
+    m_FontsIdleTime[unIDTex] = new CTimer;
+    MEM_ALLOC("CTimer")
+    m_FontsIdleTime[unIDTex]->start();
+    
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Uploads fonts prepared by worker thread, to be called by GL thread
+///
+/// This is done automatically when drawing text. Without multithreading,
+/// fonts are rasterised immediately and there is nothing to upload.
+///
+////////////////////////////////////////////////////////////////////////////////
+void CFontManager::uploadPreparedFonts()
+{
+    METHOD_ENTRY("CFontManager::uploadPreparedFonts")
+    
+    #ifdef BFE_MULTITHREADING
+        if (m_nJobsDone == 0) return;
+        
+        std::deque<FontAtlasJob> JobsDone;
+        {
+            std::lock_guard<std::mutex> Lock(m_MutexJobs);
+            JobsDone.swap(m_JobsDone);
+            m_nJobsDone = 0;
+        }
+        
+        bool bUploaded = false;
+        for (auto& Job : JobsDone)
+        {
+            m_FontsPending.erase(this->getDesignator(Job.strFontName, Job.nSize, Job.bSDF));
+            bUploaded |= this->uploadAtlas(Job);
+        }
+        
+        // Upload changed texture binding, restore current font
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, m_unTexID);
+        
+        // Switch from previous atlas to requested font if it is ready
+        if (m_bFallback && bUploaded) m_bChanged = true;
+    #endif
+}
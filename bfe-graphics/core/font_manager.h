@@ -34,8 +34,18 @@
 #define GL_GLEXT_PROTOTYPES
 
 //--- Standard header --------------------------------------------------------//
+#include <cstdint>
+#include <deque>
+#include <unordered_set>
+#ifdef BFE_MULTITHREADING
+  #include <atomic>
+  #include <condition_variable>
+  #include <mutex>
+  #include <thread>
+#endif
 
 //--- Program header ---------------------------------------------------------//
+#include "conf_bfengine.h"
 #include "graphics.h"
 
 //--- Misc header ------------------------------------------------------------//
@@ -62,10 +72,75 @@ constexpr double FONT_MGR_MAX_IDLE_TIME_DEFAULT = 180.0;
 constexpr int FONT_MGR_NO_WORD_WRAP = -1;
 const std::string FONT_MGR_FONT_DEFAULT = "anka_c87_r";
 
+constexpr int FONT_MGR_SDF_SIZE = 32;           ///< Reference glyph size of signed distance field atlases
+constexpr int FONT_MGR_SDF_SPREAD = 4;          ///< Range (px) of distance field on each side of glyph outline
+const std::string FONT_MGR_SDF_PREFIX = "sdf_"; ///< Designator prefix of signed distance field atlases
+
+constexpr std::uint32_t FONT_MGR_CACHE_MAGIC = 0x53544146u; ///< Magic number of font atlas cache files ("FATS")
+constexpr std::uint32_t FONT_MGR_CACHE_VERSION = 1u;        ///< Version of font atlas cache file format
+
+// Structure of font atlas cache file header. It is followed by glyph metrics
+// (stbtt_packedchar) and atlas data.
+struct FontAtlasCacheHeader
+{
+    std::uint32_t unMagic = FONT_MGR_CACHE_MAGIC;     ///< Magic number, identifying cache files
+    std::uint32_t unVersion = FONT_MGR_CACHE_VERSION; ///< Version of file format
+    std::uint64_t unHash = 0u;                        ///< Hash of font file
+    std::int32_t  nSize = 0;                          ///< Font size of atlas (see \ref getAtlasFontSize)
+    std::int32_t  nSDF = 0;                           ///< Signed distance field atlas?
+    std::int32_t  nNrOfChars = 0;                     ///< Number of glyphs
+    std::int32_t  nAtlasSize = 0;                     ///< Size of atlas (both dimensions)
+};
+
+// Structure describing the preparation of one font atlas. All input is copied,
+// hence, preparation is independent of font manager state and might be done
+// by the font worker thread.
+struct FontAtlasJob
+{
+    std::string         strFontName = "";           ///< Name of font
+    std::string         strFile = "";               ///< Font file, if font data still has to be loaded
+    std::string         strCacheDir = "";           ///< Directory of font atlas cache, empty if disabled
+    const char*         pFontMem = nullptr;         ///< Truetype font data, if already loaded
+    char*               pFontMemLoaded = nullptr;   ///< Truetype font data, loaded by this job
+    std::uint64_t       unHash = 0u;                ///< Hash of font file
+    int                 nSize = 0;                  ///< Font size
+    bool                bSDF = false;               ///< Signed distance field atlas?
+    std::uint8_t*       pAtlas = nullptr;           ///< Prepared atlas
+    stbtt_packedchar*   pCharInfo = nullptr;        ///< Prepared glyph metrics
+    int                 nAtlasSize = 0;             ///< Size of prepared atlas
+    bool                bSuccess = false;           ///< Preparation successful?
+};
+
+// Structure containing a cached text layout, i.e. glyph quads relative to
+// text origin. Layouts are valid for the atlas they were created with. If a
+// previous atlas was used until the font was ready, the layout is recreated
+// when drawn.
+struct TextLayout
+{
+    std::vector<GLfloat> Quads;                             ///< Glyph quads, lower left and upper right corner (x0,y0,x1,y1) per glyph
+    std::vector<GLfloat> UVs;                               ///< Texture coordinates, 8 per glyph
+    std::string          strText = "";                      ///< Text the layout was created for
+    std::string          strFont = "";                      ///< Font the layout was created with
+    int                  nSize = 0;                         ///< Font size the layout was created with
+    int                  nWrap = FONT_MGR_NO_WORD_WRAP;     ///< Word wrap position the layout was created with
+    int                  nLines = 1;                        ///< Number of lines, including line feeds and word wraps
+    std::uint32_t        unAtlasGeneration = 0u;            ///< Generation of atlas the layout was created with
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Class for loading, rasterizing and rendering fonts
 ///
+/// Fonts are either rasterized as bitmap atlas per font and size, or, in
+/// signed distance field (SDF) mode, as one distance field atlas per font,
+/// which is scaled to all sizes. For SDF mode, the render mode registered for
+/// fonts has to use the SDF shader (shader/font_sdf.vert, font_sdf.frag).
+///
+/// With multithreading enabled, loading and rasterising is done by a worker
+/// thread, only the texture upload is done by the GL thread. Until a font is
+/// ready, text is drawn with the previous font atlas, scaled to the requested
+/// size. Fonts can be warmed up beforehand, using \ref preloadFont.
+///
 ////////////////////////////////////////////////////////////////////////////////
 class CFontManager : public CGraphicsBase
 {
@@ -76,12 +151,24 @@ class CFontManager : public CGraphicsBase
         CFontManager() :    m_pFontCharInfo(nullptr),
                             m_strFont(""),
                             m_strRenderModeName("font"),
+                            m_strCacheDir(""),
                             m_nAtlasSize(FONT_MGR_ATLAS_SIZE_DEFAULT),
                             m_nSize(FONT_MGR_SIZE_DEFAULT),
                             m_unTexID(0u),
+                            m_unAtlasGeneration(0u),
+                            m_unAtlasGenerationLast(0u),
                             m_bChanged(false),
+                            m_bFallback(false),
+                            m_bSDF(false),
+                            m_fScale(1.0f),
                             m_fLastPosX(0.0),
-                            m_fLastPosY(0.0){}
+                            m_fLastPosY(0.0)
+        {
+            #ifdef BFE_MULTITHREADING
+              m_nJobsDone = 0;
+              m_bWorkerRunning = false;
+            #endif
+        }
         ~CFontManager();
 
         //--- Constant Methods -----------------------------------------------//
@@ -90,17 +177,25 @@ class CFontManager : public CGraphicsBase
         {
             return &m_FontsIdleTime;
         }
+        bool isSDF() const {return m_bSDF;}
         
         //--- Methods --------------------------------------------------------//
         bool    addFont(const std::string&, const std::string&, const int = FONT_MGR_SIZE_DEFAULT);
+        bool    preloadFont(const std::string&, const int = FONT_MGR_SIZE_DEFAULT);
+        bool    preloadFont(const std::string&, const std::string&, const int = FONT_MGR_SIZE_DEFAULT);
         void    drawText(const std::string&, const bool = false, const int = FONT_MGR_NO_WORD_WRAP);
         void    drawText(const std::string&, const float&, const float&, const bool = false, const int = FONT_MGR_NO_WORD_WRAP);
+        void    drawText(TextLayout&, const float&, const float&);
         GLuint  getIDTex(const std::string&);
         float   getTextLength(const std::string&, const std::string&, const int);
+        void    layoutText(const std::string&, TextLayout&, const int = FONT_MGR_NO_WORD_WRAP);
         bool    setFont(const std::string&);
+        void    setCacheDirectory(const std::string&);
         void    setRenderModeName(const std::string& _strName) {m_strRenderModeName = _strName;}
+        void    setSDF(const bool);
         void    setSize(const int);
         void    triggerMaintenance();
+        void    uploadPreparedFonts();
                 
         //--- friends --------------------------------------------------------//
 
@@ -108,25 +203,63 @@ class CFontManager : public CGraphicsBase
         
         //--- Methods [private] ----------------------------------------------//
         void    changeFont();
+        void    computeDistanceField(std::uint8_t* const, const int) const;
+        const std::string getAtlasCacheFile(const FontAtlasJob&) const;
+        int     getAtlasFontSize(const FontAtlasJob&) const;
+        const std::string getDesignator(const std::string&, const int) const;
+        const std::string getDesignator(const std::string&, const int, const bool) const;
+        void    initJob(FontAtlasJob&, const std::string&, const int) const;
+        bool    loadAtlasCache(FontAtlasJob&) const;
+        bool    loadFontFile(FontAtlasJob&) const;
+        bool    packAtlas(const char* const, const int, const bool, std::uint8_t** const,
+                          stbtt_packedchar* const, int&) const;
+        void    prepareAtlas(FontAtlasJob&) const;
         void    rasterize(const std::string&, const int);
+        bool    saveAtlasCache(const FontAtlasJob&) const;
         bool    removeFont(const GLuint);
+        bool    uploadAtlas(FontAtlasJob&);
+        
+        #ifdef BFE_MULTITHREADING
+          void  runWorker();
+        #endif
         
         //--- Variables [private] --------------------------------------------//
         std::unordered_map<std::string, GLuint>         m_FontsByName;      ///< Fonts GL IDs accessed by name
         std::unordered_map<GLuint, bfe::CTimer*>        m_FontsIdleTime;    ///< Time that a font hasn't been used
         std::unordered_map<std::string, char*>          m_FontsMemByName;   ///< Fonts stored in memory after loading
+        std::unordered_map<std::string, std::uint64_t>  m_FontsHashByName;  ///< Hash of font files, key for atlas cache
         std::unordered_map<GLuint, std::uint8_t*>       m_FontsMemAtlas;    ///< Memory of font atlas texture
         std::unordered_map<GLuint, int>                 m_AtlasSizes;       ///< Size of font atlases
+        std::unordered_map<GLuint, int>                 m_AtlasFontSizes;   ///< Glyph size atlases were rasterised with
+        std::unordered_map<GLuint, std::uint32_t>       m_AtlasGenerations; ///< Generation of atlases, unique even if texture IDs are reused
+        std::unordered_map<std::string, std::string>    m_FontsFilePending; ///< Files of fonts that are still loaded by worker
+        std::unordered_set<std::string>                 m_FontsPending;     ///< Designators of fonts that are still prepared by worker
         std::unordered_map<GLuint, stbtt_packedchar*>   m_FontsCharInfo;    ///< Font information like kerning
         stbtt_packedchar*                               m_pFontCharInfo;    ///< Char info of current font
         std::string                                     m_strFont;          ///< Current font
         std::string                                     m_strRenderModeName;///< Name of registered render mode for fonts
+        std::string                                     m_strCacheDir;      ///< Directory of font atlas cache, empty if disabled
         int                                             m_nAtlasSize;       ///< Current Atlas size
         int                                             m_nSize;            ///< Current font size
         GLuint                                          m_unTexID;          ///< Current texture
+        std::uint32_t                                   m_unAtlasGeneration;    ///< Generation of current atlas
+        std::uint32_t                                   m_unAtlasGenerationLast;///< Generation of last uploaded atlas
         bool                                            m_bChanged;         ///< Indicates, if current font was changed
+        bool                                            m_bFallback;        ///< Indicates, if previous atlas is used until font is ready
+        bool                                            m_bSDF;             ///< Indicates, if signed distance field atlases are used
+        float                                           m_fScale;           ///< Scale from atlas glyph size to current font size
         float                                           m_fLastPosX;        ///< Last position, x coordinate
         float                                           m_fLastPosY;        ///< Last position, x coordinate
+        
+        #ifdef BFE_MULTITHREADING
+          std::thread                                   m_Worker;           ///< Worker thread, loading and rasterising fonts
+          std::mutex                                    m_MutexJobs;        ///< Mutex, guarding job queues
+          std::condition_variable                       m_CVJobs;           ///< Notifies worker of queued jobs
+          std::deque<FontAtlasJob>                      m_JobsQueued;       ///< Jobs waiting for worker
+          std::deque<FontAtlasJob>                      m_JobsDone;         ///< Jobs prepared by worker, waiting for upload
+          std::atomic<int>                              m_nJobsDone;        ///< Number of jobs waiting for upload
+          bool                                          m_bWorkerRunning;   ///< Indicates, if worker thread is running
+        #endif
 };
 
 //--- Implementation is done here for inline optimisation --------------------//
@@ -169,6 +302,82 @@ inline GLuint CFontManager::getIDTex(const std::string& _strFont)
     return m_FontsByName[_strFont];
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns the font size an atlas is rasterized with
+///
+/// Distance field atlases are rasterized with a fixed size, independent of
+/// the requested size.
+///
+/// \param _Job Font atlas job, providing size and atlas type
+///
+/// \return Font size of atlas
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CFontManager::getAtlasFontSize(const FontAtlasJob& _Job) const
+{
+    METHOD_ENTRY("CFontManager::getAtlasFontSize")
+    return _Job.bSDF ? FONT_MGR_SDF_SIZE : _Job.nSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns the designator of a rasterized font
+///
+/// Bitmap atlases are stored per font and size, distance field atlases only
+/// per font.
+///
+/// \param _strFont Name of font
+/// \param _nSize   Font size
+///
+/// \return Designator, e.g. used as key for font texture ids
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const std::string CFontManager::getDesignator(const std::string& _strFont, const int _nSize) const
+{
+    METHOD_ENTRY("CFontManager::getDesignator")
+    return this->getDesignator(_strFont, _nSize, m_bSDF);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns the designator of a rasterized font for given atlas type
+///
+/// \param _strFont Name of font
+/// \param _nSize   Font size
+/// \param _bSDF    Signed distance field atlas?
+///
+/// \return Designator, e.g. used as key for font texture ids
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const std::string CFontManager::getDesignator(const std::string& _strFont,
+                                                     const int _nSize,
+                                                     const bool _bSDF) const
+{
+    METHOD_ENTRY("CFontManager::getDesignator")
+    if (_bSDF)
+        return FONT_MGR_SDF_PREFIX+_strFont;
+    else
+        return std::to_string(_nSize)+_strFont;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Switches between bitmap and signed distance field atlases
+///
+/// \param _bSDF Use signed distance field atlases?
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CFontManager::setSDF(const bool _bSDF)
+{
+    METHOD_ENTRY("CFontManager::setSDF")
+    if (_bSDF != m_bSDF)
+    {
+        m_bSDF      = _bSDF;
+        m_bChanged  = true;
+    }
+}
+
 } // namespace bfe
 
 #endif // FONT_MANAGER_H
@@ -36,6 +36,11 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#ifdef BFE_HEADLESS
+    #include <EGL/egl.h>
+    #include <EGL/eglext.h>
+#endif
+
 using namespace bfe;
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -53,11 +58,15 @@ CGraphics::CGraphics() : m_pWindow(nullptr),
                         m_nPoints(0),
                         m_nTriangles(0),
                         m_nVerts(0),
+                        m_nUploadBytes(0),
+                        m_fSubmitTime(0.0),
+                        m_StatsFrameTime("Frame time", "s"),
+                        m_StatsSubmitTime("Render submit", "s"),
+                        m_StatsUploadBytes("Upload", "B"),
+                        m_StatsVerts("Vertices", ""),
                         m_aColour({{1.0, 1.0, 1.0, 1.0}}),
                         m_pRenderMode(nullptr),
                         m_RenderModeType(RenderModeType::VERT3COL4),
-                        m_fCamAng(0.0),
-                        m_fCamZoom(1.0),
                         m_fDepth(GRAPHICS_DEPTH_DEFAULT),
                         m_nVideoFlags(0),
                         m_unWidthScr(GRAPHICS_WIDTH_DEFAULT),
@@ -66,7 +75,7 @@ CGraphics::CGraphics() : m_pWindow(nullptr),
     METHOD_ENTRY("CGraphics::CGraphics")
     CTOR_CALL("CGraphics::CGraphics")
     
-    m_vecCamPos.setZero();
+    this->resetCam();
     m_CosCache.resize(GRAPHICS_MAX_CACHE_SIZE);
     m_SinCache.resize(GRAPHICS_MAX_CACHE_SIZE);
     m_vecIndicesLines.resize(m_unIndexMax);
@@ -91,6 +100,21 @@ CGraphics::~CGraphics()
 {
     METHOD_ENTRY("CGraphics::CGraphics")
     DTOR_CALL("CGraphics::CGraphics")
+    
+    for (auto& GPUTime : m_StatsGPUTimes)
+    {
+        delete GPUTime.second;
+        MEM_FREED("CFrameStats")
+    }
+    
+    #ifdef BFE_HEADLESS
+        if (m_pEGLDisplay != nullptr)
+        {
+            eglMakeCurrent(m_pEGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            eglDestroyContext(m_pEGLDisplay, m_pEGLContext);
+            eglTerminate(m_pEGLDisplay);
+        }
+    #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -102,9 +126,9 @@ CGraphics::~CGraphics()
 /// \return Position in world coordinates
 ///
 ///////////////////////////////////////////////////////////////////////////////
-Vector2d CGraphics::screen2World(const Vector2d& _vecV) const
+Vector2d CRenderPacket::screen2World(const Vector2d& _vecV) const
 {
-    METHOD_ENTRY("CGraphics::screen2World")
+    METHOD_ENTRY("CRenderPacket::screen2World")
 
     Vector2d vecResult;
     
@@ -114,15 +138,15 @@ Vector2d CGraphics::screen2World(const Vector2d& _vecV) const
     double fY;
         
     fX = ((m_ViewPort.rightplane-m_ViewPort.leftplane) / m_unWidthScr * _vecV[0]+
-                    m_ViewPort.leftplane) / m_fCamZoom;
+                    m_ViewPort.leftplane) / m_Cam.fZoom;
     fY = ((m_ViewPort.topplane-m_ViewPort.bottomplane) / m_unHeightScr * _vecV[1]+
-                    m_ViewPort.bottomplane) /  m_fCamZoom;
+                    m_ViewPort.bottomplane) /  m_Cam.fZoom;
     
     fL = sqrt(fX*fX+fY*fY);
     fAtan = atan2(fX,fY);
     
-    vecResult[0] = fL*cos(fAtan - (MATH_PI2-m_fCamAng))+ m_vecCamPos[0];
-    vecResult[1] = fL*sin(fAtan - (MATH_PI2-m_fCamAng))- m_vecCamPos[1];
+    vecResult[0] = fL*cos(fAtan - (MATH_PI2-m_Cam.fAng))+ m_Cam.vecPos[0];
+    vecResult[1] = fL*sin(fAtan - (MATH_PI2-m_Cam.fAng))- m_Cam.vecPos[1];
 
     return vecResult;
 }
@@ -137,9 +161,9 @@ Vector2d CGraphics::screen2World(const Vector2d& _vecV) const
 /// \return Position in world coordinates
 ///
 ///////////////////////////////////////////////////////////////////////////////
-Vector2d CGraphics::screen2World(const double& _fX, const double& _fY) const
+Vector2d CRenderPacket::screen2World(const double& _fX, const double& _fY) const
 {
-    METHOD_ENTRY("CGraphics::screen2World")
+    METHOD_ENTRY("CRenderPacket::screen2World")
 
     Vector2d vecResult;
     
@@ -149,15 +173,15 @@ Vector2d CGraphics::screen2World(const double& _fX, const double& _fY) const
     double fY;
         
     fX = ((m_ViewPort.rightplane-m_ViewPort.leftplane) / m_unWidthScr * _fX +
-           m_ViewPort.leftplane) / m_fCamZoom;
+           m_ViewPort.leftplane) / m_Cam.fZoom;
     fY = ((m_ViewPort.topplane-m_ViewPort.bottomplane) / m_unHeightScr * _fY +
-           m_ViewPort.bottomplane) /  m_fCamZoom;
+           m_ViewPort.bottomplane) /  m_Cam.fZoom;
     
     fL = sqrt(fX*fX+fY*fY);
     fAtan = atan2(fX,fY);
     
-    vecResult[0] = fL*cos(fAtan - (MATH_PI2-m_fCamAng))+ m_vecCamPos[0];
-    vecResult[1] = fL*sin(fAtan - (MATH_PI2-m_fCamAng))- m_vecCamPos[1];
+    vecResult[0] = fL*cos(fAtan - (MATH_PI2-m_Cam.fAng))+ m_Cam.vecPos[0];
+    vecResult[1] = fL*sin(fAtan - (MATH_PI2-m_Cam.fAng))- m_Cam.vecPos[1];
 
     return vecResult;
 }
@@ -171,16 +195,37 @@ Vector2d CGraphics::screen2World(const double& _fX, const double& _fY) const
 /// \return Position in screen coordinates
 ///
 ///////////////////////////////////////////////////////////////////////////////
-Vector2d CGraphics::world2Screen(const Vector2d& _vecV) const
+Vector2d CRenderPacket::world2Screen(const Vector2d& _vecV) const
 {
-    METHOD_ENTRY("CGraphics::world2Screen")
+    METHOD_ENTRY("CRenderPacket::world2Screen")
 
-    Rotation2Dd Rot(m_fCamAng);
+    Rotation2Dd Rot(m_Cam.fAng);
     
-    return (Rot*Vector2d(_vecV[0],-_vecV[1])*m_fCamZoom-Vector2d(m_ViewPort.leftplane,-m_ViewPort.topplane))
+    return (Rot*Vector2d(_vecV[0],-_vecV[1])*m_Cam.fZoom-Vector2d(m_ViewPort.leftplane,-m_ViewPort.topplane))
             *m_unWidthScr/(m_ViewPort.rightplane-m_ViewPort.leftplane);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets screen size, adjusting viewport like \ref CGraphics::resizeViewport
+///
+/// \param _unWidthScr Screen width
+/// \param _unHeightScr Screen height
+///
+///////////////////////////////////////////////////////////////////////////////
+void CRenderPacket::setScreen(const unsigned short _unWidthScr, const unsigned short _unHeightScr)
+{
+    METHOD_ENTRY("CRenderPacket::setScreen")
+
+    m_unWidthScr = _unWidthScr;
+    m_unHeightScr = _unHeightScr;
+    
+    m_ViewPort.rightplane = double(_unWidthScr  * (0.5 / GRAPHICS_PX_PER_METER));
+    m_ViewPort.topplane   = double(_unHeightScr * (0.5 / GRAPHICS_PX_PER_METER));
+    m_ViewPort.leftplane   = -m_ViewPort.rightplane;
+    m_ViewPort.bottomplane = -m_ViewPort.topplane;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Cache sine and cosine values for circle calculations
@@ -232,6 +277,29 @@ void CGraphics::setupScreenSpace()
                                         m_ViewPort.nearplane, m_ViewPort.farplane);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets projection matrix to a rectangular region of screen space
+///
+/// This is used when rendering screen space elements, e.g. windows, to an
+/// offscreen target of the region's size. Coordinates stay screen related,
+/// hence, elements can be drawn at their usual position.
+///
+/// \param _nX Left border of region (screen space)
+/// \param _nY Top border of region (screen space)
+/// \param _nW Width of region
+/// \param _nH Height of region
+///
+///////////////////////////////////////////////////////////////////////////////
+void CGraphics::setupScreenSpace(const int _nX, const int _nY, const int _nW, const int _nH)
+{
+    METHOD_ENTRY("CGraphics::setupScreenSpace")
+
+    m_bScreenSpace = true;
+    m_matProjection = glm::ortho<float>(_nX, _nX+_nW, _nY+_nH, _nY,
+                                        m_ViewPort.nearplane, m_ViewPort.farplane);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Sets projection matrix to screen space 
@@ -258,7 +326,19 @@ void CGraphics::swapBuffers()
 {
     METHOD_ENTRY("CGraphics::swapBuffers")
     
-    m_pWindow->display();
+    // Without window, wait for completion to make frame times comparable
+    if (m_bHeadless)
+        glFinish();
+    else
+        m_pWindow->display();
+    
+    // Add debug information of this frame to history
+    m_FrameTimer.restart();
+    m_StatsFrameTime.addSample(m_FrameTimer.getTime());
+    m_StatsSubmitTime.addSample(m_fSubmitTime);
+    m_StatsUploadBytes.addSample(m_nUploadBytes);
+    m_StatsVerts.addSample(m_nVerts);
+    if (m_bGPUTimer) this->readGPUTimers();
    
     // Reset debug information of this frame
     m_nDrawCalls = 0;
@@ -266,11 +346,109 @@ void CGraphics::swapBuffers()
     m_nPoints = 0;
     m_nTriangles = 0;
     m_nVerts = 0;
+    m_nUploadBytes = 0;
+    m_fSubmitTime = 0.0;
+    
+    // The next frame is drawn from the latest render packet
+    m_RenderPackets.update();
     
     // clear offscreen buffers
     glClear(GL_DEPTH_BUFFER_BIT|GL_COLOR_BUFFER_BIT);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Starts GPU time measurement of a render batch or pass
+///
+/// A timestamp query is issued. Measurements might be nested, e.g. render
+/// batches within a render target pass, and are finished by \ref endGPUTimer.
+///
+/// \param _strName Name of render mode or pass
+///
+///////////////////////////////////////////////////////////////////////////////
+void CGraphics::beginGPUTimer(const std::string& _strName)
+{
+    METHOD_ENTRY("CGraphics::beginGPUTimer")
+    
+    if (!m_bGPUTimer) return;
+    
+    GPUTimerQueryType Query;
+    Query.unStart = this->acquireGPUTimerQuery();
+    Query.unEnd = this->acquireGPUTimerQuery();
+    Query.strName = _strName;
+    glQueryCounter(Query.unStart, GL_TIMESTAMP);
+    
+    m_GPUTimerQueriesOpen.push_back(std::move(Query));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Finishes last started GPU time measurement
+///
+/// The query is read back asynchronously, GRAPHICS_GPU_TIMER_LATENCY frames
+/// later, to avoid stalls.
+///
+///////////////////////////////////////////////////////////////////////////////
+void CGraphics::endGPUTimer()
+{
+    METHOD_ENTRY("CGraphics::endGPUTimer")
+    
+    if (m_GPUTimerQueriesOpen.empty()) return;
+    
+    glQueryCounter(m_GPUTimerQueriesOpen.back().unEnd, GL_TIMESTAMP);
+    
+    m_GPUTimerQueries[m_nGPUTimerFrame].push_back(std::move(m_GPUTimerQueriesOpen.back()));
+    m_GPUTimerQueriesOpen.pop_back();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Enables or disables GPU time measurement using timer queries
+///
+/// \param _bGPUTimer Measure GPU time?
+///
+/// \return Success? Fails, if timestamp queries are not supported.
+///
+///////////////////////////////////////////////////////////////////////////////
+bool CGraphics::setGPUTimer(const bool _bGPUTimer)
+{
+    METHOD_ENTRY("CGraphics::setGPUTimer")
+    
+    if (_bGPUTimer)
+    {
+        GLint nBits = 0;
+        glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &nBits);
+        if (nBits == 0)
+        {
+            WARNING_MSG("Graphics", "Timestamp queries not supported, GPU timer not available.")
+            m_bGPUTimer = false;
+            return false;
+        }
+        INFO_MSG("Graphics", "GPU timer enabled, " << nBits << " bit timestamps.")
+    }
+    else
+    {
+        // Drop pending measurements, query objects are reused
+        for (auto& Queries : m_GPUTimerQueries)
+        {
+            for (const auto& Query : Queries)
+            {
+                m_GPUTimerQueryPool.push_back(Query.unStart);
+                m_GPUTimerQueryPool.push_back(Query.unEnd);
+            }
+            Queries.clear();
+        }
+        for (const auto& Query : m_GPUTimerQueriesOpen)
+        {
+            m_GPUTimerQueryPool.push_back(Query.unStart);
+            m_GPUTimerQueryPool.push_back(Query.unEnd);
+        }
+        m_GPUTimerQueriesOpen.clear();
+    }
+    m_bGPUTimer = _bGPUTimer;
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Begin processing of one batch of GL objects
@@ -460,6 +638,9 @@ void CGraphics::endRenderBatch(const bool _bForce)
         
     if (bEnd)
     {
+        m_SubmitTimer.start();
+        if (m_bGPUTimer) this->beginGPUTimer(m_pRenderMode);
+        
         glBindVertexArray(m_unVAO);
         
         glBindBuffer(GL_ARRAY_BUFFER, m_unVBO);
@@ -485,6 +666,7 @@ void CGraphics::endRenderBatch(const bool _bForce)
                 glDrawElements(GL_TRIANGLES, m_vecIndicesTriangles.size(), GL_UNSIGNED_INT, 0);
                 
                 m_nDrawCalls += 3;
+                m_nUploadBytes += (m_unIndexLines+m_unIndexPoints+m_unIndexTriangles)*sizeof(GLuint);
                 
                 break;
             }
@@ -498,6 +680,7 @@ void CGraphics::endRenderBatch(const bool _bForce)
                 glDrawElements(GL_TRIANGLES, m_vecIndicesTriangles.size(), GL_UNSIGNED_INT, 0);
                 
                 ++m_nDrawCalls;
+                m_nUploadBytes += m_unIndexUV0*sizeof(GLfloat) + m_unIndexTriangles*sizeof(GLuint);
                 
                 break;
             }
@@ -513,6 +696,7 @@ void CGraphics::endRenderBatch(const bool _bForce)
                 glDrawElements(GL_TRIANGLES, m_vecIndicesTriangles.size(), GL_UNSIGNED_INT, 0);
                 
                 ++m_nDrawCalls;
+                m_nUploadBytes += (m_unIndexUV0+m_unIndexUV1)*sizeof(GLfloat) + m_unIndexTriangles*sizeof(GLuint);
                 
                 break;
             }
@@ -523,6 +707,11 @@ void CGraphics::endRenderBatch(const bool _bForce)
         m_nPoints    += m_unIndexPoints;
         m_nTriangles += m_unIndexTriangles;
         m_nVerts     += m_unIndexVerts;
+        m_nUploadBytes += (m_unIndexVerts+m_unIndexCol)*sizeof(GLfloat);
+        
+        if (m_bGPUTimer) this->endGPUTimer();
+        m_SubmitTimer.stop();
+        m_fSubmitTime += m_SubmitTimer.getTime();
         
         // If render mode changed, beginRenderBatch wrt top of stack
         if (bBegin)
@@ -615,6 +804,108 @@ bool CGraphics::init()
     DOM_VAR(INFO_MSG("Graphics", "Stencil Buffer Bits: " << m_pWindow->getSettings().stencilBits))
     DOM_VAR(INFO_MSG("Graphics", "Core Profile (1): " << m_pWindow->getSettings().attributeFlags))
     
+    this->initGL();
+    
+    return (true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Initializes graphics without window, using an offscreen context
+///
+/// An EGL context without any surface is created, preferably on Mesa's
+/// surfaceless platform, which also works with the software rasterizer.
+/// Rendering is done to an offscreen framebuffer representing the screen.
+///
+/// \param _unWidthScr Width of offscreen framebuffer
+/// \param _unHeightScr Height of offscreen framebuffer
+///
+/// \return Success
+///
+///////////////////////////////////////////////////////////////////////////////
+bool CGraphics::initHeadless(const unsigned short _unWidthScr, const unsigned short _unHeightScr)
+{
+    METHOD_ENTRY("CGraphics::initHeadless")
+    
+    #ifdef BFE_HEADLESS
+        //--------------------------------------------------------------------------
+        // Create offscreen context
+        //--------------------------------------------------------------------------
+        EGLDisplay Display = EGL_NO_DISPLAY;
+        auto pGetPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+                                   eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (pGetPlatformDisplay != nullptr)
+        {
+            Display = pGetPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        }
+        if (Display == EGL_NO_DISPLAY) Display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        
+        EGLint nMajor = 0;
+        EGLint nMinor = 0;
+        if (Display == EGL_NO_DISPLAY || !eglInitialize(Display, &nMajor, &nMinor))
+        {
+            ERROR_MSG("Graphics", "Could not initialise EGL display for headless mode.")
+            return false;
+        }
+        
+        const EGLint aConfigAttribs[] = {EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+                                         EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                                         EGL_NONE};
+        EGLConfig Config;
+        EGLint nNrOfConfigs = 0;
+        if (!eglChooseConfig(Display, aConfigAttribs, &Config, 1, &nNrOfConfigs) || nNrOfConfigs == 0)
+        {
+            ERROR_MSG("Graphics", "No EGL config for OpenGL found.")
+            eglTerminate(Display);
+            return false;
+        }
+        
+        eglBindAPI(EGL_OPENGL_API);
+        const EGLint aContextAttribs[] = {EGL_CONTEXT_MAJOR_VERSION, 3,
+                                          EGL_CONTEXT_MINOR_VERSION, 3,
+                                          EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                                          EGL_NONE};
+        EGLContext Context = eglCreateContext(Display, Config, EGL_NO_CONTEXT, aContextAttribs);
+        if (Context == EGL_NO_CONTEXT ||
+            !eglMakeCurrent(Display, EGL_NO_SURFACE, EGL_NO_SURFACE, Context))
+        {
+            ERROR_MSG("Graphics", "Could not create surfaceless EGL context.")
+            if (Context != EGL_NO_CONTEXT) eglDestroyContext(Display, Context);
+            eglTerminate(Display);
+            return false;
+        }
+        m_pEGLDisplay = Display;
+        m_pEGLContext = Context;
+        m_bHeadless = true;
+        
+        DOM_VAR(INFO_MSG("Graphics", "Headless mode, EGL version: " << nMajor << "." << nMinor))
+        DOM_VAR(INFO_MSG("Graphics", "Renderer: " << glGetString(GL_RENDERER)))
+        DOM_VAR(INFO_MSG("Graphics", "Found OpenGL version: " << glGetString(GL_VERSION)))
+        
+        //--------------------------------------------------------------------------
+        // Create offscreen framebuffer, replacing the window
+        //--------------------------------------------------------------------------
+        if (!this->resizeWindow(_unWidthScr, _unHeightScr)) return false;
+        
+        this->initGL();
+        
+        return true;
+    #else
+        ERROR_MSG("Graphics", "Headless mode not available, compile with BFE_HEADLESS. " <<
+                              "Size " << _unWidthScr << "x" << _unHeightScr << " ignored.")
+        return false;
+    #endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Initializes OpenGL state and buffers, independent of window
+///
+///////////////////////////////////////////////////////////////////////////////
+void CGraphics::initGL()
+{
+    METHOD_ENTRY("CGraphics::initGL")
+    
     //--------------------------------------------------------------------------
     // Setup OpenGL variables
     //--------------------------------------------------------------------------
@@ -678,8 +969,6 @@ bool CGraphics::init()
     {
         NOTICE_MSG("Graphics", "No render modes registered, be sure to do so before continuing.")
     }
-    
-    return (true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -729,7 +1018,30 @@ bool CGraphics::resizeWindow(unsigned short _unWidthScr, unsigned short _unHeigh
 
     this->resizeViewport(_unWidthScr, _unHeightScr);
     
-    m_pWindow->setSize(sf::Vector2u(_unWidthScr, _unHeightScr));
+    if (m_bHeadless)
+    {
+        // Recreate offscreen framebuffer for new size
+        glDeleteRenderbuffers(1, &m_unRBOScreen);
+        glDeleteFramebuffers(1, &m_unFBOScreen);
+        
+        glGenFramebuffers(1, &m_unFBOScreen);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_unFBOScreen);
+        glGenRenderbuffers(1, &m_unRBOScreen);
+        glBindRenderbuffer(GL_RENDERBUFFER, m_unRBOScreen);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, _unWidthScr, _unHeightScr);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_unRBOScreen);
+        
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            ERROR_MSG("Graphics", "Failed to create offscreen framebuffer")
+            return false;
+        }
+        glViewport(0, 0, _unWidthScr, _unHeightScr);
+    }
+    else
+    {
+        m_pWindow->setSize(sf::Vector2u(_unWidthScr, _unHeightScr));
+    }
     
     INFO_MSG("Graphics", "Window resized to " << _unWidthScr << "x" << _unHeightScr << ").")
     return (true);
@@ -750,6 +1062,8 @@ void CGraphics::applyCamMovement()
 {
     METHOD_ENTRY("CGraphics::applyCamMovement")
 
+    const GraphicsCamStateType& Cam = m_RenderPackets.getReadBuffer().getCam();
+
     if (m_bScreenSpace)
     {
         m_matTransform = m_matProjection;
@@ -758,8 +1072,8 @@ void CGraphics::applyCamMovement()
     {
         glm::mat4  matScaledAndRotated;
         glm::mat4  matScaled;
-        matScaled = glm::scale(m_matProjection, glm::vec3(GLfloat(m_fCamZoom), GLfloat(m_fCamZoom), 1.0f));
-        matScaledAndRotated = glm::rotate(matScaled, float(-m_fCamAng), glm::vec3(0.0f, 0.0f, 1.0f));
+        matScaled = glm::scale(m_matProjection, glm::vec3(GLfloat(Cam.fZoom), GLfloat(Cam.fZoom), 1.0f));
+        matScaledAndRotated = glm::rotate(matScaled, float(-Cam.fAng), glm::vec3(0.0f, 0.0f, 1.0f));
         m_matTransform = matScaledAndRotated;
     }
 
@@ -779,9 +1093,9 @@ void CGraphics::resetCam()
 {
     METHOD_ENTRY("CGraphics::resetCam")
 
-    m_fCamZoom = 1.0;
-    m_fCamAng = 0.0;
-    m_vecCamPos.setZero();
+    m_CamState.fZoom = 1.0;
+    m_CamState.fAng = 0.0;
+    m_CamState.vecPos.setZero();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -798,7 +1112,7 @@ void CGraphics::rotCamBy(const double& _fInc)
 {
     METHOD_ENTRY("CGraphics::rotCamBy")
 
-    m_fCamAng += _fInc;
+    m_CamState.fAng += _fInc;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -815,7 +1129,7 @@ void CGraphics::rotCamTo(const double& _fAng)
 {
     METHOD_ENTRY("CGraphics::rotCamTo")
 
-    m_fCamAng = _fAng;
+    m_CamState.fAng = _fAng;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -833,9 +1147,9 @@ void CGraphics::transCamBy(const Vector2d& _vecInc)
 {
     METHOD_ENTRY("CGraphics::transCamBy")
 
-    Rotation2Dd Rotation(m_fCamAng);
+    Rotation2Dd Rotation(m_CamState.fAng);
 
-    m_vecCamPos.segment<2>(0) += Rotation * _vecInc;
+    m_CamState.vecPos.segment<2>(0) += Rotation * _vecInc;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -849,9 +1163,9 @@ void CGraphics::transCamTo(const Vector2d& _vecPos)
 {
     METHOD_ENTRY("CGraphics::transCamTo")
 
-    Rotation2Dd Rotation(m_fCamAng);
+    Rotation2Dd Rotation(m_CamState.fAng);
     
-    m_vecCamPos.segment<2>(0) = Rotation * _vecPos;
+    m_CamState.vecPos.segment<2>(0) = Rotation * _vecPos;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -865,7 +1179,7 @@ void CGraphics::zoomCamBy(const double& _fFac)
 {
     METHOD_ENTRY("CGraphics::zoomCamBy")
 
-    m_fCamZoom *= _fFac;
+    m_CamState.fZoom *= _fFac;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -879,7 +1193,7 @@ void CGraphics::zoomCamTo(const double& _fFac)
 {
     METHOD_ENTRY("CGraphics::zoomCamTo")
 
-    m_fCamZoom = _fFac;
+    m_CamState.fZoom = _fFac;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -898,11 +1212,11 @@ void CGraphics::drawArcDyn(const Vector2d& _vecC, const double& _fRad,
     METHOD_ENTRY("CGraphics::drawArcDyn")
     
     double fInc = GRAPHICS_CIRCLE_SEG_ANG;
-    double fSegPx = GRAPHICS_CIRCLE_SEG_ANG * this->getResPMX() * _fRad; 
+    double fSegPx = GRAPHICS_CIRCLE_SEG_ANG * m_RenderPackets.getReadBuffer().getResPMX() * _fRad; 
     if (fSegPx < GRAPHICS_CIRCLE_SEG_MIN)
     {
         fSegPx = GRAPHICS_CIRCLE_SEG_MIN;
-        double fSurfPx = this->getResPMX() * _fRad /** MATH_2PI*/;
+        double fSurfPx = m_RenderPackets.getReadBuffer().getResPMX() * _fRad /** MATH_2PI*/;
         fInc = fSegPx/fSurfPx /** MATH_2PI*/;
     }
     
@@ -941,17 +1255,17 @@ void CGraphics::drawCircleDyn(const Vector2d& _vecC, const double& _fRad)
     METHOD_ENTRY("CGraphics::drawCircleDyn")
     
     double fInc = GRAPHICS_CIRCLE_SEG_ANG;
-    double fSegPx = GRAPHICS_CIRCLE_SEG_ANG * this->getResPMX() * _fRad; 
+    double fSegPx = GRAPHICS_CIRCLE_SEG_ANG * m_RenderPackets.getReadBuffer().getResPMX() * _fRad; 
     if (fSegPx < GRAPHICS_CIRCLE_SEG_MIN)
     {
         fSegPx = GRAPHICS_CIRCLE_SEG_MIN;
-        double fSurfPx = this->getResPMX() * _fRad /** MATH_2PI*/;
+        double fSurfPx = m_RenderPackets.getReadBuffer().getResPMX() * _fRad /** MATH_2PI*/;
         fInc = fSegPx/fSurfPx /** MATH_2PI*/;
     }
     else if (fSegPx > GRAPHICS_CIRCLE_SEG_MAX)
     {
         fSegPx = GRAPHICS_CIRCLE_SEG_MAX;
-        double fSurfPx = this->getResPMX() * _fRad /** MATH_2PI*/;
+        double fSurfPx = m_RenderPackets.getReadBuffer().getResPMX() * _fRad /** MATH_2PI*/;
         fInc = fSegPx/fSurfPx /** MATH_2PI*/;
     }
     
@@ -1071,14 +1385,16 @@ void CGraphics::showVec(const Vector2d& _vecV, const Vector2d& _vecPos)
 {
     METHOD_ENTRY("CGraphics::showVec")
 
+    const GraphicsCamStateType& Cam = m_RenderPackets.getReadBuffer().getCam();
+
     // Catch nullvectors at first
     if (_vecV.norm() != 0.0)
     {
         Vector2d vecFront   = _vecPos+_vecV;
         Vector2d vecDir     = _vecV.normalized();
-        Vector2d vecFrontT  = vecFront - vecDir * 5.0/m_fCamZoom;
-        Vector2d vecFrontOL = vecFrontT + Vector2d(-vecDir[1],  vecDir[0]) * 2.0/m_fCamZoom;
-        Vector2d vecFrontOR = vecFrontT + Vector2d( vecDir[1], -vecDir[0]) * 2.0/m_fCamZoom;
+        Vector2d vecFrontT  = vecFront - vecDir * 5.0/Cam.fZoom;
+        Vector2d vecFrontOL = vecFrontT + Vector2d(-vecDir[1],  vecDir[0]) * 2.0/Cam.fZoom;
+        Vector2d vecFrontOR = vecFrontT + Vector2d( vecDir[1], -vecDir[0]) * 2.0/Cam.fZoom;
 
         this->beginLine(PolygonType::LINE_SINGLE);
             this->addVertex(_vecPos);
@@ -1823,6 +2139,205 @@ void CGraphics::resetBufferObjects()
     glClear(GL_DEPTH_BUFFER_BIT|GL_COLOR_BUFFER_BIT);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns an unused query object, creating one if needed
+///
+/// \return Query object
+///
+///////////////////////////////////////////////////////////////////////////////
+GLuint CGraphics::acquireGPUTimerQuery()
+{
+    METHOD_ENTRY("CGraphics::acquireGPUTimerQuery")
+    
+    GLuint unQuery = 0u;
+    if (m_GPUTimerQueryPool.empty())
+    {
+        glGenQueries(1, &unQuery);
+    }
+    else
+    {
+        unQuery = m_GPUTimerQueryPool.back();
+        m_GPUTimerQueryPool.pop_back();
+    }
+    return unQuery;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Starts GPU time measurement of a render batch
+///
+/// \param _pRenderMode Render mode of batch, its registered name is used
+///
+///////////////////////////////////////////////////////////////////////////////
+void CGraphics::beginGPUTimer(const CRenderMode* const _pRenderMode)
+{
+    METHOD_ENTRY("CGraphics::beginGPUTimer")
+    
+    const auto ci = m_RenderModeNames.find(_pRenderMode);
+    if (ci != m_RenderModeNames.end())
+        this->beginGPUTimer(ci->second);
+    else
+        this->beginGPUTimer("unnamed");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Starts render packet of current simulation step
+///
+/// To be called by the single writer of render packets, i.e. the simulation
+/// at the end of each step. The packet is cleared, camera and screen size are
+/// set from the writers state. Hence, camera changes apply to packets started
+/// afterwards. The packet must be filled completely, since it doesn't
+/// necessarily hold the previous one. It may be changed until
+/// \ref commitRenderPacket is called.
+///
+/// \return Render packet to be filled
+///
+///////////////////////////////////////////////////////////////////////////////
+CRenderPacket& CGraphics::beginRenderPacket()
+{
+    METHOD_ENTRY("CGraphics::beginRenderPacket")
+    
+    CRenderPacket& Packet = m_RenderPackets.getWriteBuffer();
+    Packet.clear();
+    Packet.setCam(m_CamState);
+    Packet.setScreen(m_unWidthScrPacket, m_unHeightScrPacket);
+    return Packet;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Hands render packet started by \ref beginRenderPacket to rendering
+///
+/// To be called by the single writer of render packets. Afterwards, the
+/// packet must not be accessed anymore.
+///
+///////////////////////////////////////////////////////////////////////////////
+void CGraphics::commitRenderPacket()
+{
+    METHOD_ENTRY("CGraphics::commitRenderPacket")
+    m_RenderPackets.publish();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Draws objects of current render packet as dots in their colours
+///
+/// Texts of the packet are drawn by font users, since they depend on fonts.
+///
+///////////////////////////////////////////////////////////////////////////////
+void CGraphics::drawRenderPacket()
+{
+    METHOD_ENTRY("CGraphics::drawRenderPacket")
+    
+    const CRenderPacket& Packet = m_RenderPackets.getReadBuffer();
+    for (auto i=0u; i<Packet.getPositions().size(); ++i)
+    {
+        this->setColor(Packet.getColours()[i]);
+        this->dot(Packet.getPositions()[i]);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets screen size of render packets started from now on
+///
+/// To be called by the single writer of render packets, e.g. on event
+/// e_resize.
+///
+/// \param _unWidthScr Screen width
+/// \param _unHeightScr Screen height
+///
+///////////////////////////////////////////////////////////////////////////////
+void CGraphics::resizeRenderPackets(const unsigned short _unWidthScr, const unsigned short _unHeightScr)
+{
+    METHOD_ENTRY("CGraphics::resizeRenderPackets")
+    
+    m_unWidthScrPacket = _unWidthScr;
+    m_unHeightScrPacket = _unHeightScr;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Reads back GPU timer queries of an older frame
+///
+/// The slot of the frame issued GRAPHICS_GPU_TIMER_LATENCY-1 frames ago is
+/// read back and reused for the next frame. Usually, results are available
+/// by then. If not, the measurement is dropped instead of stalling the
+/// pipeline. GPU times are summed up per name, since a render mode might be
+/// used for several batches per frame.
+///
+///////////////////////////////////////////////////////////////////////////////
+void CGraphics::readGPUTimers()
+{
+    METHOD_ENTRY("CGraphics::readGPUTimers")
+    
+    // Measurements that were not finished within this frame are closed
+    while (!m_GPUTimerQueriesOpen.empty()) this->endGPUTimer();
+    
+    m_nGPUTimerFrame = (m_nGPUTimerFrame + 1) % GRAPHICS_GPU_TIMER_LATENCY;
+    
+    std::map<std::string, double> GPUTimes;
+    for (const auto& Query : m_GPUTimerQueries[m_nGPUTimerFrame])
+    {
+        GLint nAvailable = GL_FALSE;
+        glGetQueryObjectiv(Query.unEnd, GL_QUERY_RESULT_AVAILABLE, &nAvailable);
+        if (nAvailable == GL_TRUE)
+        {
+            GLuint64 unStart = 0u;
+            GLuint64 unEnd = 0u;
+            glGetQueryObjectui64v(Query.unStart, GL_QUERY_RESULT, &unStart);
+            glGetQueryObjectui64v(Query.unEnd, GL_QUERY_RESULT, &unEnd);
+            GPUTimes[Query.strName] += (unEnd - unStart) * 1.0e-9;
+        }
+        else
+        {
+            DEBUG_MSG("Graphics", "GPU timer query of " << Query.strName << " not available, dropped.")
+        }
+        m_GPUTimerQueryPool.push_back(Query.unStart);
+        m_GPUTimerQueryPool.push_back(Query.unEnd);
+    }
+    m_GPUTimerQueries[m_nGPUTimerFrame].clear();
+    
+    for (const auto& GPUTime : GPUTimes)
+    {
+        auto it = m_StatsGPUTimes.find(GPUTime.first);
+        if (it == m_StatsGPUTimes.end())
+        {
+            it = m_StatsGPUTimes.insert({GPUTime.first, new CFrameStats("GPU " + GPUTime.first, "s")}).first;
+            MEM_ALLOC("CFrameStats")
+            
+            // Other threads only see the copy, which changes with new entries
+            m_StatsGPUTimesLock.acquireLock();
+            m_StatsGPUTimesShared.clear();
+            for (const auto& GPUTimeStats : m_StatsGPUTimes) m_StatsGPUTimesShared.push_back(GPUTimeStats.second);
+            m_StatsGPUTimesLock.releaseLock();
+        }
+        it->second->addSample(GPUTime.second);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Provides histories of GPU time per render mode or pass
+///
+/// Histories are created on first use of a render mode or pass by the
+/// graphics thread. A copy of the list is kept for other threads, e.g. the
+/// performance HUD or com functions, hence, this method is thread safe.
+///
+/// \param _Stats Vector to append histories to
+///
+///////////////////////////////////////////////////////////////////////////////
+void CGraphics::getStatsGPUTimes(std::vector<const CFrameStats*>& _Stats) const
+{
+    METHOD_ENTRY("CGraphics::getStatsGPUTimes")
+    
+    m_StatsGPUTimesLock.acquireLock();
+    _Stats.insert(_Stats.end(), m_StatsGPUTimesShared.begin(), m_StatsGPUTimesShared.end());
+    m_StatsGPUTimesLock.releaseLock();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Restart a renderbatch, render mode stays the same (internal, temporary)
@@ -1832,6 +2347,8 @@ void CGraphics::restartRenderBatchInternal()
 {
     METHOD_ENTRY("CGraphics::restartRenderBatchInternal")
     
+    if (m_bGPUTimer) this->beginGPUTimer(m_pRenderMode);
+    
     glBindVertexArray(m_unVAO);
     
     glBindBuffer(GL_ARRAY_BUFFER, m_unVBO);
@@ -1910,6 +2427,8 @@ void CGraphics::restartRenderBatchInternal()
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_unIBOTriangles);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_unIndexTriangles*sizeof(GLuint), nullptr, GL_STREAM_DRAW);
     
+    if (m_bGPUTimer) this->endGPUTimer();
+    
     m_uncI = 0u;
     m_unIndex = 0u;
     m_unIndexVerts = 0u;
@@ -33,15 +33,21 @@
 //--- Standard header --------------------------------------------------------//
 #include <array>
 #include <list>
+#include <map>
 #include <stack>
+#include <vector>
 
 //--- Program header ---------------------------------------------------------//
 #include "circular_buffer.h"
+#include "frame_stats.h"
 #include "log.h"
 #include "math_constants.h"
 #include "shader_program.h"
 #include "shape_subtypes.h"
 #include "render_mode.h"
+#include "spinlock.h"
+#include "timer.h"
+#include "triple_buffer.h"
 
 //--- Misc header ------------------------------------------------------------//
 #include <eigen3/Eigen/Core>
@@ -97,6 +103,8 @@ constexpr bool   GRAPHICS_CIRCLE_USE_CACHE = true;          ///< Flag for using
 constexpr bool GRAPHICS_RENDER_BATCH_CALL_FORCED = true;    ///< Indicates a forced render batch call, ignoring stack
 constexpr bool GRAPHICS_RENDER_BATCH_CALL_NORMAL = false;   ///< Indicates a normal render batch call
 
+constexpr int GRAPHICS_GPU_TIMER_LATENCY = 3;               ///< Frames until GPU timer queries are read back
+
 
 /// Type definition for RGB colours
 typedef std::array<double, 3> ColorTypeRGB;
@@ -105,6 +113,24 @@ typedef std::array<double, 4> ColorTypeRGBA;
 
 /// Type definition of a render modes, accessed by name
 typedef std::unordered_map<std::string, CRenderMode*> RenderModesByNameType;
+/// Type definition of GPU time statistics, accessed by name of render mode or pass
+typedef std::map<std::string, CFrameStats*> GPUTimesByNameType;
+
+/// Pair of GPU timestamp queries, enclosing a render batch or pass
+struct GPUTimerQueryType
+{
+    GLuint      unStart;    ///< Query for timestamp at start
+    GLuint      unEnd;      ///< Query for timestamp at end
+    std::string strName;    ///< Name of render mode or pass
+};
+
+/// Camera state of a render packet
+struct GraphicsCamStateType
+{
+    Vector3d vecPos = Vector3d::Zero();     ///< Camera position
+    double   fAng = 0.0;                    ///< Camera angle
+    double   fZoom = 1.0;                   ///< Camera zoom
+};
 
 // Structure containing viewport information
 struct ViewPort
@@ -117,6 +143,69 @@ struct ViewPort
     double farplane = GRAPHICS_FAR_DEFAULT;          ///< Far plane of viewport
 };
 
+/// Text of a render packet, placed in world coordinates
+struct RenderPacketTextType
+{
+    std::string     strText = "";                       ///< Text
+    std::string     strFont = "";                       ///< Font of text
+    int             nSize = 0;                          ///< Font size
+    Vector2d        vecPos = Vector2d::Zero();          ///< Position in world coordinates
+    ColorTypeRGBA   aColour = {{1.0, 1.0, 1.0, 1.0}};   ///< Colour of text
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Render relevant state of one simulation step
+///
+/// A packet is built completely by a single writer, the simulation at the
+/// end of each step (see \ref CGraphics::beginRenderPacket), and is not
+/// changed after it was committed. Rendering only reads the latest packet.
+///
+/// Transformations between screen and world use camera and screen size of
+/// the packet. Hence, they match what is drawn, and the writer may use them
+/// on the packet being built as well as rendering on the packet it reads.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CRenderPacket
+{
+
+    public:
+
+        //--- Constant Methods -----------------------------------------------//
+        Vector2d        screen2World(const Vector2d&) const;
+        Vector2d        screen2World(const double&, const double&) const;
+        Vector2d        world2Screen(const Vector2d&) const;
+        double          getResMPX() const;
+        double          getResMPY() const;
+        double          getResPMX() const;
+        double          getResPMY() const;
+        unsigned short  getWidthScr() const {return m_unWidthScr;}
+        unsigned short  getHeightScr() const {return m_unHeightScr;}
+
+        const GraphicsCamStateType&                 getCam() const {return m_Cam;}
+        const std::vector<ColorTypeRGBA>&           getColours() const {return m_Colours;}
+        const std::vector<Vector2d>&                getPositions() const {return m_Positions;}
+        const std::vector<RenderPacketTextType>&    getTexts() const {return m_Texts;}
+
+        //--- Methods --------------------------------------------------------//
+        void addPosition(const Vector2d&, const ColorTypeRGBA&);
+        void addText(const RenderPacketTextType&);
+        void clear();
+        void setCam(const GraphicsCamStateType& _Cam) {m_Cam = _Cam;}
+        void setScreen(const unsigned short, const unsigned short);
+
+    private:
+
+        //--- Variables [private] --------------------------------------------//
+        GraphicsCamStateType                m_Cam;                              ///< Camera
+        ViewPort                            m_ViewPort;                         ///< Viewport, given by screen size
+        unsigned short                      m_unWidthScr = GRAPHICS_WIDTH_DEFAULT;   ///< Screen width
+        unsigned short                      m_unHeightScr = GRAPHICS_HEIGHT_DEFAULT; ///< Screen height
+        std::vector<Vector2d>               m_Positions;                        ///< Positions of objects
+        std::vector<ColorTypeRGBA>          m_Colours;                          ///< Colours of objects
+        std::vector<RenderPacketTextType>   m_Texts;                            ///< Texts
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief graphics-wrapper
@@ -127,6 +216,16 @@ struct ViewPort
 /// to provide easy access to its methods for graphics abstraction classes like
 /// IShape.
 ///
+/// Instead of a window, an offscreen context can be used (see
+/// \ref initHeadless), e.g. for benchmarks on machines without display.
+///
+/// Simulation and rendering are decoupled by render packets (see
+/// \ref CRenderPacket), handed over by a triple buffer. The camera state has
+/// a single writer, the simulation step building the packets. Other modules
+/// move the camera through it, e.g. by com functions queued in its writer
+/// domain. Rendering takes over the latest packet once per frame and reads
+/// the camera from there only.
+///
 /// \todo Implement frustum culling
 /// \todo Perhaps moving the camera towards z-axis is better than scaling, see
 ///         frustum culling.
@@ -149,22 +248,24 @@ class CGraphics
         //
 
         //--- Constant methods -----------------------------------------------//
-        Vector2d        screen2World(const Vector2d&) const;
-        Vector2d        screen2World(const double&, const double&) const;
-        Vector2d        world2Screen(const Vector2d&) const;
         int             getDrawCalls() const {return m_nDrawCalls;}
+        const CFrameStats& getStatsFrameTime() const {return m_StatsFrameTime;}
+        void            getStatsGPUTimes(std::vector<const CFrameStats*>&) const;
+        const CFrameStats& getStatsSubmitTime() const {return m_StatsSubmitTime;}
+        const CFrameStats& getStatsUploadBytes() const {return m_StatsUploadBytes;}
+        const CFrameStats& getStatsVertices() const {return m_StatsVerts;}
+        int             getUploadBytesPerFrame() const {return m_nUploadBytes;}
         int             getLinesPerFrame() const {return m_nLines;}
         int             getPointsPerFrame() const {return m_nPoints;}
         int             getTrianglesPerFrame() const {return m_nTriangles;}
         int             getVerticesPerFrame() const {return m_nVerts;}
         double          getDynPelSize() const;
-        double          getResMPX() const;
-        double          getResMPY() const;
-        double          getResPMX() const;
-        double          getResPMY() const;
         unsigned short  getWidthScr() const;
         unsigned short  getHeightScr() const;
         Vector2i        getScreenRes() const;
+        GLuint          getScreenFramebuffer() const {return m_unFBOScreen;}
+        bool            isGPUTimer() const {return m_bGPUTimer;}
+        bool            isHeadless() const {return m_bHeadless;}
         void setColor(const ColorTypeRGBA&);
         void setColor(const double&, const double&, const double&);
         void setColor(const double&, const double&, const double&, const double&);
@@ -180,14 +281,21 @@ class CGraphics
         bool restartRenderBatch(const std::string&);
         void restartRenderBatch(CRenderMode* const);
         void registerRenderMode(const std::string& _strName, CRenderMode* const);
+        void unregisterRenderMode(const std::string&);
+        
+        void beginGPUTimer(const std::string&);
+        void endGPUTimer();
+        bool setGPUTimer(const bool);
         
         bool init();
+        bool initHeadless(const unsigned short, const unsigned short);
         void resizeViewport(unsigned short, unsigned short);
         bool resizeWindow(unsigned short, unsigned short);
         void setWidthScr(const unsigned short&);
         void setHeightScr(const unsigned short&);
         void setViewPort(const double&, const double&, const double&, const double&);
         void setupScreenSpace();
+        void setupScreenSpace(const int, const int, const int, const int);
         void setupWorldSpace();
         void swapBuffers();
         
@@ -215,6 +323,19 @@ class CGraphics
         void zoomCamBy(const double&);
         void zoomCamTo(const double&);
 
+        //
+        //--- Methods for render packets -------------------------------------//
+        //
+
+        //--- Constant methods -----------------------------------------------//
+        const CRenderPacket& getRenderPacket() const;
+
+        //--- Methods --------------------------------------------------------//
+        CRenderPacket& beginRenderPacket();
+        void commitRenderPacket();
+        void drawRenderPacket();
+        void resizeRenderPackets(const unsigned short, const unsigned short);
+
         //
         //--- Methods for drawing --------------------------------------------//
         //
@@ -250,10 +371,19 @@ class CGraphics
         
     private:
         
+        GLuint acquireGPUTimerQuery();
+        void beginGPUTimer(const CRenderMode* const);
+        void initGL();
+        void readGPUTimers();
         void restartRenderBatchInternal();
         
         //--- Variables [private] --------------------------------------------//
         WindowHandleType*   m_pWindow;                  ///< Pointer to main window
+        bool                m_bHeadless = false;        ///< Indicates offscreen rendering without window
+        GLuint              m_unFBOScreen = 0u;         ///< Framebuffer representing the screen, 0 if window is used
+        GLuint              m_unRBOScreen = 0u;         ///< Colour renderbuffer of offscreen screen framebuffer
+        void*               m_pEGLDisplay = nullptr;    ///< EGL display of headless context
+        void*               m_pEGLContext = nullptr;    ///< EGL context of headless context
         
         ViewPort            m_ViewPort;                 ///< Viewport for graphics
         glm::mat4           m_matTransform;             ///< Final transformation matrix
@@ -292,6 +422,27 @@ class CGraphics
         int                 m_nPoints;                  ///< Number of points per frame
         int                 m_nTriangles;               ///< Number of triangles per frame
         int                 m_nVerts;                   ///< Number of vertices per frame
+        int                 m_nUploadBytes;             ///< Bytes uploaded to buffer objects per frame
+        double              m_fSubmitTime;              ///< Time spent for uploads and draw calls per frame
+        
+        // Frame history for performance HUD:
+        CTimer              m_FrameTimer;               ///< Measures time between buffer swaps
+        CTimer              m_SubmitTimer;              ///< Measures uploads and draw calls of a batch
+        CFrameStats         m_StatsFrameTime;           ///< History of frame time
+        CFrameStats         m_StatsSubmitTime;          ///< History of time for uploads and draw calls
+        CFrameStats         m_StatsUploadBytes;         ///< History of bytes uploaded to buffer objects
+        CFrameStats         m_StatsVerts;               ///< History of vertices
+        
+        // GPU timer queries:
+        bool                m_bGPUTimer = false;        ///< Indicates if GPU times are measured
+        int                 m_nGPUTimerFrame = 0;       ///< Slot of current frame in query ring
+        std::array<std::vector<GPUTimerQueryType>,
+                   GRAPHICS_GPU_TIMER_LATENCY> m_GPUTimerQueries; ///< Finished queries of last frames
+        std::vector<GPUTimerQueryType> m_GPUTimerQueriesOpen; ///< Started queries, not yet finished
+        std::vector<GLuint>     m_GPUTimerQueryPool;    ///< Unused query objects
+        GPUTimesByNameType      m_StatsGPUTimes;        ///< History of GPU time per render mode or pass
+        std::vector<const CFrameStats*> m_StatsGPUTimesShared; ///< Copy of GPU time histories for other threads
+        mutable CSpinlock       m_StatsGPUTimesLock;    ///< Guards copy of GPU time histories
         
         ColorTypeRGBA       m_aColour;                  ///< Currently set color
         
@@ -305,13 +456,15 @@ class CGraphics
         std::vector<GLfloat>    m_vecUV1s;              ///< Temporary buffer for texture coordinates (texture 1)
         
         RenderModesByNameType   m_RenderModesByName;    ///< Map of render modes, accessed by name
+        std::unordered_map<const CRenderMode*, std::string> m_RenderModeNames; ///< Names of render modes, e.g. for statistics
         CRenderMode*            m_pRenderMode;          ///< Currently selected render mode
         RenderModeType          m_RenderModeType;       ///< Currently used render mode
         std::stack<CRenderMode*> m_RenderModeStack;     ///< Temporarily saves render batch information
         
-        Vector3d            m_vecCamPos;                ///< camera position
-        double              m_fCamAng;                  ///< camera angle
-        double              m_fCamZoom;                 ///< camera zoom
+        GraphicsCamStateType m_CamState;                ///< Camera state, owned by writer of render packets
+        unsigned short      m_unWidthScrPacket = GRAPHICS_WIDTH_DEFAULT;   ///< Screen width of render packets
+        unsigned short      m_unHeightScrPacket = GRAPHICS_HEIGHT_DEFAULT; ///< Screen height of render packets
+        CTripleBuffer<CRenderPacket> m_RenderPackets;   ///< Render packets handed over from simulation to rendering
         double              m_fDepth;                   ///< depth of lines in list
         double              m_fDepthMax;                ///< maximum depth of levels
         double              m_fDepthMin;                ///< minimum depth of levels
@@ -366,11 +519,11 @@ public:
 /// \return Horizontal resolution in m/pel
 ///
 ///////////////////////////////////////////////////////////////////////////////
-inline double CGraphics::getResMPX() const
+inline double CRenderPacket::getResMPX() const
 {
-    METHOD_ENTRY("CGraphics::getResMPX()");
+    METHOD_ENTRY("CRenderPacket::getResMPX()");
     return ((m_ViewPort.rightplane-m_ViewPort.leftplane) /
-            (m_fCamZoom * m_unWidthScr));
+            (m_Cam.fZoom * m_unWidthScr));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -380,11 +533,11 @@ inline double CGraphics::getResMPX() const
 /// \return Vertical resolution in m/pel
 ///
 ///////////////////////////////////////////////////////////////////////////////
-inline double CGraphics::getResMPY() const
+inline double CRenderPacket::getResMPY() const
 {
-    METHOD_ENTRY("CGraphics::getResMPY()");
+    METHOD_ENTRY("CRenderPacket::getResMPY()");
     return ((m_ViewPort.topplane-m_ViewPort.bottomplane) /
-            (m_fCamZoom * m_unHeightScr));
+            (m_Cam.fZoom * m_unHeightScr));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -394,10 +547,10 @@ inline double CGraphics::getResMPY() const
 /// \return Horizontal resolution in pel/m
 ///
 ///////////////////////////////////////////////////////////////////////////////
-inline double CGraphics::getResPMX() const
+inline double CRenderPacket::getResPMX() const
 {
-    METHOD_ENTRY("CGraphics::getResPMX()");
-    return ((m_fCamZoom * m_unWidthScr) / 
+    METHOD_ENTRY("CRenderPacket::getResPMX()");
+    return ((m_Cam.fZoom * m_unWidthScr) / 
             (m_ViewPort.rightplane-m_ViewPort.leftplane));
 }
 
@@ -408,13 +561,54 @@ inline double CGraphics::getResPMX() const
 /// \return Vertical resolution in pel/m
 ///
 ///////////////////////////////////////////////////////////////////////////////
-inline double CGraphics::getResPMY() const
+inline double CRenderPacket::getResPMY() const
 {
-    METHOD_ENTRY("CGraphics::getResPMY()");
-    return ((m_fCamZoom * m_unHeightScr) / 
+    METHOD_ENTRY("CRenderPacket::getResPMY()");
+    return ((m_Cam.fZoom * m_unHeightScr) / 
             (m_ViewPort.topplane-m_ViewPort.bottomplane));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds an object at given position
+///
+/// \param _vecPos Position in world coordinates
+/// \param _aColour Colour of object
+///
+///////////////////////////////////////////////////////////////////////////////
+inline void CRenderPacket::addPosition(const Vector2d& _vecPos, const ColorTypeRGBA& _aColour)
+{
+    METHOD_ENTRY("CRenderPacket::addPosition");
+    m_Positions.push_back(_vecPos);
+    m_Colours.push_back(_aColour);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds a text
+///
+/// \param _Text Text, placed in world coordinates
+///
+///////////////////////////////////////////////////////////////////////////////
+inline void CRenderPacket::addText(const RenderPacketTextType& _Text)
+{
+    METHOD_ENTRY("CRenderPacket::addText");
+    m_Texts.push_back(_Text);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Removes all objects and texts, keeping allocated memory
+///
+///////////////////////////////////////////////////////////////////////////////
+inline void CRenderPacket::clear()
+{
+    METHOD_ENTRY("CRenderPacket::clear");
+    m_Positions.clear();
+    m_Colours.clear();
+    m_Texts.clear();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Returns the screen width
@@ -559,6 +753,29 @@ inline void CGraphics::registerRenderMode(const std::string& _strName, CRenderMo
 {
     METHOD_ENTRY("CGraphics::registerRenderMode")
     m_RenderModesByName.insert({_strName, _pRenderMode});
+    m_RenderModeNames.insert({_pRenderMode, _strName});
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Removes a render mode registered by \ref registerRenderMode
+///
+/// Must be called before the render mode is destroyed. Unknown names are
+/// ignored.
+///
+/// \param _strName Name of render mode to be removed
+///
+///////////////////////////////////////////////////////////////////////////////
+inline void CGraphics::unregisterRenderMode(const std::string& _strName)
+{
+    METHOD_ENTRY("CGraphics::unregisterRenderMode")
+    
+    const auto ci = m_RenderModesByName.find(_strName);
+    if (ci != m_RenderModesByName.end())
+    {
+        m_RenderModeNames.erase(ci->second);
+        m_RenderModesByName.erase(ci);
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -616,7 +833,7 @@ inline void CGraphics::setWindow(WindowHandleType* const _pWindow)
 inline Vector2d CGraphics::getCamPos() const
 {
     METHOD_ENTRY("CGraphics::getCamPos()");
-    return Vector2d(m_vecCamPos[0], m_vecCamPos[1]);
+    return Vector2d(m_CamState.vecPos[0], m_CamState.vecPos[1]);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -629,7 +846,7 @@ inline Vector2d CGraphics::getCamPos() const
 inline double CGraphics::getCamAng() const
 {
     METHOD_ENTRY("CGraphics::getCamAngle()");
-    return m_fCamAng;
+    return m_CamState.fAng;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -642,7 +859,7 @@ inline double CGraphics::getCamAng() const
 inline double CGraphics::getCamZoom() const
 {
     METHOD_ENTRY("CGraphics::getCamZoom()");
-    return m_fCamZoom;
+    return m_CamState.fZoom;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -658,6 +875,22 @@ inline const ViewPort& CGraphics::getViewPort() const
     return m_ViewPort;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns render packet taken over by rendering for current frame
+///
+/// To be called by the graphics thread only. The packet stays the same until
+/// the frame ends (see \ref swapBuffers).
+///
+/// \return Latest render packet at the start of the frame
+///
+///////////////////////////////////////////////////////////////////////////////
+inline const CRenderPacket& CGraphics::getRenderPacket() const
+{
+    METHOD_ENTRY("CGraphics::getRenderPacket()");
+    return m_RenderPackets.getReadBuffer();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Sets depth of primitiv that should be drawn
@@ -96,7 +96,7 @@ bool CRenderTarget::init(const std::uint16_t _unResX, const std::uint16_t _unRes
     }
     
     // Unbind
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_Graphics.getScreenFramebuffer());
     
     // Store size
     m_unResX = _unResX;
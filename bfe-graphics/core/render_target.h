@@ -35,6 +35,7 @@
 
 //--- Standard header --------------------------------------------------------//
 #include <cstdint>
+#include <string>
 #include <vector>
 
 //--- Program header ---------------------------------------------------------//
@@ -73,7 +74,9 @@ class CRenderTarget : virtual public CGraphicsBase
               GLuint                getIDTex() const;
         const std::vector<GLfloat>& getTexUV() const;
         void bind(const bool _bClear = false) const;
+        void bindScreenSpace(const int, const int, const bool _bClear = false) const;
         void unbind() const;
+        void unbindScreenSpace() const;
         
     private:
         
@@ -131,6 +134,7 @@ inline const std::vector<GLfloat>& CRenderTarget::getTexUV() const
 inline void CRenderTarget::bind(const bool _bClear) const
 {
     METHOD_ENTRY("CRenderTarget::bind")
+    if (m_Graphics.isGPUTimer()) m_Graphics.beginGPUTimer("render_target_" + std::to_string(m_unIDFBO));
     glBindFramebuffer(GL_FRAMEBUFFER, m_unIDFBO);
     if (_bClear) glClear(GL_DEPTH_BUFFER_BIT|GL_COLOR_BUFFER_BIT);
     glViewport(0, 0, m_unResX / m_unSub, m_unResY / m_unSub);
@@ -138,6 +142,34 @@ inline void CRenderTarget::bind(const bool _bClear) const
                            (-m_unResY >> 1) / GRAPHICS_PX_PER_METER, (m_unResY >> 1) / GRAPHICS_PX_PER_METER);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Bind the framebuffer object for screen space rendering
+///
+/// In contrast to \ref bind, the world viewport is not touched. Instead, the
+/// region of the screen at the given position with the size of this target
+/// is mapped to the framebuffer. The target is cleared to full transparency,
+/// since it is usually blended when displayed.
+///
+/// \param _nX Left border of region (screen space)
+/// \param _nY Top border of region (screen space)
+/// \param _bClear Clear frame buffer?
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CRenderTarget::bindScreenSpace(const int _nX, const int _nY, const bool _bClear) const
+{
+    METHOD_ENTRY("CRenderTarget::bindScreenSpace")
+    if (m_Graphics.isGPUTimer()) m_Graphics.beginGPUTimer("render_target_" + std::to_string(m_unIDFBO));
+    glBindFramebuffer(GL_FRAMEBUFFER, m_unIDFBO);
+    if (_bClear)
+    {
+        const GLfloat aTransparent[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        glClearBufferfv(GL_COLOR, 0, aTransparent);
+    }
+    glViewport(0, 0, m_unResX / m_unSub, m_unResY / m_unSub);
+    m_Graphics.setupScreenSpace(_nX, _nY, m_unResX, m_unResY);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Unbind the framebuffer object
@@ -146,7 +178,24 @@ inline void CRenderTarget::bind(const bool _bClear) const
 inline void CRenderTarget::unbind() const
 {
     METHOD_ENTRY("CRenderTarget::unbind")
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (m_Graphics.isGPUTimer()) m_Graphics.endGPUTimer();
+    glBindFramebuffer(GL_FRAMEBUFFER, m_Graphics.getScreenFramebuffer());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Unbind the framebuffer object after screen space rendering
+///
+/// Viewport and projection are reset to the main screen.
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CRenderTarget::unbindScreenSpace() const
+{
+    METHOD_ENTRY("CRenderTarget::unbindScreenSpace")
+    if (m_Graphics.isGPUTimer()) m_Graphics.endGPUTimer();
+    glBindFramebuffer(GL_FRAMEBUFFER, m_Graphics.getScreenFramebuffer());
+    glViewport(0, 0, m_Graphics.getWidthScr(), m_Graphics.getHeightScr());
+    m_Graphics.setupScreenSpace();
 }
 
 } // namespace bfe
@@ -34,12 +34,73 @@
 #include <fstream>
 #include <vector>
 
+//--- Program header ---------------------------------------------------------//
+#include "hash.h"
+
 using namespace bfe;
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Compiles shader from source read by \ref load
+///
+/// \return Success?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool CShader::compile() const
+{
+    METHOD_ENTRY("CShader::compile")
+    
+    if (m_bIsLoaded) return true;
+    
+    //--- Transfer to OpenGL specifications ---//
+    const char* pchShaderCode = m_strSource.c_str();
+    GLint       nShaderCodeLength = m_strSource.length();
+    
+    //--- Create Shader ---//
+    m_unID = glCreateShader(m_Type);
+    glShaderSource(m_unID, 1, (const GLchar **)&pchShaderCode, &nShaderCodeLength);
+    glCompileShader(m_unID);
+    
+    //--- Check for errors ---//
+    GLint nIsCompiled = 0;
+    glGetShaderiv(m_unID, GL_COMPILE_STATUS, &nIsCompiled);
+    if (nIsCompiled == GL_FALSE)
+    {
+        ERROR_MSG("Shader", "Failed to compile shader " << m_strFilename)
+        
+        GLint nLengthMax = 0;
+        glGetShaderiv(m_unID, GL_INFO_LOG_LENGTH, &nLengthMax);
+
+        std::vector<GLchar> ErrorLog(nLengthMax);
+        glGetShaderInfoLog(m_unID, nLengthMax, &nLengthMax, &ErrorLog[0]);
+
+        ERROR_BLK(
+        for (auto ci : ErrorLog)
+        {
+            std::cerr << ci;
+        }
+        std::cerr << std::endl;
+        )
+        glDeleteShader(m_unID);
+        return false;
+    }
+    else
+    {
+        INFO_MSG("Shader", "Successfully compiled shader " << m_strFilename)
+    }
+    
+    m_bIsLoaded = true;
+    
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Loads shader from given file
 ///
+/// Only the source is read and hashed, compilation is done by \ref compile,
+/// if needed.
+///
 /// \param _strFilename Filename of shader to be loaded
 /// \param _Type Type of shader (vertex, fragment, geometry)
 ///
@@ -75,51 +136,21 @@ bool CShader::load(const std::string& _strFilename, const GLenum _Type)
     }
     Filestream.close();
     
-    
-    //--- Transfer to OpenGL specifications ---//
-    const char* pchShaderCode = strShaderCode.c_str();
-    GLint       nShaderCodeLength = strShaderCode.length();
-    
     DEBUG_BLK(
         DOM_VAR(DEBUG_MSG("Shader", "Shadercode for shader " << _strFilename << ":"))
         std::cout << strShaderCode << std::endl;
     )
     
-    //--- Create Shader ---//
-    m_unID = glCreateShader(_Type);
-    glShaderSource(m_unID, 1, (const GLchar **)&pchShaderCode, &nShaderCodeLength);
-    glCompileShader(m_unID);
+    // Release previously compiled shader, source might have changed
+    if (m_bIsLoaded) this->destroy();
     
-    //--- Check for errors ---//
-    GLint nIsCompiled = 0;
-    glGetShaderiv(m_unID, GL_COMPILE_STATUS, &nIsCompiled);
-    if (nIsCompiled == GL_FALSE)
-    {
-        ERROR_MSG("Shader", "Failed to compile shader " << _strFilename)
-        
-        GLint nLengthMax = 0;
-        glGetShaderiv(m_unID, GL_INFO_LOG_LENGTH, &nLengthMax);
-
-        std::vector<GLchar> ErrorLog(nLengthMax);
-        glGetShaderInfoLog(m_unID, nLengthMax, &nLengthMax, &ErrorLog[0]);
-
-        ERROR_BLK(
-        for (auto ci : ErrorLog)
-        {
-            std::cerr << ci;
-        }
-        std::cerr << std::endl;
-        )
-        glDeleteShader(m_unID);
-        return false;
-    }
-    else
-    {
-        INFO_MSG("Shader", "Successfully compiled shader " << _strFilename)
-    }
+    //--- Hash type and source ---//
+    m_unHash = fnv1aCombine(HASH_FNV1A_OFFSET, std::uint64_t(_Type));
+    m_unHash = fnv1a(strShaderCode.data(), strShaderCode.size(), m_unHash);
     
+    m_strFilename = _strFilename;
+    m_strSource = strShaderCode;
     m_Type = _Type;
-    m_bIsLoaded = true;
     
     return true;
 }
@@ -35,6 +35,7 @@
 
 //--- Standard header --------------------------------------------------------//
 #include <cstdint>
+#include <string>
 
 //--- Program header ---------------------------------------------------------//
 #include "log.h"
@@ -51,6 +52,12 @@ namespace bfe
 ///
 /// \brief Class representing a vertex or fragment shader
 ///
+/// Shader source is read by \ref load, compilation is deferred to
+/// \ref compile. This way, a shader program restored from binary cache
+/// doesn't need any of its shaders to be compiled. Since compiling doesn't
+/// change the shader as seen by users, it is constant and the GL state is
+/// mutable.
+///
 ////////////////////////////////////////////////////////////////////////////////
 class CShader
 {
@@ -61,7 +68,11 @@ class CShader
         ~CShader();
 
         //--- Constant Methods -----------------------------------------------//
-        GLuint getID() const;
+        bool                compile() const;
+        const std::string&  getFilename() const;
+        std::uint64_t       getHash() const;
+        GLuint              getID() const;
+        bool                isCompiled() const;
         
         //--- Methods --------------------------------------------------------//
         bool load(const std::string&, const GLenum);
@@ -72,10 +83,14 @@ class CShader
     private:
         
         //--- Variables [private] --------------------------------------------//
-        bool    m_bIsLoaded = false; // Indicates, if Shader is loaded and not deleted
+        mutable bool    m_bIsLoaded = false; // Indicates, if Shader is loaded and not deleted
       
-        GLenum m_Type = 0; // Type of shader
-        GLuint m_unID = 0; // ID of shader
+        GLenum          m_Type = 0; // Type of shader
+        mutable GLuint  m_unID = 0; // ID of shader, set when compiled
+        
+        std::string   m_strFilename = ""; // Filename of shader source
+        std::string   m_strSource = "";   // Shader source
+        std::uint64_t m_unHash = 0u;      // Hash of shader type and source
 };
 
 //--- Implementation is done here for inline optimisation --------------------//
@@ -92,6 +107,32 @@ inline CShader::~CShader()
     this->destroy();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns filename of shader source
+///
+/// \return Filename of shader source
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const std::string& CShader::getFilename() const
+{
+    METHOD_ENTRY("CShader::getFilename")
+    return m_strFilename;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns hash of shader type and source
+///
+/// \return Hash of shader, e.g. used as key for program binary cache
+///
+////////////////////////////////////////////////////////////////////////////////
+inline std::uint64_t CShader::getHash() const
+{
+    METHOD_ENTRY("CShader::getHash")
+    return m_unHash;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Returns ID of shader
@@ -105,6 +146,19 @@ inline GLuint CShader::getID() const
     return m_unID;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns if shader is compiled
+///
+/// \return Shader compiled?
+///
+////////////////////////////////////////////////////////////////////////////////
+inline bool CShader::isCompiled() const
+{
+    METHOD_ENTRY("CShader::isCompiled")
+    return m_bIsLoaded;
+}
+
 } // namespace bfe
 
 #endif // SHADER_H
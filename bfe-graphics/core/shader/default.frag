@@ -0,0 +1,12 @@
+#version 330 core
+
+// Default fragment shader for coloured primitives
+
+in vec4 vColour;
+
+out vec4 FragColour;
+
+void main()
+{
+    FragColour = vColour;
+}
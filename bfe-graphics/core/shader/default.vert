@@ -0,0 +1,16 @@
+#version 330 core
+
+// Default vertex shader for coloured primitives
+
+layout(location = 0) in vec3 Vertex;
+layout(location = 1) in vec4 Colour;
+
+uniform mat4 matTransform;
+
+out vec4 vColour;
+
+void main()
+{
+    gl_Position = matTransform * vec4(Vertex, 1.0);
+    vColour = Colour;
+}
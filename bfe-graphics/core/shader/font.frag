@@ -0,0 +1,16 @@
+#version 330 core
+
+// Fragment shader for fonts rendered from bitmap atlases. Glyph coverage is
+// stored in the red channel of the atlas.
+
+in vec4 vColour;
+in vec2 vUV;
+
+uniform sampler2D FontTexture;
+
+out vec4 FragColour;
+
+void main()
+{
+    FragColour = vec4(vColour.rgb, vColour.a * texture(FontTexture, vUV).r);
+}
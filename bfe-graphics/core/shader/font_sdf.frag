@@ -0,0 +1,20 @@
+#version 330 core
+
+// Fragment shader for fonts rendered from signed distance field atlases.
+// The outline is at 0.5, anti-aliasing width is derived from screen space
+// derivatives, hence, it adapts to any font size.
+
+in vec4 vColour;
+in vec2 vUV;
+
+uniform sampler2D FontTexture;
+
+out vec4 FragColour;
+
+void main()
+{
+    float fDist  = texture(FontTexture, vUV).r;
+    float fWidth = fwidth(fDist);
+    float fAlpha = smoothstep(0.5 - fWidth, 0.5 + fWidth, fDist);
+    FragColour = vec4(vColour.rgb, vColour.a * fAlpha);
+}
@@ -0,0 +1,19 @@
+#version 330 core
+
+// Vertex shader for fonts rendered from signed distance field atlases
+
+layout(location = 0) in vec3 Vertex;
+layout(location = 1) in vec4 Colour;
+layout(location = 2) in vec2 UV;
+
+uniform mat4 matTransform;
+
+out vec4 vColour;
+out vec2 vUV;
+
+void main()
+{
+    gl_Position = matTransform * vec4(Vertex, 1.0);
+    vColour = Colour;
+    vUV = UV;
+}
@@ -30,8 +30,20 @@
 
 #include "shader_program.h"
 
+//--- Standard header --------------------------------------------------------//
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+//--- Program header ---------------------------------------------------------//
+#include "hash.h"
+#include "timer.h"
+
 using namespace bfe;
 
+/// Directory of program binary cache
+std::string bfe::CShaderProgram::s_strCacheDir = "";
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Creates GL shader program consisting of vertex and fragment shader
@@ -55,11 +67,50 @@ void CShaderProgram::create(const CShader& _VertexShader,
 ///
 /// \brief Link GL shader program
 ///
+/// The program is restored from binary cache if possible. Otherwise, shaders
+/// are compiled and linked, and the resulting binary is written to cache.
+///
+/// \return Success?
+///
 ////////////////////////////////////////////////////////////////////////////////
 bool CShaderProgram::link()
 {
     METHOD_ENTRY("CShaderProgram::link")
     
+    CTimer LinkTimer;
+    LinkTimer.start();
+    
+    std::string strShaders;
+    for (const auto pShader : Shaders)
+    {
+        strShaders += " " + pShader->getFilename();
+    }
+    
+    const std::uint64_t unKey = this->getCacheKey();
+    if (this->loadBinary(unKey))
+    {
+        Shaders.clear();
+        LinkTimer.stop();
+        INFO_MSG("Shader Program", "Shader program restored from binary cache in " <<
+                 LinkTimer.getTime()*1000.0 << "ms:" << strShaders)
+        return true;
+    }
+    
+    //--- Compile shaders, they are not needed if restored from cache ---//
+    for (const auto pShader : Shaders)
+    {
+        if (!pShader->compile())
+        {
+            ERROR_MSG("Shader Program", "Failed to link shader program, shader not compiled.")
+            return false;
+        }
+        glAttachShader(m_unID, pShader->getID());
+    }
+    
+    if (s_strCacheDir != "")
+    {
+        glProgramParameteri(m_unID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glLinkProgram(m_unID);
 
     //--- Check for errors ---//
@@ -88,14 +139,190 @@ bool CShaderProgram::link()
     }
     else
     {
-        INFO_MSG("Shader Program", "Successfully linked shader program")
-        
         // Detach shaders if succesfully linked
         for (auto it : Shaders)
         {
-            glDetachShader(m_unID, it);
+            glDetachShader(m_unID, it->getID());
         }
         Shaders.clear();
+        
+        this->saveBinary(unKey);
+        
+        LinkTimer.stop();
+        INFO_MSG("Shader Program", "Successfully linked shader program in " <<
+                 LinkTimer.getTime()*1000.0 << "ms:" << strShaders)
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets directory of program binary cache for all shader programs
+///
+/// \param _strDir Cache directory, empty string disables cache
+///
+////////////////////////////////////////////////////////////////////////////////
+void CShaderProgram::setCacheDirectory(const std::string& _strDir)
+{
+    METHOD_ENTRY("CShaderProgram::setCacheDirectory")
+    
+    s_strCacheDir = _strDir;
+    if (s_strCacheDir != "" && s_strCacheDir.back() != '/') s_strCacheDir += "/";
+    DOM_FIO(INFO_MSG("Shader Program", "Using program binary cache directory " << s_strCacheDir))
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns key of program binary cache
+///
+/// The key is a hash (FNV-1a) of all shaders and the driver, since binaries
+/// are only valid for the driver they were created with.
+///
+/// \return Key of program binary cache
+///
+////////////////////////////////////////////////////////////////////////////////
+std::uint64_t CShaderProgram::getCacheKey() const
+{
+    METHOD_ENTRY("CShaderProgram::getCacheKey")
+    
+    std::string strDriver;
+    for (const auto Name : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+    {
+        const GLubyte* pchName = glGetString(Name);
+        if (pchName != nullptr) strDriver += reinterpret_cast<const char*>(pchName);
+    }
+    
+    std::uint64_t unKey = fnv1a(strDriver.data(), strDriver.size());
+    for (const auto pShader : Shaders)
+    {
+        unKey = fnv1aCombine(unKey, pShader->getHash());
+    }
+    return unKey;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns filename of program binary cache for given key
+///
+/// \param _unKey Key of program binary cache
+///
+/// \return Filename including cache directory
+///
+////////////////////////////////////////////////////////////////////////////////
+const std::string CShaderProgram::getCacheFile(const std::uint64_t _unKey) const
+{
+    METHOD_ENTRY("CShaderProgram::getCacheFile")
+    
+    std::ostringstream oss;
+    oss << s_strCacheDir << std::hex << std::setw(16) << std::setfill('0')
+        << _unKey << ".program";
+    return oss.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Restores program from binary cache
+///
+/// \param _unKey Key of program binary cache
+///
+/// \return Success?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool CShaderProgram::loadBinary(const std::uint64_t _unKey)
+{
+    METHOD_ENTRY("CShaderProgram::loadBinary")
+    
+    if (s_strCacheDir == "") return false;
+    
+    GLint nNrOfFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &nNrOfFormats);
+    if (nNrOfFormats == 0) return false;
+    
+    const std::string strFile = this->getCacheFile(_unKey);
+    
+    std::ifstream InStream(strFile, std::ios::in|std::ios::binary|std::ios::ate);
+    if (!InStream.is_open()) return false;
+    const std::streamoff nFileSize = InStream.tellg();
+    InStream.seekg(0, std::ios::beg);
+    
+    // Length is checked against file size before allocating, so corrupt
+    // files fall back to compilation
+    ShaderProgramCacheHeader Header;
+    InStream.read(reinterpret_cast<char*>(&Header), sizeof(ShaderProgramCacheHeader));
+    if (!InStream ||
+        Header.unMagic != SHADER_PROGRAM_CACHE_MAGIC ||
+        Header.unVersion != SHADER_PROGRAM_CACHE_VERSION ||
+        Header.unKey != _unKey ||
+        std::streamoff(Header.unLength) > nFileSize - std::streamoff(sizeof(ShaderProgramCacheHeader)))
+    {
+        DOM_FIO(NOTICE_MSG("Shader Program", "Program binary cache " << strFile << " invalid, compiling."))
+        return false;
+    }
+    std::vector<char> vecBinary(Header.unLength);
+    InStream.read(vecBinary.data(), Header.unLength);
+    if (!InStream)
+    {
+        DOM_FIO(NOTICE_MSG("Shader Program", "Program binary cache " << strFile << " incomplete, compiling."))
+        return false;
     }
+    InStream.close();
+    
+    glProgramBinary(m_unID, Header.unFormat, vecBinary.data(), Header.unLength);
+    
+    // Drivers may reject binaries, e.g. after update, hence, fall back to
+    // compilation of source
+    GLint nIsLinked = 0;
+    glGetProgramiv(m_unID, GL_LINK_STATUS, &nIsLinked);
+    if (nIsLinked == GL_FALSE)
+    {
+        DOM_FIO(NOTICE_MSG("Shader Program", "Program binary cache " << strFile << " rejected by driver, compiling."))
+        return false;
+    }
+    
+    DOM_FIO(DEBUG_MSG("Shader Program", "Program binary loaded from cache " << strFile))
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Writes linked program to binary cache
+///
+/// \param _unKey Key of program binary cache
+///
+/// \return Success?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool CShaderProgram::saveBinary(const std::uint64_t _unKey) const
+{
+    METHOD_ENTRY("CShaderProgram::saveBinary")
+    
+    if (s_strCacheDir == "") return false;
+    
+    GLint nLength = 0;
+    glGetProgramiv(m_unID, GL_PROGRAM_BINARY_LENGTH, &nLength);
+    if (nLength <= 0) return false;
+    
+    ShaderProgramCacheHeader Header;
+    std::vector<char> vecBinary(nLength);
+    GLenum Format = 0;
+    glGetProgramBinary(m_unID, nLength, &nLength, &Format, vecBinary.data());
+    Header.unKey = _unKey;
+    Header.unFormat = Format;
+    Header.unLength = nLength;
+    
+    const std::string strFile = this->getCacheFile(_unKey);
+    
+    std::ofstream OutStream(strFile, std::ios::out|std::ios::binary|std::ios::trunc);
+    if (!OutStream.is_open())
+    {
+        DOM_FIO(WARNING_MSG("Shader Program", "Could not write program binary cache " << strFile << "."))
+        return false;
+    }
+    OutStream.write(reinterpret_cast<const char*>(&Header), sizeof(ShaderProgramCacheHeader));
+    OutStream.write(vecBinary.data(), nLength);
+    OutStream.close();
+    
+    DOM_FIO(DEBUG_MSG("Shader Program", "Program binary written to cache " << strFile))
+    
     return true;
 }
@@ -50,10 +50,29 @@
 namespace bfe
 {
 
+constexpr std::uint32_t SHADER_PROGRAM_CACHE_MAGIC = 0x50485342u;  ///< Magic number of program binary cache files ("BSHP")
+constexpr std::uint32_t SHADER_PROGRAM_CACHE_VERSION = 1u;         ///< Version of program binary cache file format
+
+// Structure of program binary cache file header. It is followed by the
+// program binary.
+struct ShaderProgramCacheHeader
+{
+    std::uint32_t unMagic = SHADER_PROGRAM_CACHE_MAGIC;     ///< Magic number, identifying cache files
+    std::uint32_t unVersion = SHADER_PROGRAM_CACHE_VERSION; ///< Version of file format
+    std::uint64_t unKey = 0u;                               ///< Hash of shader sources and driver
+    std::uint32_t unFormat = 0u;                            ///< Binary format, driver specific
+    std::uint32_t unLength = 0u;                            ///< Length of program binary
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Class representing a vertex or fragment shader
 ///
+/// If a cache directory is set, linked programs are stored as driver specific
+/// binary, keyed by the hash of all shader sources and the driver. On next
+/// start, the binary is restored without compiling and linking. If the driver
+/// rejects the binary, the program is compiled from source.
+///
 ////////////////////////////////////////////////////////////////////////////////
 class CShaderProgram
 {
@@ -71,14 +90,24 @@ class CShaderProgram
         void create();
         void create(const CShader&, const CShader&);
         bool link();
+        
+        static void setCacheDirectory(const std::string&);
                 
         //--- friends --------------------------------------------------------//
 
     private:
         
+        //--- Methods [private] ----------------------------------------------//
+        std::uint64_t       getCacheKey() const;
+        const std::string   getCacheFile(const std::uint64_t) const;
+        bool                loadBinary(const std::uint64_t);
+        bool                saveBinary(const std::uint64_t) const;
+        
         //--- Variables [protected] ------------------------------------------//
-        GLuint m_unID = 0;           // ID of shader program
-        std::vector<GLuint> Shaders; // Shaders attached to program
+        GLuint m_unID = 0;              // ID of shader program
+        std::vector<const CShader*> Shaders;  // Shaders attached to program
+        
+        static std::string s_strCacheDir; ///< Directory of program binary cache, empty if disabled
 };
 
 //--- Implementation is done here for inline optimisation --------------------//
@@ -111,14 +140,17 @@ inline void CShaderProgram::use() const
 ///
 /// \brief Adds given shader to shader program
 ///
+/// The shader is attached when linking, since it is only compiled if the
+/// program isn't restored from binary cache. Hence, it has to be valid
+/// until \ref link is called.
+///
 /// \param _Shader Shader to be added to program
 ///
 ////////////////////////////////////////////////////////////////////////////////
 inline void CShaderProgram::addShader(const CShader& _Shader)
 {
     METHOD_ENTRY("CShaderProgram::addShader")
-    glAttachShader(m_unID, _Shader.getID());
-    Shaders.push_back(_Shader.getID());
+    Shaders.push_back(&_Shader);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
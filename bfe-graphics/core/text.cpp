@@ -50,6 +50,7 @@ CText::CText(CFontManager* const _pFontManager) : CGraphicsBase(),
                   m_nWordWrap(FONT_MGR_NO_WORD_WRAP),
                   m_bCentered(false),
                   m_bNewState(true),
+                  m_unRevision(0u),
                   m_strFont(FONT_MGR_FONT_DEFAULT),
                   m_strText(""),
                   m_pFontManager(_pFontManager) 
@@ -83,6 +84,7 @@ void CText::addTextPart(const std::string& _strText)
     m_PartsTexts.push_back(_strText);
     
     m_strText += _strText;
+    ++m_unRevision;
     
     DOM_DEV(DomDevTextNoFont:)
 }
@@ -101,6 +103,7 @@ void CText::clearText()
     m_PartsSizes.clear();
     m_PartsTexts.clear();
     m_strText.clear();
+    ++m_unRevision;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -191,6 +194,7 @@ void CText::setColor(const TextPartType _TextPart, const ColorTypeRGBA& _Color)
     if (m_PartsColors.size() > _TextPart)
     {
         m_PartsColors[_TextPart] = _Color;
+        ++m_unRevision;
     }
     else
     {
@@ -210,6 +214,7 @@ void CText::setFont(const std::string& _strFont)
     METHOD_ENTRY("CText::setFont")
     m_strFont = _strFont;
     m_bNewState = true;
+    ++m_unRevision;
     
     // Set font in font manager. This is usually done before rendering, but 
     // here, it ensures that the font manager rasterises a new font if not
@@ -240,6 +245,7 @@ void CText::setFont(const TextPartType _TextPart, const std::string& _strFont)
     }
 
     m_bNewState = true;
+    ++m_unRevision;
     m_pFontManager->setFont(_strFont);  // See setFont for explanation why to set font here
 }
 
@@ -255,6 +261,7 @@ void CText::setSize(const int _nSize)
     METHOD_ENTRY("CText::setSize")
     m_nSize = _nSize;
     m_bNewState = true;
+    ++m_unRevision;
     
     // Set font size in font manager. This is usually done before rendering, but 
     // here, it ensures that the font manager rasterises a new font size if not
@@ -284,6 +291,7 @@ void CText::setSize(const TextPartType _TextPart, const int _nSize)
     }
     
     m_bNewState = true;
+    ++m_unRevision;
     m_pFontManager->setSize(_nSize); // See setSize for explanation why to set size here
 }
 
@@ -302,9 +310,15 @@ void CText::setPosition(const float& _fPosX, const float& _fPosY, const bool _bC
 {
     METHOD_ENTRY("CText::setPosition")
     
-    m_fPosX = _fPosX;
-    m_fPosY = _fPosY + m_nSize;
-    m_bCentered = _bCentered;
+    // Only count as modification if position really changed, since position
+    // is usually set on every frame before displaying
+    if (m_fPosX != _fPosX || m_fPosY != _fPosY + m_nSize || m_bCentered != _bCentered)
+    {
+        m_fPosX = _fPosX;
+        m_fPosY = _fPosY + m_nSize;
+        m_bCentered = _bCentered;
+        ++m_unRevision;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -332,6 +346,7 @@ void CText::setText(const std::string& _strText)
         }
     )
     m_bNewState = true;
+    ++m_unRevision;
     
     DOM_DEV(DomDevTextNoFont:)
 }
@@ -365,6 +380,7 @@ void CText::setText(const TextPartType _TextPart, const std::string& _strText)
     }
     
     m_bNewState = true;
+    ++m_unRevision;
     
     DOM_DEV(DomDevTextNoFont:)
 }
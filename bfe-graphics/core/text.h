@@ -32,6 +32,7 @@
 #define TEXT_H
 
 //--- Standard header --------------------------------------------------------//
+#include <cstdint>
 
 //--- Program header ---------------------------------------------------------//
 #include "font_manager.h"
@@ -76,7 +77,10 @@ class CText : virtual public CGraphicsBase
         CText(bfe::CFontManager* const _pFontManager);
 
         //--- Constant Methods -----------------------------------------------//
+        const ColorTypeRGBA& getColor() const {return m_Color;}
+        const std::string&  getFont() const {return m_strFont;}
         int                 getFontSize() const {return m_nSize;}
+        std::uint32_t       getRevision() const {return m_unRevision;}
         
         //--- Methods --------------------------------------------------------//
         void addTextPart(const std::string&);
@@ -85,7 +89,7 @@ class CText : virtual public CGraphicsBase
         
         float getLength();
         
-        void setColor(const ColorTypeRGBA& _Color) {m_Color = _Color;}
+        void setColor(const ColorTypeRGBA& _Color) {m_Color = _Color; ++m_unRevision;}
         void setColor(const TextPartType, const ColorTypeRGBA&);
         void setFont(const std::string&);
         void setFont(const TextPartType, const std::string&);
@@ -95,7 +99,10 @@ class CText : virtual public CGraphicsBase
         void setPosition(const float& _fPosX, const float& _fPosY, const bool _bCentered = false);
         void setText(const std::string&);
         void setText(const TextPartType, const std::string&);
-        void setWordWrap(const int _nWordWrap) {m_nWordWrap = _nWordWrap;}
+        void setWordWrap(const int _nWordWrap)
+        {
+            if (m_nWordWrap != _nWordWrap) {m_nWordWrap = _nWordWrap; ++m_unRevision;}
+        }
                 
         //--- friends --------------------------------------------------------//
 
@@ -116,6 +123,7 @@ class CText : virtual public CGraphicsBase
         int             m_nWordWrap;    ///< Word wrap (px)
         bool            m_bCentered;    ///< Center Text to position
         bool            m_bNewState;    ///< Indicates, if there's a parameter change
+        std::uint32_t   m_unRevision;   ///< Modification counter, e.g. to detect if redraw is needed
         std::string     m_strFont;      ///< Name of font to use
         std::string     m_strText;      ///< Text to display
         
@@ -0,0 +1,328 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       perf_hud.cpp
+/// \brief      Implementation of class "CPerfHUD"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-14
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "perf_hud.h"
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <sstream>
+
+using namespace bfe;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor, registering statistics of graphics
+///
+/// \param _pFontManager Font manager to use for drawing
+///
+////////////////////////////////////////////////////////////////////////////////
+CPerfHUD::CPerfHUD(CFontManager* const _pFontManager) : IFontUser(_pFontManager)
+{
+    METHOD_ENTRY("CPerfHUD::CPerfHUD")
+    CTOR_CALL("CPerfHUD::CPerfHUD")
+
+    this->addStats(&m_Graphics.getStatsFrameTime());
+    this->addStats(&m_Graphics.getStatsSubmitTime());
+    this->addStats(&m_Graphics.getStatsVertices());
+    this->addStats(&m_Graphics.getStatsUploadBytes());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns statistics of given name
+///
+/// \param _strName Name of statistics
+///
+/// \return Statistics, nullptr if not registered
+///
+////////////////////////////////////////////////////////////////////////////////
+const CFrameStats* CPerfHUD::getStats(const std::string& _strName) const
+{
+    METHOD_ENTRY("CPerfHUD::getStats")
+
+    std::vector<const CFrameStats*> Stats;
+    this->collectStats(Stats);
+    for (const auto pStats : Stats)
+    {
+        if (pStats->getName() == _strName) return pStats;
+    }
+    return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns raw sample history of all statistics
+///
+/// Each line starts with the name of the statistics, followed by its samples
+/// separated by blanks, oldest first.
+///
+/// \return Sample history as string
+///
+////////////////////////////////////////////////////////////////////////////////
+std::string CPerfHUD::getStatsSamples() const
+{
+    METHOD_ENTRY("CPerfHUD::getStatsSamples")
+
+    std::vector<const CFrameStats*> Stats;
+    this->collectStats(Stats);
+
+    std::ostringstream oss;
+    std::vector<double> Samples;
+    for (const auto pStats : Stats)
+    {
+        pStats->getSamples(Samples);
+        oss << pStats->getName() << ":";
+        for (const auto fSample : Samples) oss << " " << fSample;
+        oss << "\n";
+    }
+    return oss.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns summary of all statistics
+///
+/// Each line holds name, unit, number of samples, mean, p50, p95, p99 and
+/// maximum of a statistics, separated by blanks.
+///
+/// \return Summary as string
+///
+////////////////////////////////////////////////////////////////////////////////
+std::string CPerfHUD::getStatsSummary() const
+{
+    METHOD_ENTRY("CPerfHUD::getStatsSummary")
+
+    std::vector<const CFrameStats*> Stats;
+    this->collectStats(Stats);
+
+    std::ostringstream oss;
+    for (const auto pStats : Stats)
+    {
+        oss << pStats->getName() << ": "
+            << "unit="  << (pStats->getUnit() == "" ? "-" : pStats->getUnit())
+            << " n="    << pStats->getNrOfSamples()
+            << " mean=" << pStats->getMean()
+            << " p50="  << pStats->getPercentile(50.0)
+            << " p95="  << pStats->getPercentile(95.0)
+            << " p99="  << pStats->getPercentile(99.0)
+            << " max="  << pStats->getMax() << "\n";
+    }
+    return oss.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds statistics to be displayed and exported
+///
+/// \param _pStats Statistics, e.g. of a thread module
+///
+////////////////////////////////////////////////////////////////////////////////
+void CPerfHUD::addStats(const CFrameStats* const _pStats)
+{
+    METHOD_ENTRY("CPerfHUD::addStats")
+
+    if (_pStats == nullptr)
+    {
+        WARNING_MSG("Performance HUD", "Invalid statistics, not added.")
+        return;
+    }
+    if (std::find(m_Stats.begin(), m_Stats.end(), _pStats) == m_Stats.end())
+    {
+        m_Stats.push_back(_pStats);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Draws all statistics as graphs in screen space, if visible
+///
+////////////////////////////////////////////////////////////////////////////////
+void CPerfHUD::draw()
+{
+    METHOD_ENTRY("CPerfHUD::draw")
+
+    if (!m_bVisible) return;
+
+    m_Graphics.setupScreenSpace();
+
+    this->collectStats(m_StatsDrawn);
+
+    int nPosY = m_nPosY;
+    for (const auto pStats : m_StatsDrawn)
+    {
+        this->drawGraph(pStats, m_nPosX, nPosY);
+        nPosY += PERF_HUD_GRAPH_HEIGHT + PERF_HUD_FONT_SIZE + PERF_HUD_MARGIN;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Collects registered statistics and GPU times of graphics
+///
+/// GPU times are only available if the GPU timer of the graphics is enabled.
+/// They are created on first use of a render mode or pass, hence, they are
+/// collected on each call.
+///
+/// \param _Stats Vector to store statistics to
+///
+////////////////////////////////////////////////////////////////////////////////
+void CPerfHUD::collectStats(std::vector<const CFrameStats*>& _Stats) const
+{
+    METHOD_ENTRY("CPerfHUD::collectStats")
+
+    _Stats = m_Stats;
+    m_Graphics.getStatsGPUTimes(_Stats);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Draws graph of a single statistics with label
+///
+/// The graph is scaled to the maximum sample of the history. The 95th
+/// percentile is marked by a horizontal line.
+///
+/// \param _pStats Statistics to draw
+/// \param _nX Horizontal position of label
+/// \param _nY Vertical position of label
+///
+////////////////////////////////////////////////////////////////////////////////
+void CPerfHUD::drawGraph(const CFrameStats* const _pStats, const int _nX, const int _nY)
+{
+    METHOD_ENTRY("CPerfHUD::drawGraph")
+
+    _pStats->getSamples(m_Samples);
+
+    const double fP50 = _pStats->getPercentile(50.0);
+    const double fP95 = _pStats->getPercentile(95.0);
+    const double fP99 = _pStats->getPercentile(99.0);
+    double fMax = 0.0;
+    for (const auto fSample : m_Samples) fMax = std::max(fMax, fSample);
+    if (fMax <= 0.0) fMax = 1.0;
+
+    const int nTop = _nY + PERF_HUD_FONT_SIZE;
+    const int nBottom = nTop + PERF_HUD_GRAPH_HEIGHT;
+    const double fScaleX = double(PERF_HUD_GRAPH_WIDTH) / std::max(1, int(m_Samples.size())-1);
+    const double fScaleY = PERF_HUD_GRAPH_HEIGHT / fMax;
+
+    m_Graphics.beginRenderBatch("world");
+
+        m_Graphics.setColor(0.0, 0.0, 0.0, 0.5);
+        m_Graphics.filledRect(Vector2d(_nX, nTop), Vector2d(_nX+PERF_HUD_GRAPH_WIDTH, nBottom));
+
+        m_Graphics.setColor(1.0, 0.3, 0.3, 0.8);
+        m_Graphics.beginLine(PolygonType::LINE_SINGLE);
+            m_Graphics.addVertex(_nX, nBottom - fP95*fScaleY);
+            m_Graphics.addVertex(_nX+PERF_HUD_GRAPH_WIDTH, nBottom - fP95*fScaleY);
+        m_Graphics.endLine();
+
+        if (m_Samples.size() > 1)
+        {
+            m_Graphics.setColor(0.3, 1.0, 0.3, 1.0);
+            m_Graphics.beginLine(PolygonType::LINE_STRIP);
+                for (auto i=0u; i<m_Samples.size(); ++i)
+                {
+                    m_Graphics.addVertex(_nX + i*fScaleX, nBottom - m_Samples[i]*fScaleY);
+                }
+            m_Graphics.endLine();
+        }
+
+        m_Graphics.setColor(1.0, 1.0, 1.0, 1.0);
+
+    m_Graphics.endRenderBatch();
+
+    // Times are displayed in ms for readability
+    double fFactor = 1.0;
+    std::string strUnit = _pStats->getUnit();
+    if (strUnit == "s")
+    {
+        fFactor = 1000.0;
+        strUnit = "ms";
+    }
+
+    std::ostringstream oss;
+    oss.precision(3);
+    oss << _pStats->getName() << "  p50: " << fP50*fFactor
+                              << "  p95: " << fP95*fFactor
+                              << "  p99: " << fP99*fFactor << " " << strUnit;
+
+    m_Graphics.beginRenderBatch("font");
+        m_pFontManager->setSize(PERF_HUD_FONT_SIZE);
+        m_pFontManager->drawText(oss.str(), _nX, _nY);
+    m_Graphics.endRenderBatch();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Initialise the command interface
+///
+////////////////////////////////////////////////////////////////////////////////
+void CPerfHUD::myInitComInterface()
+{
+    METHOD_ENTRY("CPerfHUD::myInitComInterface")
+
+    INFO_MSG("Performance HUD", "Initialising com interace.")
+
+    m_pComInterface->registerFunction("toggle_perf_hud",
+                                      CCommand<void>([&](){this->toggle();}),
+                                      "Toggles performance overlay, showing frame statistics.",
+                                      {{ParameterType::NONE, "No return value"}},
+                                      "system");
+    m_pComInterface->registerFunction("set_gpu_timer",
+                                      CCommand<void, bool>([&](const bool _bGPUTimer){m_Graphics.setGPUTimer(_bGPUTimer);}),
+                                      "Enables or disables measurement of GPU time per render mode using timer queries.",
+                                      {{ParameterType::NONE, "No return value"},
+                                       {ParameterType::BOOL, "Enable GPU timer?"}},
+                                      "system");
+    m_pComInterface->registerFunction("get_frame_stats",
+                                      CCommand<std::string>([&]() -> std::string {return this->getStatsSummary();}),
+                                      "Provides mean, percentiles (p50, p95, p99) and maximum of all frame statistics, one line each.",
+                                      {{ParameterType::STRING, "Summary of frame statistics"}},
+                                      "system");
+    m_pComInterface->registerFunction("get_frame_stats_percentile",
+                                      CCommand<double, std::string, double>([&](const std::string& _strName, const double _fPercent) -> double
+                                      {
+                                          const CFrameStats* pStats = this->getStats(_strName);
+                                          if (pStats == nullptr)
+                                          {
+                                              throw CComInterfaceException(ComIntExceptionType::INVALID_VALUE);
+                                          }
+                                          return pStats->getPercentile(_fPercent);
+                                      }),
+                                      "Provides percentile of given frame statistics.",
+                                      {{ParameterType::DOUBLE, "Percentile"},
+                                       {ParameterType::STRING, "Name of frame statistics"},
+                                       {ParameterType::DOUBLE, "Percent, e.g. 95.0"}},
+                                      "system");
+    m_pComInterface->registerFunction("get_frame_stats_samples",
+                                      CCommand<std::string>([&]() -> std::string {return this->getStatsSamples();}),
+                                      "Provides raw sample history of all frame statistics, one line each, oldest first.",
+                                      {{ParameterType::STRING, "Sample history of frame statistics"}},
+                                      "system");
+}
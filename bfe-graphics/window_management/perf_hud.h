@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       perf_hud.h
+/// \brief      Prototype of class "CPerfHUD"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-14
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PERF_HUD_H
+#define PERF_HUD_H
+
+//--- Standard header --------------------------------------------------------//
+#include <string>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "com_interface_provider.h"
+#include "font_user.h"
+#include "frame_stats.h"
+#include "graphics.h"
+
+//--- Misc header ------------------------------------------------------------//
+
+/// BFEngine namespace
+namespace bfe
+{
+
+//--- Constants --------------------------------------------------------------//
+constexpr int PERF_HUD_FONT_SIZE = 12;      ///< Font size of labels
+constexpr int PERF_HUD_GRAPH_HEIGHT = 40;   ///< Height of a single graph
+constexpr int PERF_HUD_GRAPH_WIDTH = 256;   ///< Width of a single graph
+constexpr int PERF_HUD_MARGIN = 10;         ///< Margin to screen border and between graphs
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Performance overlay showing frame statistics as graphs
+///
+/// The HUD displays the sample history of all registered frame statistics,
+/// i.e. processing time of thread modules or render statistics of the
+/// graphics, together with their percentiles. Statistics of the graphics
+/// are registered by default, GPU times per render mode are added if the
+/// GPU timer of the graphics is enabled. The HUD is toggled and the raw data
+/// exported using the com interface.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CPerfHUD : virtual public CGraphicsBase,
+                 public IComInterfaceProvider,
+                 public IFontUser
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CPerfHUD() = delete;
+        CPerfHUD(CFontManager* const);
+
+        //--- Constant Methods -----------------------------------------------//
+        const CFrameStats*  getStats(const std::string&) const;
+        std::string         getStatsSamples() const;
+        std::string         getStatsSummary() const;
+        bool                isVisible() const {return m_bVisible;}
+
+        //--- Methods --------------------------------------------------------//
+        void addStats(const CFrameStats* const);
+        void draw();
+        void setPosition(const int _nX, const int _nY) {m_nPosX = _nX; m_nPosY = _nY;}
+        void toggle() {m_bVisible ^= true;}
+
+    private:
+
+        //--- Methods [private] ----------------------------------------------//
+        void collectStats(std::vector<const CFrameStats*>&) const;
+        void drawGraph(const CFrameStats* const, const int, const int);
+        void myInitComInterface() override;
+
+        //--- Variables [private] --------------------------------------------//
+        std::vector<const CFrameStats*> m_Stats;    ///< Statistics displayed by the HUD
+        std::vector<const CFrameStats*> m_StatsDrawn; ///< Temporary buffer of statistics for drawing
+        std::vector<double> m_Samples;              ///< Temporary buffer of samples for drawing
+
+        bool    m_bVisible = false;                 ///< Indicates if HUD is drawn
+        int     m_nPosX = PERF_HUD_MARGIN;          ///< Horizontal position of HUD on screen
+        int     m_nPosY = PERF_HUD_MARGIN;          ///< Vertical position of HUD on screen
+};
+
+} // namespace bfe
+
+#endif // PERF_HUD_H
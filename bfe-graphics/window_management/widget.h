@@ -77,6 +77,7 @@ class IWidget : public IFontUser,
         
         //--- Constant methods -----------------------------------------------//
         virtual void draw() = 0;
+        virtual bool isDirty() const {return true;} ///< Content changed since last draw? Always redraw by default
         
         WidgetTypeType getType() const {return m_Type;}
 
@@ -96,18 +96,63 @@ void CWidgetCam::draw()
         })
     
     m_pUIDVisuals->draw(m_nFramePosX, m_nFramePosY, "Widget Camera", m_UID.getValue());
-    if (m_hCamera.isValid())
     {
-        m_pUIDVisuals->draw(m_nFramePosX, m_nFramePosY + m_pUIDVisuals->UIDText.getFontSize(), "Camera", m_hCamera->getUID());
+        const UIDType nUIDCamera = m_nUIDCamera.load(std::memory_order_relaxed);
+        if (nUIDCamera != 0u)
+        {
+            m_pUIDVisuals->draw(m_nFramePosX, m_nFramePosY + m_pUIDVisuals->UIDText.getFontSize(), "Camera", nUIDCamera);
+        }
     }
     
     DOM_DEV(DomDev:)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Attaches camera to this widget, called by writer of render packets
+///
+/// \param _pCamera Camera to be attached
+///
+////////////////////////////////////////////////////////////////////////////////
+void CWidgetCam::setCamera(CCamera* const _pCamera)
+{
+    METHOD_ENTRY("CWidgetCam::setCamera")
+
+    m_hCamera.update(_pCamera);
+    m_nUIDCamera.store(_pCamera != nullptr ? _pCamera->getUID() : 0u, std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Updates attached camera, called by writer of render packets
+///
+/// The viewport of the camera is adjusted to the latest size of the render
+/// target. If the camera was removed, it is no longer drawn.
+///
+////////////////////////////////////////////////////////////////////////////////
+void CWidgetCam::updateCamera()
+{
+    METHOD_ENTRY("CWidgetCam::updateCamera")
+
+    if (!m_hCamera.isValid())
+    {
+        m_nUIDCamera.store(0u, std::memory_order_relaxed);
+        return;
+    }
+    if (m_ViewportsCam.update())
+    {
+        const Vector2d& vecViewport = m_ViewportsCam.getReadBuffer();
+        m_hCamera->setViewport(vecViewport[0], vecViewport[1]);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Resizes render target
 ///
+/// The camera viewport is handed over to the writer of render packets, see
+/// \ref updateCamera.
+///
 /// \param _nX New size X
 /// \param _nY New size Y
 ///
@@ -118,8 +163,7 @@ void CWidgetCam::myResize(const int _nX, const int _nY)
 
     m_TargetCam.init(_nX, _nY);
     m_RenderMode.setTexture0("ScreenTexture", m_TargetCam.getIDTex());
-    if (m_hCamera.isValid())
-    {
-        m_hCamera->setViewport(double(_nX) / GRAPHICS_PX_PER_METER, double(_nY) / GRAPHICS_PX_PER_METER);
-    }
+    
+    m_ViewportsCam.getWriteBuffer() = Vector2d(double(_nX) / GRAPHICS_PX_PER_METER, double(_nY) / GRAPHICS_PX_PER_METER);
+    m_ViewportsCam.publish();
 }
@@ -31,11 +31,13 @@
 #define WIDGET_CAM_H
 
 //--- Standard header --------------------------------------------------------//
+#include <atomic>
 
 //--- Program header ---------------------------------------------------------//
 #include "camera.h"
 #include "render_mode.h"
 #include "render_target.h"
+#include "triple_buffer.h"
 #include "visuals_data_storage_user.h"
 #include "widget.h"
 
@@ -45,6 +47,11 @@
 ///
 /// \brief Defines a camera widget, using render to texture to display a scene
 ///
+/// The camera is a simulation object, hence, it is only accessed by the
+/// writer of render packets (see \ref updateCamera). Drawing uses the
+/// camera UID taken over from there, resizing hands the viewport over to
+/// the writer.
+///
 ////////////////////////////////////////////////////////////////////////////////
 class CWidgetCam : public IWidget,
                    public IVisualsDataStorageUser
@@ -66,7 +73,8 @@ class CWidgetCam : public IWidget,
         CRenderTarget* getRenderTarget() {return &m_TargetCam;}
         
         void draw() override;
-        void setCamera(CCamera* const _pCamera) {m_hCamera.update(_pCamera);}
+        void setCamera(CCamera* const);
+        void updateCamera();
         void setShaderProgram(CShaderProgram* const _pShaderProgram) 
         {
             METHOD_ENTRY("CWidgetCam::setShaderProgram")
@@ -85,7 +93,9 @@ class CWidgetCam : public IWidget,
         void myResize(const int, const int) override;
         
         //--- Variables [private] --------------------------------------------//
-        CHandle<CCamera> m_hCamera;         ///< Camera attached to this widget
+        CHandle<CCamera>        m_hCamera;      ///< Camera attached to this widget, accessed by writer only
+        std::atomic<UIDType>    m_nUIDCamera{0u}; ///< UID of attached camera for drawing, 0 if none
+        CTripleBuffer<Vector2d> m_ViewportsCam; ///< Viewports of render target, handed over to camera
         
         CRenderMode     m_RenderMode;       ///< Render mode to use for rendering
         CRenderTarget   m_TargetCam;        ///< Rendertarget for virtual camera
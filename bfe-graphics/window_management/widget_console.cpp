@@ -30,6 +30,9 @@
 
 #include "widget_console.h"
 
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+
 using namespace bfe;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -42,7 +45,10 @@ using namespace bfe;
 CWidgetConsole::CWidgetConsole(CFontManager* const _pFontManager) :
                                IWidget(_pFontManager),
                                ConsoleText(_pFontManager),
-                               m_nComHistoryVisible(10)
+                               m_pComConsole(nullptr),
+                               m_nComHistoryVisible(10),
+                               m_unCommandCount(0u),
+                               m_unTextRevision(0u)
 {
     METHOD_ENTRY("CWidgetConsole::CWidgetConsole");
     CTOR_CALL("CWidgetConsole::CWidgetConsole");
@@ -53,6 +59,25 @@ CWidgetConsole::CWidgetConsole(CFontManager* const _pFontManager) :
     ConsoleText.setText(m_UID.getName());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns if console content changed since last draw
+///
+/// \return Content changed?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool CWidgetConsole::isDirty() const
+{
+    METHOD_ENTRY("CWidgetConsole::isDirty")
+    
+    if (m_pComConsole == nullptr) return false;
+    
+    return (m_pComConsole->getCommandCount() != m_unCommandCount ||
+            ConsoleText.getRevision() != m_unTextRevision ||
+            m_nComHistoryVisible != m_nFrameHeight / ConsoleText.getFontSize() - 1 ||
+            this->getEditLine() != m_strEditLine);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Draw this widget
@@ -66,29 +91,81 @@ void CWidgetConsole::draw()
         this->drawFrame();
     m_Graphics.endRenderBatch();
     
-    m_nComHistoryVisible = m_nFrameHeight / ConsoleText.getFontSize() - 1;
-
-    std::stringstream oss;
-    auto i = m_pComConsole->getCommands().size() - m_nComHistoryVisible;
-    if (i > m_pComConsole->getCommands().size()) i = 0;
-    while (i < m_pComConsole->getCommands().size())
-    {
-        oss << "> " << m_pComConsole->getCommands().at(i);
-        if (m_pComConsole->getReturnValues().at(i) != "")
+    DOM_DEV(
+        if (m_pComConsole == nullptr)
         {
-            oss << " => " << m_pComConsole->getReturnValues().at(i);
+            WARNING_MSG("Console Widget", "Command console not set.")
+            return;
         }
-        oss << "\n";
+    )
+    
+    const CommandBufferType& Commands = m_pComConsole->getCommands();
+    const CommandBufferType& RetVals  = m_pComConsole->getReturnValues();
+    
+    //--------------------------------------------------------------------------
+    // Invalidate all cached layouts if text properties or visible part of
+    // history changed. All visible history lines will then be treated as new.
+    //--------------------------------------------------------------------------
+    int nComHistoryVisible = m_nFrameHeight / ConsoleText.getFontSize() - 1;
+    if (nComHistoryVisible < 0) nComHistoryVisible = 0;
+    if (ConsoleText.getRevision() != m_unTextRevision ||
+        nComHistoryVisible != m_nComHistoryVisible)
+    {
+        m_HistoryLayouts.clear();
+        m_strEditLine.clear();
+        m_unCommandCount = m_pComConsole->getCommandCount() - Commands.size();
+        m_unTextRevision = ConsoleText.getRevision();
+        m_nComHistoryVisible = nComHistoryVisible;
+    }
+    
+    //--------------------------------------------------------------------------
+    // Append layouts of new history lines, evict old ones
+    //--------------------------------------------------------------------------
+    std::size_t nVisible = std::min(Commands.size(), std::size_t(m_nComHistoryVisible));
+    std::size_t nNew = m_pComConsole->getCommandCount() - m_unCommandCount;
+    if (nNew > nVisible) nNew = nVisible;
+    
+    if (nNew > 0u)
+    {
+        m_pFontManager->setFont(ConsoleText.getFont());
+        m_pFontManager->setSize(ConsoleText.getFontSize());
         
-        ++i;
+        for (auto i = Commands.size() - nNew; i < Commands.size(); ++i)
+        {
+            std::string strLine = "> " + Commands.at(i);
+            if (RetVals.at(i) != "")
+            {
+                strLine += " => " + RetVals.at(i);
+            }
+            m_HistoryLayouts.emplace_back();
+            m_pFontManager->layoutText(strLine, m_HistoryLayouts.back());
+        }
+    }
+    while (m_HistoryLayouts.size() > nVisible) m_HistoryLayouts.pop_front();
+    m_unCommandCount = m_pComConsole->getCommandCount();
+    
+    //--------------------------------------------------------------------------
+    // Re-layout edit line only if changed (i.e. on key strokes)
+    //--------------------------------------------------------------------------
+    std::string strEditLine = this->getEditLine();
+    if (strEditLine != m_strEditLine)
+    {
+        m_pFontManager->setFont(ConsoleText.getFont());
+        m_pFontManager->setSize(ConsoleText.getFontSize());
+        m_pFontManager->layoutText(strEditLine, m_EditLineLayout);
+        m_strEditLine = strEditLine;
     }
-    oss << s_ConsoleModeTypeToStringMap[m_pComConsole->getMode()] << " > " << m_pComConsole->getCurrentCommand() << "_";
     
-    ConsoleText.setText(oss.str());
-    ConsoleText.setPosition(m_nFramePosX, m_nFramePosY);
+    m_Graphics.setColor(ConsoleText.getColor());
     
     m_Graphics.beginRenderBatch("font");
-        ConsoleText.display();
+        float fPosY = m_nFramePosY + ConsoleText.getFontSize();
+        for (auto& Layout : m_HistoryLayouts)
+        {
+            m_pFontManager->drawText(Layout, m_nFramePosX, fPosY);
+            fPosY += Layout.nLines * Layout.nSize;
+        }
+        m_pFontManager->drawText(m_EditLineLayout, m_nFramePosX, fPosY);
     m_Graphics.endRenderBatch();
     
     DOM_DEV(
@@ -107,4 +184,3 @@ void CWidgetConsole::draw()
         
     m_Graphics.setColor(1.0, 1.0, 1.0, 1.0);
 }
-
@@ -31,6 +31,8 @@
 #define WIDGET_CONSOLE_H
 
 //--- Standard header --------------------------------------------------------//
+#include <cstdint>
+#include <deque>
 
 //--- Program header ---------------------------------------------------------//
 #include "com_console.h"
@@ -45,6 +47,11 @@ namespace bfe
 ///
 /// \brief Defines a command console widget
 ///
+/// Layouts of history lines are cached. New lines are appended and old ones
+/// evicted as the command history advances, while the edit line is only
+/// re-layouted when changed. Font, size and colour are taken from
+/// \ref ConsoleText.
+///
 ////////////////////////////////////////////////////////////////////////////////
 class CWidgetConsole : public IWidget
 {
@@ -57,6 +64,7 @@ class CWidgetConsole : public IWidget
         ~CWidgetConsole() override {}
         
         //--- Constant methods -----------------------------------------------//
+        bool isDirty() const override;
         
         //--- Methods --------------------------------------------------------//
         void draw() override;
@@ -68,10 +76,17 @@ class CWidgetConsole : public IWidget
     private:
         
         //--- Methods [private] ----------------------------------------------//
+        const std::string getEditLine() const;
         
         //--- Variables [private] --------------------------------------------//
-        CComConsole*    m_pComConsole;          ///< Command console used in this widget
-        int             m_nComHistoryVisible;   ///< Visible part of command history
+        CComConsole*            m_pComConsole;          ///< Command console used in this widget
+        int                     m_nComHistoryVisible;   ///< Visible part of command history
+        
+        std::deque<TextLayout>  m_HistoryLayouts;       ///< Cached layouts of visible history lines
+        TextLayout              m_EditLineLayout;       ///< Cached layout of edit line
+        std::string             m_strEditLine;          ///< Edit line of cached layout
+        std::uint32_t           m_unCommandCount;       ///< Number of commands when history was last updated
+        std::uint32_t           m_unTextRevision;       ///< Revision of console text properties of cached layouts
 };
 
 //--- Implementation is done here for inline optimisation --------------------//
@@ -87,6 +102,23 @@ inline void CWidgetConsole::setComConsole(CComConsole* const _pComConsole)
 {
     METHOD_ENTRY("CWidgetConsole::setComConsole")
     m_pComConsole = _pComConsole;
+    m_HistoryLayouts.clear();
+    m_strEditLine.clear();
+    m_unCommandCount = 0u;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns the edit line, i.e. mode, prompt and current command
+///
+/// \return Edit line
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const std::string CWidgetConsole::getEditLine() const
+{
+    METHOD_ENTRY("CWidgetConsole::getEditLine")
+    return s_ConsoleModeTypeToStringMap[m_pComConsole->getMode()] + " > " +
+           m_pComConsole->getCurrentCommand() + "_";
 }
 
 } // namespace bfe
@@ -41,7 +41,8 @@ using namespace bfe;
 ////////////////////////////////////////////////////////////////////////////////
 CWidgetText::CWidgetText(CFontManager* const _pFontManager) :
                             IWidget(_pFontManager),
-                            Text(_pFontManager)
+                            Text(_pFontManager),
+                            m_unTextRevision(0u)
 {
     METHOD_ENTRY("CWidgetText::CWidgetText");
     CTOR_CALL("CWidgetText::CWidgetText");
@@ -73,6 +74,8 @@ void CWidgetText::draw()
         Text.display();
     m_Graphics.endRenderBatch();
     
+    m_unTextRevision = Text.getRevision();
+    
     DOM_DEV(
         static bool bWarned = false;
         if (m_pUIDVisuals == nullptr)
@@ -56,6 +56,7 @@ class CWidgetText : public IWidget
         ~CWidgetText() override {}
         
         //--- Constant methods -----------------------------------------------//
+        bool isDirty() const override {return Text.getRevision() != m_unTextRevision;}
         
         //--- Methods --------------------------------------------------------//
         void draw() override;
@@ -66,7 +67,9 @@ class CWidgetText : public IWidget
     private:
         
         //--- Methods [private] ----------------------------------------------//
-
+        
+        //--- Variables [private] --------------------------------------------//
+        std::uint32_t m_unTextRevision; ///< Revision of text when last drawn
 };
 
 //--- Implementation is done here for inline optimisation --------------------//
@@ -47,7 +47,12 @@ CWindow::CWindow(CFontManager* const _pFontManager) :
                      m_bVisible(true),
                      m_bClosable(true),
                      m_nSizeClose(10),
-                     m_nSizeResize(10)
+                     m_nSizeResize(10),
+                     m_unTitleRevision(0u),
+                     m_nTargetWidth(0),
+                     m_nTargetHeight(0),
+                     m_bDirty(true),
+                     m_bRetained(false)
 {
     METHOD_ENTRY("CWindow::CWindow");
     CTOR_CALL("CWindow::CWindow");
@@ -55,6 +60,8 @@ CWindow::CWindow(CFontManager* const _pFontManager) :
     m_UID.setName("Win_"+m_UID.getName());
     Title.setText(m_UID.getName());
     Title.setSize(20);
+    
+    m_RenderMode.setRenderModeType(RenderModeType::VERT3COL4TEX2);
 //     m_Title.setFillColor(sf::Color(m_FontColor[0]*255.0,
 //                                    m_FontColor[1]*255.0,
 //                                    m_FontColor[2]*255.0,
@@ -71,6 +78,8 @@ CWindow::~CWindow()
     METHOD_ENTRY("CWindow::~CWindow")
     DTOR_CALL("CWindow::~CWindow")
     
+    m_Graphics.unregisterRenderMode(m_UID.getName());
+    
     if (m_pWidget != nullptr)
     {
         delete m_pWidget;
@@ -148,6 +157,10 @@ void CWindow::center()
 ///
 /// \brief Draw window and its contents
 ///
+/// In retained mode, window content is only redrawn to its render target if
+/// dirty. The cached content is composited as one textured quad. Since the
+/// target holds premultiplied colours, blending is adjusted accordingly.
+///
 ///////////////////////////////////////////////////////////////////////////////
 void CWindow::draw() 
 {
@@ -155,56 +168,137 @@ void CWindow::draw()
     
     if (m_bVisible)
     {
-        m_Graphics.beginRenderBatch("world");
-            // Draw background area
-            this->drawFrame();
-            
-            // Draw title frame
-            if (m_FrameStyle == FrameStyleType::DEFAULT || m_FrameStyle == FrameStyleType::NO_BACKGROUND)
+        if (m_bRetained)
+        {
+            // Render target needs to be initialised within rendering context,
+            // hence, this is done here instead of in myResize
+            if (m_nTargetWidth != m_nFrameWidth || m_nTargetHeight != m_nFrameHeight)
             {
-                m_Graphics.setColor(m_WinColorFG);
-                int nSpacing = Title.getFontSize();
-                m_Graphics.rect(Vector2d(m_nFramePosX, m_nFramePosY+nSpacing),
-                                Vector2d(m_nFramePosX+m_nFrameWidth, m_nFramePosY));
+                if (!m_RenderTarget.init(m_nFrameWidth, m_nFrameHeight))
+                {
+                    WARNING_MSG("Window", "Couldn't create render target, switching to immediate mode.")
+                    m_bRetained = false;
+                    this->drawContent();
+                    return;
+                }
+                m_RenderMode.setTexture0("ScreenTexture", m_RenderTarget.getIDTex());
+                m_nTargetWidth  = m_nFrameWidth;
+                m_nTargetHeight = m_nFrameHeight;
+                m_bDirty = true;
             }
             
-            m_Graphics.setColor(0.7, 0.3, 0.3, 1.0);
-            // Draw close button area
-            if (m_bClosable)
+            if (this->isDirty())
             {
-                m_Graphics.filledRect(Vector2d(m_nFramePosX+m_nFrameWidth-m_nSizeClose, m_nFramePosY),
-                                      Vector2d(m_nFramePosX+m_nFrameWidth,m_nFramePosY+m_nSizeClose));
+                m_RenderTarget.bindScreenSpace(m_nFramePosX, m_nFramePosY, RENDER_TARGET_CLEAR);
+                glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+                    this->drawContent();
+                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                m_RenderTarget.unbindScreenSpace();
+                
+                m_unTitleRevision = Title.getRevision();
+                m_bDirty = false;
             }
             
-            // Draw resize button area
-            m_Graphics.filledRect(Vector2d(m_nFramePosX+m_nFrameWidth-m_nSizeResize,
-                                           m_nFramePosY+m_nFrameHeight-m_nSizeResize),
-                                  Vector2d(m_nFramePosX+m_nFrameWidth, m_nFramePosY+m_nFrameHeight));
-            
+            glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
             m_Graphics.setColor(1.0, 1.0, 1.0, 1.0);
-        m_Graphics.endRenderBatch();
+            m_Graphics.beginRenderBatch(m_UID.getName());
+                m_Graphics.texturedRect(Vector2d(m_nFramePosX, m_nFramePosY+m_nFrameHeight),
+                                        Vector2d(m_nFramePosX+m_nFrameWidth, m_nFramePosY),
+                                        &m_RenderTarget.getTexUV());
+            m_Graphics.endRenderBatch();
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        }
+        else
+        {
+            this->drawContent();
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets shader program for compositing, enables retained mode
+///
+/// The render mode for compositing is only registered while retained mode
+/// is enabled.
+///
+/// \param _pShaderProgram Shader program to display render target texture,
+///                        nullptr switches back to immediate mode
+///
+///////////////////////////////////////////////////////////////////////////////
+void CWindow::setShaderProgram(CShaderProgram* const _pShaderProgram)
+{
+    METHOD_ENTRY("CWindow::setShaderProgram")
+    
+    if (_pShaderProgram != nullptr)
+        m_Graphics.registerRenderMode(m_UID.getName(), &m_RenderMode);
+    else
+        m_Graphics.unregisterRenderMode(m_UID.getName());
+    m_RenderMode.setShaderProgram(_pShaderProgram);
+    m_bRetained = (_pShaderProgram != nullptr);
+    m_nTargetWidth = 0;
+    m_nTargetHeight = 0;
+    m_bDirty = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Draw frame, title and widget of this window
+///
+///////////////////////////////////////////////////////////////////////////////
+void CWindow::drawContent()
+{
+    METHOD_ENTRY("CWindow::drawContent")
+    
+    m_Graphics.beginRenderBatch("world");
+        // Draw background area
+        this->drawFrame();
         
-        m_Graphics.beginRenderBatch("font");
-            Title.setPosition(m_nFramePosX + m_nFrameWidth/2, m_nFramePosY, true);
-            Title.display();
-        m_Graphics.endRenderBatch();
+        // Draw title frame
+        if (m_FrameStyle == FrameStyleType::DEFAULT || m_FrameStyle == FrameStyleType::NO_BACKGROUND)
+        {
+            m_Graphics.setColor(m_WinColorFG);
+            int nSpacing = Title.getFontSize();
+            m_Graphics.rect(Vector2d(m_nFramePosX, m_nFramePosY+nSpacing),
+                            Vector2d(m_nFramePosX+m_nFrameWidth, m_nFramePosY));
+        }
         
-        DOM_DEV(
-            static bool bWarned = false;
-            if (m_pUIDVisuals == nullptr)
-            {
-                if (!bWarned)
-                {
-                    WARNING_MSG("Window", "UID visuals not set.")
-                    bWarned = true;
-                }
-                goto DomDev;
-            })
-            
-//         m_pUIDVisuals->draw(m_nFramePosX, m_nFramePosY, "Window", m_UID.getValue());
+        m_Graphics.setColor(0.7, 0.3, 0.3, 1.0);
+        // Draw close button area
+        if (m_bClosable)
+        {
+            m_Graphics.filledRect(Vector2d(m_nFramePosX+m_nFrameWidth-m_nSizeClose, m_nFramePosY),
+                                  Vector2d(m_nFramePosX+m_nFrameWidth,m_nFramePosY+m_nSizeClose));
+        }
         
-        DOM_DEV(DomDev:)
+        // Draw resize button area
+        m_Graphics.filledRect(Vector2d(m_nFramePosX+m_nFrameWidth-m_nSizeResize,
+                                       m_nFramePosY+m_nFrameHeight-m_nSizeResize),
+                              Vector2d(m_nFramePosX+m_nFrameWidth, m_nFramePosY+m_nFrameHeight));
         
-        if (m_pWidget != nullptr) m_pWidget->draw();
-    }
+        m_Graphics.setColor(1.0, 1.0, 1.0, 1.0);
+    m_Graphics.endRenderBatch();
+    
+    m_Graphics.beginRenderBatch("font");
+        Title.setPosition(m_nFramePosX + m_nFrameWidth/2, m_nFramePosY, true);
+        Title.display();
+    m_Graphics.endRenderBatch();
+    
+    DOM_DEV(
+        static bool bWarned = false;
+        if (m_pUIDVisuals == nullptr)
+        {
+            if (!bWarned)
+            {
+                WARNING_MSG("Window", "UID visuals not set.")
+                bWarned = true;
+            }
+            goto DomDev;
+        })
+        
+//     m_pUIDVisuals->draw(m_nFramePosX, m_nFramePosY, "Window", m_UID.getValue());
+    
+    DOM_DEV(DomDev:)
+    
+    if (m_pWidget != nullptr) m_pWidget->draw();
 }
@@ -31,10 +31,13 @@
 #define WINDOW_H
 
 //--- Standard header --------------------------------------------------------//
+#include <cstdint>
 #include <vector>
 
 //--- Program header ---------------------------------------------------------//
 #include "font_user.h"
+#include "render_mode.h"
+#include "render_target.h"
 #include "text.h"
 #include "widget.h"
 #include "win_frame_user.h"
@@ -56,6 +59,12 @@ enum class WinAreaType
 ///
 /// \brief Definition of a graphical window
 ///
+/// If a shader program is set, the window is in retained mode: Frame, title
+/// and widget are rendered to a render target of the window's size only if
+/// something changed (dirty). Each frame, the cached content is composited
+/// as one textured quad. Without shader program, everything is drawn
+/// directly each frame (immediate mode).
+///
 ////////////////////////////////////////////////////////////////////////////////
 class CWindow : public IFontUser,
                 public IWinFrameUser
@@ -72,13 +81,17 @@ class CWindow : public IFontUser,
         IWidget* getWidget() const {return m_pWidget;}
         
         bool isClosable() const {return m_bClosable;}
+        bool isDirty() const;
         bool isInside(const int, const int, const WinAreaType = WinAreaType::WIN) const;
+        bool isRetained() const {return m_bRetained;}
         bool isVisible() const;
         
         //--- Methods --------------------------------------------------------//
         void center();
         void draw();
-        void setClosability(const bool _bClosable) {m_bClosable = _bClosable;}
+        void setClosability(const bool _bClosable) {m_bClosable = _bClosable; m_bDirty = true;}
+        void setDirty() {m_bDirty = true;}
+        void setShaderProgram(CShaderProgram* const);
         void setVisibilty(const bool);
         void setWidget(IWidget* const);
         
@@ -87,6 +100,7 @@ class CWindow : public IFontUser,
         
     private:
         
+        void drawContent();
         void myResize(const int, const int) override;
         void mySetColorBG(const ColorTypeRGBA&) override;
         void mySetColorFG(const ColorTypeRGBA&) override;
@@ -98,6 +112,14 @@ class CWindow : public IFontUser,
         bool        m_bClosable;    ///< Indicates, if this window may be closed
         int         m_nSizeClose;   ///< Size (both dimensions) of close area
         int         m_nSizeResize;  ///< Size (both dimensions) of resize area
+        
+        CRenderMode     m_RenderMode;       ///< Render mode for compositing cached window content
+        CRenderTarget   m_RenderTarget;     ///< Render target caching window content (retained mode)
+        std::uint32_t   m_unTitleRevision;  ///< Revision of title when last drawn
+        int             m_nTargetWidth;     ///< Width of render target, to detect if re-init is needed
+        int             m_nTargetHeight;    ///< Height of render target, to detect if re-init is needed
+        bool            m_bDirty;           ///< Indicates, if cached window content has to be redrawn
+        bool            m_bRetained;        ///< Indicates, if window content is cached (retained mode)
 };
 
 //--- Implementation is done here for inline optimisation --------------------//
@@ -115,6 +137,24 @@ inline bool CWindow::isVisible() const
     return m_bVisible;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns if cached window content has to be redrawn
+///
+/// Besides explicit changes of the window (resize, colour, widget), title and
+/// widget are asked for modified content.
+///
+/// \return Redraw needed?
+///
+////////////////////////////////////////////////////////////////////////////////
+inline bool CWindow::isDirty() const
+{
+    METHOD_ENTRY("CWindow::isDirty")
+    return (m_bDirty ||
+            Title.getRevision() != m_unTitleRevision ||
+            (m_pWidget != nullptr && m_pWidget->isDirty()));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Sets the visibility of this window
@@ -147,6 +187,7 @@ inline void CWindow::setWidget(IWidget* const _pWidget)
     m_pWidget = _pWidget;
     this->mySetPosition(m_nFramePosX, m_nFramePosY);
     this->myResize(m_nFrameWidth, m_nFrameHeight);
+    m_bDirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -162,6 +203,7 @@ inline void CWindow::myResize(const int _nX, const int _nY)
     METHOD_ENTRY("CWindow::myResize")
     if (m_pWidget != nullptr)
         m_pWidget->resize(_nX-m_nFrameBorderX*2, _nY-m_nFrameBorderY*2-Title.getFontSize());
+    m_bDirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -176,6 +218,7 @@ inline void CWindow::mySetColorBG(const ColorTypeRGBA& _RGBA)
     METHOD_ENTRY("CWindow::mySetColorBG")
     if (m_pWidget != nullptr)
         m_pWidget->setColorBG(_RGBA, WIN_INHERIT);
+    m_bDirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -190,12 +233,16 @@ inline void CWindow::mySetColorFG(const ColorTypeRGBA& _RGBA)
     METHOD_ENTRY("CWindow::mySetColorFG")
     if (m_pWidget != nullptr)
         m_pWidget->setColorFG(_RGBA, WIN_INHERIT);
+    m_bDirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Sets the position of the window
 ///
+/// Cached content stays valid when moving the window, since it is rendered
+/// relative to the window position.
+///
 /// \param _nX Position X
 /// \param _nY Position Y
 ///
@@ -46,6 +46,7 @@ using namespace Eigen;
 ///////////////////////////////////////////////////////////////////////////////
 CLuaManager::CLuaManager() : IComInterfaceProvider(),
                              IThreadModule(),
+                             m_pInputDispatch(nullptr),
                              m_strScript(""),
                              m_bPaused(true)
 {
@@ -421,6 +422,13 @@ bool CLuaManager::processFrame()
 
     try
     {
+        // Input events are handled at the start of each frame, if dispatch
+        // is deferred (see "input_set_deferred_dispatch"). The command is
+        // resolved once, since the input module might register it later.
+        if (m_pInputDispatch == nullptr)
+            m_pInputDispatch = m_pComInterface->getCommand<int>("input_dispatch_events");
+        if (m_pInputDispatch != nullptr) m_pInputDispatch->call();
+        
         if (!m_bPaused)
         {
             m_TimeProcessed.start();
@@ -437,6 +445,32 @@ bool CLuaManager::processFrame()
     }
 }
 
+#ifdef BFE_MULTITHREADING
+  ///////////////////////////////////////////////////////////////////////////////
+  ///
+  /// \brief Reports frequency adapted to load
+  ///
+  ///////////////////////////////////////////////////////////////////////////////
+  void CLuaManager::frequencyChanged()
+  {
+      METHOD_ENTRY("CLuaManager::frequencyChanged")
+      m_pComInterface->call<void, double>("e_frequency_changed_lua", m_fFrequency);
+  }
+  
+  ///////////////////////////////////////////////////////////////////////////////
+  ///
+  /// \brief Reports level of work to shed, to be handled by listeners
+  ///
+  /// \param _nLevel Level of work to shed, 0: full work
+  ///
+  ///////////////////////////////////////////////////////////////////////////////
+  void CLuaManager::shedLoad(const int _nLevel)
+  {
+      METHOD_ENTRY("CLuaManager::shedLoad")
+      m_pComInterface->call<void, int>("e_load_level_changed_lua", _nLevel);
+  }
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Initialise the command interface
@@ -454,6 +488,19 @@ void CLuaManager::myInitComInterface()
                                     {{ParameterType::NONE, "No return value"}},
                                     "system");
     
+    #ifdef BFE_MULTITHREADING
+        m_pComInterface->registerEvent<double>("e_frequency_changed_lua",
+                                        "Event, indicating that the frequency of the Lua thread was adapted to load.",
+                                        {{ParameterType::NONE, "No return value"},
+                                            {ParameterType::DOUBLE, "Frequency"}},
+                                        "system");
+        m_pComInterface->registerEvent<int>("e_load_level_changed_lua",
+                                        "Event, indicating that the level of optional work the Lua thread should shed changed.",
+                                        {{ParameterType::NONE, "No return value"},
+                                            {ParameterType::INT, "Level of work to shed, 0: full work"}},
+                                        "system");
+    #endif
+    
     // Callback to physics pause
     std::function<void(void)> FuncPause =
     [&]()
@@ -525,6 +572,42 @@ void CLuaManager::myInitComInterface()
                                         "system", "lua");
                                         // Callback registration has to be queued by com interface. Hence,
                                         // a "register_callback" command has to be implemented
+    #ifdef BFE_MULTITHREADING
+        m_pComInterface->registerFunction("get_thread_placement_lua",
+                                            CCommand<std::string>([&]() -> std::string {return this->getPlacement();}),
+                                            "Provides CPU affinity and scheduling granted to the Lua thread.",
+                                            {{ParameterType::STRING, "Placement of Lua thread"}},
+                                            "system");
+        m_pComInterface->registerFunction("set_frequency_range_lua",
+                                            CCommand<void, double, double>([&](const double& _fMin, const double& _fMax)
+                                            {
+                                                this->setFrequencyRange(_fMin, _fMax);
+                                            }),
+                                            "Lets the frequency of the Lua thread adapt to load within given range, maximum 0 switches off.",
+                                            {{ParameterType::NONE, "No return value"},
+                                            {ParameterType::DOUBLE, "Minimum frequency"},
+                                            {ParameterType::DOUBLE, "Maximum frequency"}},
+                                            "system", "lua");
+        m_pComInterface->registerFunction("set_thread_affinity_lua",
+                                            CCommand<void, std::string>([&](const std::string& _strCPUs)
+                                            {
+                                                this->setAffinity(_strCPUs);
+                                            }),
+                                            "Sets CPUs the Lua thread may run on, e.g. \"0,2-3\", empty for all.",
+                                            {{ParameterType::NONE, "No return value"},
+                                            {ParameterType::STRING, "List of CPUs"}},
+                                            "system");
+        m_pComInterface->registerFunction("set_thread_scheduling_lua",
+                                            CCommand<void, std::string, int>([&](const std::string& _strPolicy, const int _nPriority)
+                                            {
+                                                this->setScheduling(_strPolicy, _nPriority);
+                                            }),
+                                            "Sets scheduling policy (default, fifo, rr) and priority of the Lua thread.",
+                                            {{ParameterType::NONE, "No return value"},
+                                            {ParameterType::STRING, "Policy"},
+                                            {ParameterType::INT, "Priority"}},
+                                            "system");
+    #endif
     m_pComInterface->registerFunction("set_frequency_lua",
                                         CCommand<void, double>([&](const double& _fFrequency)
                                         {
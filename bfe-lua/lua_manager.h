@@ -81,6 +81,10 @@ class CLuaManager : public IComInterfaceProvider,
     private:
         
         //--- Methods [private] ----------------------------------------------//
+        #ifdef BFE_MULTITHREADING
+          void frequencyChanged() override;
+          void shedLoad(const int) override;
+        #endif
         void myInitComInterface();
         bool registerCallback(const std::string&,
                               const std::string&,
@@ -89,6 +93,8 @@ class CLuaManager : public IComInterfaceProvider,
         //--- Variables [private] --------------------------------------------//
         sol::state      m_LuaState;             ///< Current lua state
         
+        CCommand<int>*  m_pInputDispatch;       ///< Dispatch of deferred input events, nullptr if not (yet) resolved
+        
         std::string     m_strScript;            ///< Path and filename of main script
         bool            m_bPaused;              ///< Indicates if processing is paused, depends on physics
         
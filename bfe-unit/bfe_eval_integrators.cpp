@@ -0,0 +1,598 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       bfe_eval_integrators.cpp
+/// \brief      Integrator benchmark
+///
+/// A number of Vector2d states is integrated for a number of steps, using
+/// per object integrators via their interface, statically dispatched
+/// integrators embedded by value and the batch integrator with component
+/// planes. Time per state and step is reported for each integration method
+/// and the results are compared.
+///
+/// For mixed precision, the batch integrator is run with derivatives stored
+/// in single precision and with single precision only. Time, memory and
+/// deviation from double precision are reported, to choose per workload.
+///
+/// Afterwards, scaling of parallel batch integration is evaluated for 10k
+/// up to a maximum number of states and 1 up to a maximum number of threads.
+/// Results of all thread counts must be bit-identical. Multiple threads are
+/// only used if the engine is built with multithreading.
+///
+/// Finally, the multi-rate scheduler integrates a mix of quiescent and active
+/// states. Integration work relative to fixed rate integration and deviation
+/// from fixed rate results are reported.
+///
+/// Usage: bfe_eval_integrators [states] [steps] [max. threads] [max. states for scaling]
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-16
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "adams_bashforth_integrator.h"
+#include "adams_moulton_integrator.h"
+#include "batch_integrator.h"
+#include "euler_integrator.h"
+#include "log.h"
+#include "multi_rate_integrator.h"
+#include "static_integrator.h"
+#include "thread_pool.h"
+#include "timer.h"
+
+//--- Misc-Header ------------------------------------------------------------//
+
+using namespace bfe;
+
+constexpr int    EVAL_INTEGRATORS_STATES_DEFAULT = 100000;  ///< Number of states by default
+constexpr int    EVAL_INTEGRATORS_STEPS_DEFAULT = 100;      ///< Number of timesteps by default
+constexpr double EVAL_INTEGRATORS_STEP = 1.0/60.0;          ///< Timestep
+constexpr double EVAL_INTEGRATORS_TOLERANCE = 1.0e-9;       ///< Maximum relative deviation of results
+constexpr double EVAL_INTEGRATORS_MIXED_TOLERANCE = 1.0e-6;  ///< Maximum relative deviation of mixed precision results
+constexpr int    EVAL_INTEGRATORS_SCALING_STATES_MIN = 10000;       ///< Minimum number of states for scaling
+constexpr int    EVAL_INTEGRATORS_SCALING_STATES_MAX = 10000000;    ///< Maximum number of states for scaling by default
+constexpr int    EVAL_INTEGRATORS_SCALING_STEPS = 20;               ///< Number of timesteps for scaling
+constexpr int    EVAL_INTEGRATORS_MULTI_RATE_STATES = 10000;        ///< Number of states for multi-rate integration
+constexpr int    EVAL_INTEGRATORS_MULTI_RATE_STEPS = 600;           ///< Number of timesteps for multi-rate integration
+constexpr double EVAL_INTEGRATORS_MULTI_RATE_TOLERANCE = 1.0e-5;    ///< Tolerance of multi-rate error estimate
+constexpr double EVAL_INTEGRATORS_MULTI_RATE_DEVIATION = 1.0e-3;    ///< Maximum deviation from fixed rate results
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Creates per object integrator of given type
+///
+/// \param _Type Integration method
+///
+/// \return Integrator
+///
+////////////////////////////////////////////////////////////////////////////////
+IIntegrator<Vector2d>* createIntegrator(const IntegratorType _Type)
+{
+    switch (_Type)
+    {
+        case INTEGRATOR_EULER:
+            MEM_ALLOC("CEulerIntegrator")
+            return new CEulerIntegrator<Vector2d>;
+        case INTEGRATOR_ADAMS_MOULTON:
+            MEM_ALLOC("CAdamsMoultonIntegrator")
+            return new CAdamsMoultonIntegrator<Vector2d>;
+        case INTEGRATOR_ADAMS_BASHFORTH:
+        default:
+            MEM_ALLOC("CAdamsBashforthIntegrator")
+            return new CAdamsBashforthIntegrator<Vector2d>;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Derivative of given state at given step, cheap but not constant
+///
+/// \param _nState State
+/// \param _nStep Timestep
+///
+/// \return Derivative
+///
+////////////////////////////////////////////////////////////////////////////////
+inline Vector2d derivative(const int _nState, const int _nStep)
+{
+    return Vector2d(double((_nState + _nStep) % 17) - 8.0,
+                    double((_nState * 3 + _nStep) % 13) - 6.0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Integrates states using static integrators embedded by value
+///
+/// \param _nNrOfStates Number of states
+/// \param _nNrOfSteps Number of timesteps
+/// \param _Results Values after integration
+///
+/// \return Time of integration
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class TMethod>
+double runStatic(const int _nNrOfStates, const int _nNrOfSteps, std::vector<Vector2d>& _Results)
+{
+    std::vector<CStaticIntegrator<Vector2d, TMethod>> Integrators(_nNrOfStates);
+    for (auto i=0; i<_nNrOfStates; ++i)
+    {
+        Integrators[i].init(Vector2d(i, -i));
+    }
+
+    CTimer Timer;
+    Timer.start();
+    for (auto s=0; s<_nNrOfSteps; ++s)
+    {
+        for (auto i=0; i<_nNrOfStates; ++i)
+        {
+            Integrators[i].integrate(derivative(i, s), EVAL_INTEGRATORS_STEP);
+        }
+    }
+    Timer.stop();
+
+    _Results.resize(_nNrOfStates);
+    for (auto i=0; i<_nNrOfStates; ++i) _Results[i] = Integrators[i].getValue();
+
+    return Timer.getTime();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Runs benchmark for given integration method
+///
+/// \param _Type Integration method
+/// \param _strName Name of integration method
+/// \param _nNrOfStates Number of states
+/// \param _nNrOfSteps Number of timesteps
+///
+/// \return Results of per object and batch integration match?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool evalIntegrator(const IntegratorType _Type, const std::string& _strName,
+                    const int _nNrOfStates, const int _nNrOfSteps)
+{
+    //--- Per object integrators ---------------------------------------------//
+    std::vector<IIntegrator<Vector2d>*> Integrators(_nNrOfStates);
+    for (auto i=0; i<_nNrOfStates; ++i)
+    {
+        Integrators[i] = createIntegrator(_Type);
+        Integrators[i]->init(Vector2d(i, -i));
+    }
+
+    CTimer Timer;
+    Timer.start();
+    for (auto s=0; s<_nNrOfSteps; ++s)
+    {
+        for (auto i=0; i<_nNrOfStates; ++i)
+        {
+            Integrators[i]->integrate(derivative(i, s), EVAL_INTEGRATORS_STEP);
+        }
+    }
+    Timer.stop();
+    const double fTimeObject = Timer.getTime();
+
+    //--- Static integrators, runtime choice dispatched once per loop -------//
+    std::vector<Vector2d> ResultsStatic;
+    double fTimeStatic = 0.0;
+    switch (_Type)
+    {
+        case INTEGRATOR_EULER:
+            fTimeStatic = runStatic<CEulerMethod>(_nNrOfStates, _nNrOfSteps, ResultsStatic);
+            break;
+        case INTEGRATOR_ADAMS_BASHFORTH:
+            fTimeStatic = runStatic<CAdamsBashforthMethod>(_nNrOfStates, _nNrOfSteps, ResultsStatic);
+            break;
+        case INTEGRATOR_ADAMS_MOULTON:
+            fTimeStatic = runStatic<CAdamsMoultonMethod>(_nNrOfStates, _nNrOfSteps, ResultsStatic);
+            break;
+    }
+
+    //--- Batch integrator ---------------------------------------------------//
+    CBatchIntegrator<double> Batch;
+    Batch.init(_Type, _nNrOfStates, 2);
+    for (auto i=0; i<_nNrOfStates; ++i)
+    {
+        Batch.setValue(i, 0,  i);
+        Batch.setValue(i, 1, -i);
+    }
+    std::vector<double> Derivs(2*_nNrOfStates);
+
+    double fTimeBatch = 0.0;
+    for (auto s=0; s<_nNrOfSteps; ++s)
+    {
+        // Derivatives are written outside of timing, as they would be by the
+        // physics in component planes
+        for (auto i=0; i<_nNrOfStates; ++i)
+        {
+            Vector2d vecDeriv = derivative(i, s);
+            Derivs[i] = vecDeriv[0];
+            Derivs[_nNrOfStates+i] = vecDeriv[1];
+        }
+        Timer.start();
+        Batch.integrate(Derivs, EVAL_INTEGRATORS_STEP);
+        Timer.stop();
+        fTimeBatch += Timer.getTime();
+    }
+
+    //--- Compare ------------------------------------------------------------//
+    double fDevMax = 0.0;
+    bool bStaticIdentical = true;
+    for (auto i=0; i<_nNrOfStates; ++i)
+    {
+        const Vector2d vecValue = Integrators[i]->getValue();
+        bStaticIdentical &= (vecValue == ResultsStatic[i]);
+        for (auto c=0; c<2; ++c)
+        {
+            double fDev = std::abs(vecValue[c] - Batch.getValue(i, c)) /
+                          std::max(1.0, std::abs(vecValue[c]));
+            fDevMax = std::max(fDevMax, fDev);
+        }
+        delete Integrators[i];
+        MEM_FREED("IIntegrator")
+    }
+
+    const double fNrOfUpdates = double(_nNrOfStates) * _nNrOfSteps;
+    INFO_MSG("Integrator Evaluation", _strName << " per object: " << fTimeObject / fNrOfUpdates * 1.0e9 << "ns per state and step")
+    INFO_MSG("Integrator Evaluation", _strName << " static:     " << fTimeStatic / fNrOfUpdates * 1.0e9 << "ns per state and step")
+    INFO_MSG("Integrator Evaluation", _strName << " batch:      " << fTimeBatch / fNrOfUpdates * 1.0e9 << "ns per state and step")
+    INFO_MSG("Integrator Evaluation", _strName << " speedup (static/batch): " << fTimeObject / fTimeStatic << " / " <<
+                                                fTimeObject / fTimeBatch)
+    INFO_MSG("Integrator Evaluation", _strName << " max. relative deviation: " << fDevMax)
+
+    if (!bStaticIdentical)
+    {
+        ERROR_MSG("Integrator Evaluation", _strName << ": Results of per object and static integration differ.")
+        return false;
+    }
+
+    if (fDevMax > EVAL_INTEGRATORS_TOLERANCE)
+    {
+        ERROR_MSG("Integrator Evaluation", _strName << ": Results of per object and batch integration differ.")
+        return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Runs batch integration with given precision of values and
+///        derivatives
+///
+/// \param _Type Integration method
+/// \param _nNrOfStates Number of states
+/// \param _nNrOfSteps Number of timesteps
+/// \param _Results Values after integration, component planes
+///
+/// \return Time per state and step
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class TDeriv>
+double runPrecision(const IntegratorType _Type, const int _nNrOfStates, const int _nNrOfSteps,
+                    std::vector<double>& _Results)
+{
+    CBatchIntegrator<T, TDeriv> Batch;
+    Batch.init(_Type, _nNrOfStates, 2);
+    for (auto i=0; i<_nNrOfStates; ++i)
+    {
+        Batch.setValue(i, 0, T( i));
+        Batch.setValue(i, 1, T(-i));
+    }
+    std::vector<T> Derivs(2*_nNrOfStates);
+
+    CTimer Timer;
+    double fTime = 0.0;
+    for (auto s=0; s<_nNrOfSteps; ++s)
+    {
+        // Scaled, so that derivatives are not exactly representable in
+        // single precision
+        for (auto i=0; i<_nNrOfStates; ++i)
+        {
+            Vector2d vecDeriv = 0.1 * derivative(i, s);
+            Derivs[i] = T(vecDeriv[0]);
+            Derivs[_nNrOfStates+i] = T(vecDeriv[1]);
+        }
+        Timer.start();
+        Batch.integrate(Derivs, EVAL_INTEGRATORS_STEP);
+        Timer.stop();
+        fTime += Timer.getTime();
+    }
+
+    _Results.assign(Batch.getValues(0), Batch.getValues(0) + 2*_nNrOfStates);
+
+    return fTime / (double(_nNrOfStates) * _nNrOfSteps);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Evaluates error and throughput of mixed precision batch integration
+///
+/// \param _Type Integration method
+/// \param _strName Name of integration method
+/// \param _nNrOfStates Number of states
+/// \param _nNrOfSteps Number of timesteps
+///
+/// \return Deviation of mixed precision within tolerance?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool evalPrecision(const IntegratorType _Type, const std::string& _strName,
+                   const int _nNrOfStates, const int _nNrOfSteps)
+{
+    const int nNrOfDerivs = (_Type == INTEGRATOR_EULER) ? 1 : (_Type == INTEGRATOR_ADAMS_BASHFORTH) ? 4 : 5;
+
+    std::vector<double> Reference;
+    std::vector<double> ResultsMixed;
+    std::vector<double> ResultsSingle;
+    const double fTimeDouble = runPrecision<double, double>(_Type, _nNrOfStates, _nNrOfSteps, Reference);
+    const double fTimeMixed  = runPrecision<double, float>(_Type, _nNrOfStates, _nNrOfSteps, ResultsMixed);
+    const double fTimeSingle = runPrecision<float, float>(_Type, _nNrOfStates, _nNrOfSteps, ResultsSingle);
+
+    double fDevMixed = 0.0;
+    double fDevSingle = 0.0;
+    for (auto i=0u; i<Reference.size(); ++i)
+    {
+        const double fScale = std::max(1.0, std::abs(Reference[i]));
+        fDevMixed  = std::max(fDevMixed,  std::abs(ResultsMixed[i]  - Reference[i]) / fScale);
+        fDevSingle = std::max(fDevSingle, std::abs(ResultsSingle[i] - Reference[i]) / fScale);
+    }
+
+    // Two values (current, previous) and derivative history per component
+    const int nBytesDouble = 2 * (2+nNrOfDerivs) * sizeof(double);
+    const int nBytesMixed  = 2 * (2*sizeof(double) + nNrOfDerivs*sizeof(float));
+    const int nBytesSingle = 2 * (2+nNrOfDerivs) * sizeof(float);
+
+    INFO_MSG("Integrator Evaluation", _strName << " double/double: " << fTimeDouble * 1.0e9 << "ns per state and step, " <<
+                                                nBytesDouble << " bytes per state")
+    INFO_MSG("Integrator Evaluation", _strName << " double/float:  " << fTimeMixed * 1.0e9 << "ns per state and step, " <<
+                                                nBytesMixed << " bytes per state, max. relative deviation " << fDevMixed)
+    INFO_MSG("Integrator Evaluation", _strName << " float/float:   " << fTimeSingle * 1.0e9 << "ns per state and step, " <<
+                                                nBytesSingle << " bytes per state, max. relative deviation " << fDevSingle)
+
+    if (fDevMixed > EVAL_INTEGRATORS_MIXED_TOLERANCE)
+    {
+        ERROR_MSG("Integrator Evaluation", _strName << ": Mixed precision results deviate from double precision.")
+        return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Runs parallel batch integration for given number of states and
+///        threads
+///
+/// \param _nNrOfStates Number of states
+/// \param _nNrOfThreads Number of threads
+/// \param _Results Values after integration
+///
+/// \return Time per state and step
+///
+////////////////////////////////////////////////////////////////////////////////
+double runParallel(const int _nNrOfStates, const int _nNrOfThreads, std::vector<double>& _Results)
+{
+    CThreadPool ThreadPool;
+    ThreadPool.start(_nNrOfThreads);
+
+    CBatchIntegrator<double> Batch;
+    Batch.init(INTEGRATOR_ADAMS_BASHFORTH, _nNrOfStates, 2);
+
+    std::vector<double> Derivs(2*_nNrOfStates);
+    for (auto i=0; i<_nNrOfStates; ++i)
+    {
+        Derivs[i] = std::sin(i);
+        Derivs[_nNrOfStates+i] = std::cos(i);
+    }
+
+    CTimer Timer;
+    Timer.start();
+    for (auto s=0; s<EVAL_INTEGRATORS_SCALING_STEPS; ++s)
+    {
+        Batch.integrate(Derivs.data(), EVAL_INTEGRATORS_STEP * (1.0 + 0.01*s), ThreadPool);
+    }
+    Timer.stop();
+
+    _Results.assign(Batch.getValues(0), Batch.getValues(0) + 2*_nNrOfStates);
+
+    return Timer.getTime() / (double(_nNrOfStates) * EVAL_INTEGRATORS_SCALING_STEPS);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Evaluates scaling of parallel batch integration
+///
+/// \param _nMaxThreads Maximum number of threads
+/// \param _nMaxStates Maximum number of states
+///
+/// \return Results are bit-identical for all numbers of threads?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool evalScaling(const int _nMaxThreads, const int _nMaxStates)
+{
+    bool bIdentical = true;
+    std::vector<double> Reference;
+    std::vector<double> Results;
+
+    for (auto nStates=EVAL_INTEGRATORS_SCALING_STATES_MIN; nStates<=_nMaxStates; nStates*=10)
+    {
+        const double fTimeSingle = runParallel(nStates, 1, Reference);
+        INFO_MSG("Integrator Evaluation", "Scaling " << nStates << " states, 1 thread: " <<
+                                          fTimeSingle * 1.0e9 << "ns per state and step")
+
+        for (auto nThreads=2; nThreads<=_nMaxThreads; nThreads*=2)
+        {
+            const double fTime = runParallel(nStates, nThreads, Results);
+            const bool bSame = std::memcmp(Results.data(), Reference.data(),
+                                           Reference.size()*sizeof(double)) == 0;
+            INFO_MSG("Integrator Evaluation", "Scaling " << nStates << " states, " << nThreads << " threads: " <<
+                                              fTime * 1.0e9 << "ns per state and step, speedup " <<
+                                              fTimeSingle / fTime << (bSame ? "" : " (results differ)"))
+            bIdentical &= bSame;
+        }
+    }
+    if (!bIdentical)
+    {
+        ERROR_MSG("Integrator Evaluation", "Results of parallel integration depend on number of threads.")
+    }
+    return bIdentical;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Evaluates multi-rate integration of quiescent and active states
+///
+/// Half of the states decay slowly, the other half oscillate. Work and
+/// results are compared to fixed rate integration.
+///
+/// \return Deviation from fixed rate integration within limit?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool evalMultiRate()
+{
+    const int nNrOfStates = EVAL_INTEGRATORS_MULTI_RATE_STATES;
+    const double fStep = EVAL_INTEGRATORS_STEP;
+
+    auto Deriv = [&](const int _nState, const double& _fValue, const double& _fTime)
+    {
+        return (_nState < nNrOfStates/2) ? -0.01*_fValue : std::cos(10.0*_fTime + _nState);
+    };
+
+    CMultiRateIntegrator<double, CAdamsBashforthMethod> MultiRate;
+    MultiRate.init(nNrOfStates, fStep);
+    MultiRate.setTolerance(EVAL_INTEGRATORS_MULTI_RATE_TOLERANCE);
+    std::vector<CStaticIntegrator<double, CAdamsBashforthMethod>> Fixed(nNrOfStates);
+    for (auto i=0; i<nNrOfStates; ++i)
+    {
+        MultiRate.initState(i, 1.0);
+        Fixed[i].init(1.0);
+    }
+
+    CTimer Timer;
+    double fTimeMultiRate = 0.0;
+    double fTimeFixed = 0.0;
+    std::size_t nWork = 0u;
+
+    for (auto s=0; s<EVAL_INTEGRATORS_MULTI_RATE_STEPS; ++s)
+    {
+        const double fTime = s * fStep;
+
+        Timer.start();
+        MultiRate.step([&](const std::size_t _nState)
+        {
+            return Deriv(_nState, MultiRate.getValue(_nState), fTime);
+        });
+        Timer.stop();
+        fTimeMultiRate += Timer.getTime();
+        nWork += MultiRate.getNrOfIntegrations();
+
+        Timer.start();
+        for (auto i=0; i<nNrOfStates; ++i)
+        {
+            Fixed[i].integrate(Deriv(i, Fixed[i].getValue(), fTime), fStep);
+        }
+        Timer.stop();
+        fTimeFixed += Timer.getTime();
+    }
+
+    double fDevQuiescent = 0.0;
+    double fDevActive = 0.0;
+    for (auto i=0; i<nNrOfStates; ++i)
+    {
+        const double fDev = std::abs(MultiRate.getValue(i) - Fixed[i].getValue());
+        if (i < nNrOfStates/2)
+            fDevQuiescent = std::max(fDevQuiescent, fDev);
+        else
+            fDevActive = std::max(fDevActive, fDev);
+    }
+
+    INFO_MSG("Integrator Evaluation", "Multi-rate: " << double(nWork) / (double(nNrOfStates) * EVAL_INTEGRATORS_MULTI_RATE_STEPS) <<
+                                      " of fixed rate work, " << fTimeMultiRate / fTimeFixed << " of fixed rate time")
+    for (auto l=0; l<MULTI_RATE_NR_OF_LEVELS; ++l)
+    {
+        INFO_MSG("Integrator Evaluation", "Multi-rate: " << MultiRate.getNrOfStatesInLevel(l) << " states at " <<
+                                          (1 << l) << "x base step")
+    }
+    INFO_MSG("Integrator Evaluation", "Multi-rate: Max. deviation quiescent " << fDevQuiescent <<
+                                      ", active " << fDevActive)
+
+    if (std::max(fDevQuiescent, fDevActive) > EVAL_INTEGRATORS_MULTI_RATE_DEVIATION)
+    {
+        ERROR_MSG("Integrator Evaluation", "Multi-rate results deviate from fixed rate integration.")
+        return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// This is the entrance point for program startup.
+///
+/// \param  argc number of given arguments
+/// \param  argv array, storing the arguments
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char *argv[])
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    int nNrOfStates = EVAL_INTEGRATORS_STATES_DEFAULT;
+    int nNrOfSteps = EVAL_INTEGRATORS_STEPS_DEFAULT;
+    int nMaxThreads = std::max(1u, std::thread::hardware_concurrency());
+    int nMaxStates = EVAL_INTEGRATORS_SCALING_STATES_MAX;
+
+    if (argc > 1) nNrOfStates = std::max(1, std::atoi(argv[1]));
+    if (argc > 2) nNrOfSteps = std::max(1, std::atoi(argv[2]));
+    if (argc > 3) nMaxThreads = std::max(1, std::atoi(argv[3]));
+    if (argc > 4) nMaxStates = std::max(1, std::atoi(argv[4]));
+
+    INFO_MSG("Integrator Evaluation", "Integrating " << nNrOfStates << " states for " << nNrOfSteps << " steps...")
+
+    bool bPassed = true;
+    bPassed &= evalIntegrator(INTEGRATOR_EULER, "Euler", nNrOfStates, nNrOfSteps);
+    bPassed &= evalIntegrator(INTEGRATOR_ADAMS_BASHFORTH, "Adams-Bashforth", nNrOfStates, nNrOfSteps);
+    bPassed &= evalIntegrator(INTEGRATOR_ADAMS_MOULTON, "Adams-Moulton", nNrOfStates, nNrOfSteps);
+    bPassed &= evalPrecision(INTEGRATOR_EULER, "Euler", nNrOfStates, nNrOfSteps);
+    bPassed &= evalPrecision(INTEGRATOR_ADAMS_BASHFORTH, "Adams-Bashforth", nNrOfStates, nNrOfSteps);
+    bPassed &= evalPrecision(INTEGRATOR_ADAMS_MOULTON, "Adams-Moulton", nNrOfStates, nNrOfSteps);
+    bPassed &= evalScaling(nMaxThreads, nMaxStates);
+    bPassed &= evalMultiRate();
+
+    if (!bPassed)
+    {
+        ERROR_MSG("Integrator Evaluation", "Failed.")
+        return EXIT_FAILURE;
+    }
+    INFO_MSG("Integrator Evaluation", "Passed.")
+
+    return EXIT_SUCCESS;
+}
@@ -28,7 +28,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
-/// \file       pw_eval_multithreading.cpp
+/// \file       bfe_eval_multithreading.cpp
 /// \brief      Main program for evaluation test
 ///
 /// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
@@ -44,6 +44,8 @@
 //--- Program header ---------------------------------------------------------//
 #include "log.h"
 
+using namespace bfe;
+
 //--- Misc-Header ------------------------------------------------------------//
 
 volatile int     g_nTest;
@@ -0,0 +1,442 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       bfe_eval_names.cpp
+/// \brief      Random engine and name generator benchmark
+///
+/// First, output of the PCG engines is checked against the reference
+/// implementation. Then, random numbers per second of std::mt19937 and the
+/// PCG engines are measured, followed by names per second of the name
+/// generator, compared to the former implementation based on std::mt19937
+/// and standard distributions.
+///
+/// Names are generated in parallel, one stream per task. The names of each
+/// task must be identical for any number of threads.
+///
+/// Finally, bulk generation into a name list is compared to single names,
+/// with and without uniqueness. Partitioned unique generation must produce
+/// the same list for any number of threads, without duplicates.
+///
+/// Usage: bfe_eval_names [names] [max. threads]
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "hash.h"
+#include "log.h"
+#include "name_list.h"
+#include "namegenerator.h"
+#include "pcg_random.h"
+#include "thread_pool.h"
+#include "timer.h"
+
+//--- Misc-Header ------------------------------------------------------------//
+
+using namespace bfe;
+
+constexpr int EVAL_NAMES_NAMES_DEFAULT = 1000000;   ///< Number of names by default
+constexpr int EVAL_NAMES_NUMBERS = 100000000;       ///< Number of random numbers for engine benchmark
+constexpr int EVAL_NAMES_SEEDINGS = 100000;         ///< Number of seedings for engine benchmark
+constexpr int EVAL_NAMES_NR_OF_STREAMS = 64;        ///< Number of streams (tasks) for parallel generation
+constexpr int EVAL_NAMES_SEED = 42;                 ///< Seed for all generators
+constexpr int EVAL_NAMES_NR_OF_PARTITIONS = 16;     ///< Number of partitions for bulk generation
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns a random name like the former implementation
+///
+/// Generator and distributions were a std::mt19937 and distributions that
+/// were constructed per name.
+///
+/// \param _Generator Random number generator
+///
+/// \return Random name
+///
+////////////////////////////////////////////////////////////////////////////////
+std::string getNameFormer(std::mt19937& _Generator)
+{
+    std::uniform_int_distribution<int>  CharDistribution(0,25);
+    std::poisson_distribution<int>      LengthDistribution(NAME_GENERATOR_LENGTH_MEAN);
+
+    int nMode = 0;
+    std::string strOut("");
+
+    int nLength = LengthDistribution(_Generator);
+    while (nLength > NAME_GENERATOR_LENGTH_MAX || nLength < NAME_GENERATOR_LENGTH_MIN) nLength = LengthDistribution(_Generator);
+
+    while (nLength-- > 0)
+    {
+        int nChar = CharDistribution(_Generator);
+        switch (nChar)
+        {
+            case 0: case 4: case 8: case 14: case 20:
+                nMode = 1;
+                strOut += ALPHABET[nChar];
+                break;
+            default:
+                if (nMode == 2)
+                {
+                    if (nChar == 18) strOut += ALPHABET[nChar];
+                    else nLength++;
+                }
+                else
+                {
+                    strOut += ALPHABET[nChar];
+                    nMode = 2;
+                }
+        }
+    }
+    std::transform(strOut.begin(), strOut.begin()+1,strOut.begin(), ::toupper);
+    return strOut;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Hashes a name (FNV-1a), combining it with given hash
+///
+/// \param _nHash Hash of previous names
+/// \param _strName Name
+///
+/// \return Combined hash
+///
+////////////////////////////////////////////////////////////////////////////////
+std::uint64_t hashName(const std::uint64_t _nHash, const std::string& _strName)
+{
+    return fnv1a(_strName.data(), _strName.size(), _nHash);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Checks PCG engines against output of reference implementation
+///
+/// \return Output matches reference?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool evalReference()
+{
+    const std::uint32_t anRef32[4] = {0xa15c02b7u, 0x7b47f409u, 0xba1d3330u, 0x83d2f293u};
+    const std::uint64_t anRef64[4] = {0x86b1da1d72062b68ULL, 0x1304aa46c9853d39ULL,
+                                      0xa3670e9e0dd50358ULL, 0xf9090e529a7dae00ULL};
+    bool bMatch = true;
+
+    CPCG32 Pcg32(42u, 54u);
+    CPCG64 Pcg64(42u, 54u);
+    for (auto i=0; i<4; ++i)
+    {
+        bMatch &= (Pcg32() == anRef32[i]);
+        bMatch &= (Pcg64() == anRef64[i]);
+    }
+
+    // Jump ahead must equal drawing numbers
+    CPCG32 Jump32(42u, 54u);
+    CPCG64 Jump64(42u, 54u);
+    Jump32.advance(3u);
+    Jump64.advance(3u);
+    bMatch &= (Jump32() == anRef32[3]) && (Jump64() == anRef64[3]);
+
+    if (!bMatch)
+    {
+        ERROR_MSG("Name Evaluation", "Output of PCG engines differs from reference.")
+    }
+    return bMatch;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Measures random numbers per second of given engine
+///
+/// \param _strName Name of engine
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class TEngine>
+void evalEngine(const std::string& _strName)
+{
+    // Sum is logged, so seeding and drawing are not optimised away
+    std::uint64_t nSum = 0u;
+
+    TEngine Engine;
+    CTimer Timer;
+    Timer.start();
+    for (auto i=0; i<EVAL_NAMES_SEEDINGS; ++i)
+    {
+        Engine.seed(EVAL_NAMES_SEED + i);
+        nSum += Engine();
+    }
+    Timer.stop();
+    const double fTimeSeed = Timer.getTime() / EVAL_NAMES_SEEDINGS;
+
+    Timer.start();
+    for (auto i=0; i<EVAL_NAMES_NUMBERS; ++i) nSum += Engine();
+    Timer.stop();
+
+    INFO_MSG("Name Evaluation", _strName << ": " << EVAL_NAMES_NUMBERS / Timer.getTime() * 1.0e-6 <<
+                                " million numbers per second, " << sizeof(TEngine) << " bytes of state, " <<
+                                fTimeSeed * 1.0e9 << "ns seeding and first number (sum " << nSum % 1000u << ")")
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Measures names per second of former and current name generation
+///
+/// \param _nNrOfNames Number of names
+///
+////////////////////////////////////////////////////////////////////////////////
+void evalNames(const int _nNrOfNames)
+{
+    std::uint64_t nHash = 0u;
+    CTimer Timer;
+
+    std::mt19937 Generator;
+    Generator.seed(EVAL_NAMES_SEED);
+    Timer.start();
+    for (auto i=0; i<_nNrOfNames; ++i) nHash = hashName(nHash, getNameFormer(Generator));
+    Timer.stop();
+    const double fTimeFormer = Timer.getTime();
+
+    CNameGenerator NameGenerator(EVAL_NAMES_SEED);
+    Timer.start();
+    for (auto i=0; i<_nNrOfNames; ++i) nHash = hashName(nHash, NameGenerator.getName());
+    Timer.stop();
+    const double fTime = Timer.getTime();
+
+    INFO_MSG("Name Evaluation", "Former (mt19937): " << _nNrOfNames / fTimeFormer * 1.0e-6 << " million names per second")
+    INFO_MSG("Name Evaluation", "Current (PCG32):  " << _nNrOfNames / fTime * 1.0e-6 << " million names per second, speedup " <<
+                                fTimeFormer / fTime << " (hash " << nHash % 1000u << ")")
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Generates names in parallel, one stream per task
+///
+/// \param _nNrOfNames Number of names
+/// \param _nNrOfThreads Number of threads
+/// \param _Hashes Hash of names of each task
+///
+/// \return Time
+///
+////////////////////////////////////////////////////////////////////////////////
+double runStreams(const int _nNrOfNames, const int _nNrOfThreads, std::vector<std::uint64_t>& _Hashes)
+{
+    CThreadPool ThreadPool;
+    ThreadPool.start(_nNrOfThreads);
+
+    const int nNamesPerStream = _nNrOfNames / EVAL_NAMES_NR_OF_STREAMS;
+    _Hashes.assign(EVAL_NAMES_NR_OF_STREAMS, 0u);
+
+    CTimer Timer;
+    Timer.start();
+    ThreadPool.run(EVAL_NAMES_NR_OF_STREAMS, [&](const std::size_t _nStream)
+    {
+        CNameGenerator NameGenerator(EVAL_NAMES_SEED, _nStream);
+        std::uint64_t nHash = 0u;
+        for (auto i=0; i<nNamesPerStream; ++i) nHash = hashName(nHash, NameGenerator.getName());
+        _Hashes[_nStream] = nHash;
+    });
+    Timer.stop();
+
+    return Timer.getTime();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Evaluates reproducibility and scaling of parallel name generation
+///
+/// \param _nNrOfNames Number of names
+/// \param _nMaxThreads Maximum number of threads
+///
+/// \return Names of each stream are identical for any number of threads?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool evalStreams(const int _nNrOfNames, const int _nMaxThreads)
+{
+    std::vector<std::uint64_t> Reference;
+    std::vector<std::uint64_t> Hashes;
+
+    const double fTimeSingle = runStreams(_nNrOfNames, 1, Reference);
+    INFO_MSG("Name Evaluation", "Streams, 1 thread: " << _nNrOfNames / fTimeSingle * 1.0e-6 << " million names per second")
+
+    bool bIdentical = true;
+    for (auto nThreads=2; nThreads<=_nMaxThreads; nThreads*=2)
+    {
+        const double fTime = runStreams(_nNrOfNames, nThreads, Hashes);
+        const bool bSame = (Hashes == Reference);
+        INFO_MSG("Name Evaluation", "Streams, " << nThreads << " threads: " << _nNrOfNames / fTime * 1.0e-6 <<
+                                    " million names per second, speedup " << fTimeSingle / fTime <<
+                                    (bSame ? "" : " (names differ)"))
+        bIdentical &= bSame;
+    }
+
+    // Streams must differ from each other
+    std::sort(Reference.begin(), Reference.end());
+    const bool bDistinct = std::adjacent_find(Reference.begin(), Reference.end()) == Reference.end();
+
+    if (!bIdentical)
+    {
+        ERROR_MSG("Name Evaluation", "Names of streams depend on number of threads.")
+    }
+    if (!bDistinct)
+    {
+        ERROR_MSG("Name Evaluation", "Streams are not independent.")
+    }
+    return bIdentical && bDistinct;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Evaluates bulk and partitioned name generation
+///
+/// \param _nNrOfNames Number of names
+/// \param _nMaxThreads Maximum number of threads
+///
+/// \return Partitioned names are unique and independent of number of threads?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool evalBulk(const int _nNrOfNames, const int _nMaxThreads)
+{
+    CTimer Timer;
+
+    //--- Single names -------------------------------------------------------//
+    std::vector<std::string> Single;
+    Single.reserve(_nNrOfNames);
+    CNameGenerator NameGenerator(EVAL_NAMES_SEED);
+    Timer.start();
+    for (auto i=0; i<_nNrOfNames; ++i) Single.push_back(NameGenerator.getName());
+    Timer.stop();
+    const double fTimeSingle = Timer.getTime();
+
+    //--- Bulk, with and without uniqueness ----------------------------------//
+    CNameList Bulk;
+    CNameGenerator BulkGenerator(EVAL_NAMES_SEED);
+    Timer.start();
+    BulkGenerator.getNames(Bulk, _nNrOfNames);
+    Timer.stop();
+    const double fTimeBulk = Timer.getTime();
+
+    CNameList Unique;
+    CNameGenerator UniqueGenerator(EVAL_NAMES_SEED);
+    Timer.start();
+    const std::size_t nNrOfUnique = UniqueGenerator.getNames(Unique, _nNrOfNames, true);
+    Timer.stop();
+    const double fTimeUnique = Timer.getTime();
+
+    bool bSame = (Bulk.size() == Single.size());
+    for (auto i=0u; bSame && i<Bulk.size(); ++i) bSame = (Bulk.getName(i) == Single[i]);
+
+    INFO_MSG("Name Evaluation", "Single names: " << _nNrOfNames / fTimeSingle * 1.0e-6 << " million names per second")
+    INFO_MSG("Name Evaluation", "Bulk:         " << _nNrOfNames / fTimeBulk * 1.0e-6 << " million names per second, speedup " <<
+                                fTimeSingle / fTimeBulk << (bSame ? "" : " (names differ)"))
+    INFO_MSG("Name Evaluation", "Bulk unique:  " << nNrOfUnique / fTimeUnique * 1.0e-6 << " million names per second, " <<
+                                nNrOfUnique << " of " << _nNrOfNames << " names")
+
+    //--- Partitioned, unique ------------------------------------------------//
+    CNameList Reference;
+    bool bIdentical = true;
+    for (auto nThreads=1; nThreads<=_nMaxThreads; nThreads*=2)
+    {
+        CThreadPool ThreadPool;
+        ThreadPool.start(nThreads);
+
+        CNameList Partitioned;
+        Timer.start();
+        CNameGenerator::getNames(Partitioned, _nNrOfNames, EVAL_NAMES_SEED, EVAL_NAMES_NR_OF_PARTITIONS, ThreadPool, true);
+        Timer.stop();
+
+        if (nThreads == 1) Reference = Partitioned;
+        const bool bSamePartitioned = (Partitioned.getArena() == Reference.getArena()) &&
+                                      (Partitioned.size() == Reference.size());
+        INFO_MSG("Name Evaluation", "Partitioned unique, " << nThreads << " thread(s): " <<
+                                    Partitioned.size() / Timer.getTime() * 1.0e-6 << " million names per second" <<
+                                    (bSamePartitioned ? "" : " (names differ)"))
+        bIdentical &= bSamePartitioned;
+    }
+
+    std::vector<std::string> Names(Reference.size());
+    for (auto i=0u; i<Reference.size(); ++i) Names[i] = Reference.getName(i);
+    std::sort(Names.begin(), Names.end());
+    const bool bUnique = std::adjacent_find(Names.begin(), Names.end()) == Names.end();
+
+    if (!bSame)
+    {
+        ERROR_MSG("Name Evaluation", "Bulk names differ from single names.")
+    }
+    if (!bIdentical)
+    {
+        ERROR_MSG("Name Evaluation", "Partitioned names depend on number of threads.")
+    }
+    if (!bUnique)
+    {
+        ERROR_MSG("Name Evaluation", "Partitioned names are not unique.")
+    }
+    return bSame && bIdentical && bUnique;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// This is the entrance point for program startup.
+///
+/// \param  argc number of given arguments
+/// \param  argv array, storing the arguments
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char *argv[])
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    int nNrOfNames = EVAL_NAMES_NAMES_DEFAULT;
+    int nMaxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    if (argc > 1) nNrOfNames = std::max(EVAL_NAMES_NR_OF_STREAMS, std::atoi(argv[1]));
+    if (argc > 2) nMaxThreads = std::max(1, std::atoi(argv[2]));
+
+    bool bPassed = evalReference();
+
+    evalEngine<std::mt19937>("std::mt19937");
+    evalEngine<CPCG32>("PCG32");
+    evalEngine<CPCG64>("PCG64");
+
+    evalNames(nNrOfNames);
+    bPassed &= evalStreams(nNrOfNames, nMaxThreads);
+    bPassed &= evalBulk(nNrOfNames, nMaxThreads);
+
+    if (!bPassed)
+    {
+        ERROR_MSG("Name Evaluation", "Failed.")
+        return EXIT_FAILURE;
+    }
+    INFO_MSG("Name Evaluation", "Passed.")
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,298 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       bfe_eval_render.cpp
+/// \brief      Headless render benchmark
+///
+/// A scripted scene of circles, polygons, dots and text is rendered offscreen
+/// for a given number of frames. Frame time, draw calls, vertices and bytes
+/// uploaded are reported, which allows for tracking render performance on
+/// machines without GPU or display (e.g. Mesa software rasterizer).
+///
+/// Usage: bfe_eval_render [shader directory] [truetype font] [frames]
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-12
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+//--- Program header ---------------------------------------------------------//
+#include "circular_buffer.h"
+#include "font_manager.h"
+#include "graphics.h"
+#include "log.h"
+#include "render_mode.h"
+#include "shader_program.h"
+#include "timer.h"
+
+//--- Misc-Header ------------------------------------------------------------//
+
+using namespace bfe;
+
+constexpr int EVAL_RENDER_WIDTH = 1280;         ///< Width of offscreen framebuffer
+constexpr int EVAL_RENDER_HEIGHT = 720;         ///< Height of offscreen framebuffer
+constexpr int EVAL_RENDER_FRAMES_DEFAULT = 500; ///< Number of frames rendered by default
+constexpr int EVAL_RENDER_NR_OF_CIRCLES = 200;  ///< Circles per frame
+constexpr int EVAL_RENDER_NR_OF_POLYGONS = 100; ///< Polygons per frame
+constexpr int EVAL_RENDER_NR_OF_DOTS = 5000;    ///< Dots per frame
+constexpr int EVAL_RENDER_NR_OF_TEXTS = 40;     ///< Lines of text per frame
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Loads shader program from given vertex and fragment shader file
+///
+/// \param _strVert Vertex shader file
+/// \param _strFrag Fragment shader file
+/// \param _VertexShader Vertex shader to be loaded
+/// \param _FragmentShader Fragment shader to be loaded
+/// \param _ShaderProgram Shader program to be created
+///
+/// \return Success?
+///
+///////////////////////////////////////////////////////////////////////////////
+bool loadShaderProgram(const std::string& _strVert, const std::string& _strFrag,
+                       CShader& _VertexShader, CShader& _FragmentShader,
+                       CShaderProgram& _ShaderProgram)
+{
+    METHOD_ENTRY("loadShaderProgram")
+
+    if (!_VertexShader.load(_strVert, GL_VERTEX_SHADER)) return false;
+    if (!_FragmentShader.load(_strFrag, GL_FRAGMENT_SHADER)) return false;
+    _ShaderProgram.create();
+    _ShaderProgram.addShader(_VertexShader);
+    _ShaderProgram.addShader(_FragmentShader);
+    return _ShaderProgram.link();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Renders one frame of the scripted scene
+///
+/// The scene is a deterministic function of the frame number. Buffers are
+/// not swapped, so that statistics of this frame can be read afterwards.
+///
+/// \param _Graphics Graphics instance
+/// \param _pFontManager Font manager, nullptr if text is skipped
+/// \param _Dots Buffer of dots
+/// \param _nFrame Number of frame
+///
+///////////////////////////////////////////////////////////////////////////////
+void renderFrame(CGraphics& _Graphics, CFontManager* const _pFontManager,
+                 CCircularBuffer<Vector2d>& _Dots, const int _nFrame)
+{
+    METHOD_ENTRY("renderFrame")
+
+    const double fT = _nFrame * 0.01;
+
+    _Graphics.setupWorldSpace();
+    _Graphics.beginRenderBatch("world");
+
+        // Circles, outlined and filled
+        for (auto i=0; i < EVAL_RENDER_NR_OF_CIRCLES; ++i)
+        {
+            const Vector2d vecC(std::cos(fT+i)*(i % 50), std::sin(fT*0.5+i)*(i % 30));
+            _Graphics.setColor(0.5, 0.5 + 0.5*std::sin(i), 1.0, 0.8);
+            if (i % 2 == 0)
+                _Graphics.circle(vecC, 1.0 + (i % 7), 32);
+            else
+                _Graphics.filledCircle(vecC, 1.0 + (i % 5), 24);
+        }
+
+        // Polygons, outlined and filled
+        VertexListType Vertices(6);
+        for (auto i=0; i < EVAL_RENDER_NR_OF_POLYGONS; ++i)
+        {
+            const Vector2d vecOffset(std::sin(fT+i*0.3)*60.0, std::cos(fT+i*0.7)*35.0);
+            for (auto j=0u; j < Vertices.size(); ++j)
+            {
+                const double fAng = j * MATH_2PI / Vertices.size() + fT;
+                Vertices[j] = Vector2d(std::cos(fAng), std::sin(fAng)) * (2.0 + i % 3);
+            }
+            _Graphics.setColor(1.0, 0.6, 0.2, 0.6);
+            _Graphics.polygon(Vertices, i % 2 == 0 ? PolygonType::FILLED : PolygonType::LINE_LOOP, vecOffset);
+        }
+
+        // Dots, e.g. like trajectories
+        for (auto i=0; i < EVAL_RENDER_NR_OF_DOTS / 100; ++i)
+        {
+            _Dots.push_back(Vector2d(std::cos(fT*3.0+i)*(fT+i % 40), std::sin(fT*2.0+i)*(i % 25)));
+        }
+        _Graphics.setColor(0.8, 0.8, 0.8, 1.0);
+        _Graphics.dots(_Dots);
+
+    _Graphics.endRenderBatch();
+
+    // Text
+    if (_pFontManager != nullptr)
+    {
+        _Graphics.setupScreenSpace();
+        _Graphics.beginRenderBatch("font");
+
+            for (auto i=0; i < EVAL_RENDER_NR_OF_TEXTS; ++i)
+            {
+                _pFontManager->setSize(12 + (i % 4)*4);
+                _Graphics.setColor(1.0, 1.0, 1.0, 1.0);
+                _pFontManager->drawText("Frame " + std::to_string(_nFrame) +
+                                        ": The quick brown fox jumps over the lazy dog.",
+                                        10.0f, 10.0f + i * 17.0f);
+            }
+
+        _Graphics.endRenderBatch();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// This is the entrance point for program startup.
+///
+/// \param  argc number of given arguments
+/// \param  argv array, storing the arguments
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char *argv[])
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    std::string strShaderDir = std::string(DEFAULTDATADIR) + "/shader/";
+    std::string strFont = "";
+    int nNrOfFrames = EVAL_RENDER_FRAMES_DEFAULT;
+
+    if (argc > 1) strShaderDir = std::string(argv[1]) + "/";
+    if (argc > 2) strFont = argv[2];
+    if (argc > 3) nNrOfFrames = std::max(1, std::atoi(argv[3]));
+
+    CGraphics& Graphics = CGraphics::getInstance();
+
+    CShader         VertexShaderWorld;
+    CShader         FragmentShaderWorld;
+    CShaderProgram  ShaderProgramWorld;
+    CShader         VertexShaderFont;
+    CShader         FragmentShaderFont;
+    CShaderProgram  ShaderProgramFont;
+    CRenderMode     RenderModeWorld;
+    CRenderMode     RenderModeFont;
+
+    RenderModeWorld.setRenderModeType(RenderModeType::VERT3COL4);
+    RenderModeFont.setRenderModeType(RenderModeType::VERT3COL4TEX2);
+    Graphics.registerRenderMode("world", &RenderModeWorld);
+    Graphics.registerRenderMode("font", &RenderModeFont);
+
+    if (!Graphics.initHeadless(EVAL_RENDER_WIDTH, EVAL_RENDER_HEIGHT))
+    {
+        ERROR_MSG("Render Evaluation", "Failed. Could not initialise headless graphics.")
+        return EXIT_FAILURE;
+    }
+
+    if (!loadShaderProgram(strShaderDir+"default.vert", strShaderDir+"default.frag",
+                           VertexShaderWorld, FragmentShaderWorld, ShaderProgramWorld) ||
+        !loadShaderProgram(strShaderDir+"font.vert", strShaderDir+"font.frag",
+                           VertexShaderFont, FragmentShaderFont, ShaderProgramFont))
+    {
+        ERROR_MSG("Render Evaluation", "Failed. Could not load shaders from " << strShaderDir)
+        return EXIT_FAILURE;
+    }
+    RenderModeWorld.setShaderProgram(&ShaderProgramWorld);
+    RenderModeFont.setShaderProgram(&ShaderProgramFont);
+
+    CFontManager* pFontManager = nullptr;
+    CFontManager FontManager;
+    if (strFont != "")
+    {
+        if (FontManager.addFont("eval", strFont))
+        {
+            FontManager.setFont("eval");
+            pFontManager = &FontManager;
+        }
+    }
+    if (pFontManager == nullptr)
+    {
+        NOTICE_MSG("Render Evaluation", "No font given, text is skipped.")
+    }
+
+    // GPU times are optional, since timer queries might not be supported
+    Graphics.setGPUTimer(true);
+    
+    CCircularBuffer<Vector2d> Dots(EVAL_RENDER_NR_OF_DOTS);
+
+    INFO_MSG("Render Evaluation", "Rendering " << nNrOfFrames << " frames...")
+
+    // First frame includes font rasterisation, hence, it is rendered before
+    renderFrame(Graphics, pFontManager, Dots, 0);
+    Graphics.swapBuffers();
+
+    CTimer FrameTimer;
+    CTimer TotalTimer;
+    double fFrameTimeMin = 1.0e9;
+    double fFrameTimeMax = 0.0;
+    long   nDrawCalls = 0;
+    long   nVerts = 0;
+    long   nUploadBytes = 0;
+
+    TotalTimer.start();
+    for (auto i=1; i <= nNrOfFrames; ++i)
+    {
+        FrameTimer.start();
+
+        renderFrame(Graphics, pFontManager, Dots, i);
+
+        // Statistics are reset by swapping buffers, hence, they are
+        // collected before
+        nDrawCalls   += Graphics.getDrawCalls();
+        nVerts       += Graphics.getVerticesPerFrame();
+        nUploadBytes += Graphics.getUploadBytesPerFrame();
+
+        Graphics.swapBuffers();
+
+        FrameTimer.stop();
+        fFrameTimeMin = std::min(fFrameTimeMin, FrameTimer.getTime());
+        fFrameTimeMax = std::max(fFrameTimeMax, FrameTimer.getTime());
+    }
+    TotalTimer.stop();
+
+    INFO_MSG("Render Evaluation", "Frame time (avg): " << TotalTimer.getTime() / nNrOfFrames * 1000.0 << "ms")
+    INFO_MSG("Render Evaluation", "Frame time (min): " << fFrameTimeMin * 1000.0 << "ms")
+    INFO_MSG("Render Evaluation", "Frame time (max): " << fFrameTimeMax * 1000.0 << "ms")
+    INFO_MSG("Render Evaluation", "Draw calls per frame: " << nDrawCalls / nNrOfFrames)
+    INFO_MSG("Render Evaluation", "Vertices per frame: " << nVerts / nNrOfFrames)
+    INFO_MSG("Render Evaluation", "Bytes uploaded per frame: " << nUploadBytes / nNrOfFrames)
+    std::vector<const CFrameStats*> GPUTimes;
+    Graphics.getStatsGPUTimes(GPUTimes);
+    for (const auto pGPUTime : GPUTimes)
+    {
+        INFO_MSG("Render Evaluation", pGPUTime->getName() << " (p50/p95): " <<
+                                      pGPUTime->getPercentile(50.0) * 1000.0 << "ms / " <<
+                                      pGPUTime->getPercentile(95.0) * 1000.0 << "ms")
+    }
+    INFO_MSG("Render Evaluation", "Passed.")
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       bfe_unit_fixed_timestep.cpp
+/// \brief      Unit test of fixed timestep accumulator
+///
+/// Checks limitation of steps per frame and dropped time, the range of the
+/// interpolation value for random frame times, and that changing the step
+/// size keeps accumulated time.
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+//--- Program header ---------------------------------------------------------//
+#include "conf_bfengine.h"
+#include "fixed_timestep.h"
+
+using namespace bfe;
+
+//--- Misc-Header ------------------------------------------------------------//
+
+//--- Constants --------------------------------------------------------------//
+static constexpr int    RANDOM_FRAMES = 100000; ///< Number of random frame times
+static constexpr double TOLERANCE = 1.0e-9;     ///< Tolerance for sums of random frame times
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// This is the entrance point for program startup.
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    INFO_MSG("Unit test", "Starting unit test...")
+
+    // Step sizes and times are powers of two, hence, results are exact
+    INFO_MSG("Unit test", "Limitation of steps per frame")
+    {
+        CFixedTimestep Timestep;
+        Timestep.setTimestep(0.25);
+        Timestep.setSubstepsMax(4);
+
+        int nNrOfSteps = Timestep.advance(3.0);
+        if (nNrOfSteps != 4 || Timestep.getTimeDropped() != 2.0 || Timestep.getAlpha() != 0.0)
+        {
+            ERROR_MSG("Unit test", "Incorrect steps of overlong frame (steps=" << nNrOfSteps <<
+                                   ", dropped=" << Timestep.getTimeDropped() <<
+                                   ", alpha=" << Timestep.getAlpha() << ").")
+            return EXIT_FAILURE;
+        }
+        nNrOfSteps = Timestep.advance(0.375);
+        if (nNrOfSteps != 1 || Timestep.getTimeDropped() != 2.0 || Timestep.getAlpha() != 0.5)
+        {
+            ERROR_MSG("Unit test", "Incorrect steps of regular frame (steps=" << nNrOfSteps <<
+                                   ", dropped=" << Timestep.getTimeDropped() <<
+                                   ", alpha=" << Timestep.getAlpha() << ").")
+            return EXIT_FAILURE;
+        }
+        // Remainder of the accumulator is kept when steps are limited
+        nNrOfSteps = Timestep.advance(1.5);
+        if (nNrOfSteps != 4 || Timestep.getTimeDropped() != 2.5 || Timestep.getAlpha() != 0.5 ||
+            Timestep.getNrOfSteps() != 9u)
+        {
+            ERROR_MSG("Unit test", "Incorrect dropped time (steps=" << nNrOfSteps <<
+                                   ", dropped=" << Timestep.getTimeDropped() <<
+                                   ", alpha=" << Timestep.getAlpha() << ").")
+            return EXIT_FAILURE;
+        }
+        Timestep.setSubstepsMax(0);
+        if (Timestep.getSubstepsMax() != 4)
+        {
+            ERROR_MSG("Unit test", "Invalid maximum number of steps accepted.")
+            return EXIT_FAILURE;
+        }
+        Timestep.reset();
+        if (Timestep.getTimeDropped() != 0.0 || Timestep.getAlpha() != 0.0 || Timestep.getNrOfSteps() != 0u)
+        {
+            ERROR_MSG("Unit test", "Reset incomplete.")
+            return EXIT_FAILURE;
+        }
+    }
+
+    INFO_MSG("Unit test", "Interpolation of random frame times")
+    {
+        CFixedTimestep Timestep;
+        Timestep.setTimestep(1.0/60.0);
+
+        std::mt19937 Generator(42u);
+        std::uniform_real_distribution<double> FrameTime(0.0, 0.2);
+        double fTime = 0.0;
+        for (auto i=0; i<RANDOM_FRAMES; ++i)
+        {
+            const double fFrameTime = FrameTime(Generator);
+            const int nNrOfSteps = Timestep.advance(fFrameTime);
+            fTime += fFrameTime;
+            if (nNrOfSteps < 0 || nNrOfSteps > Timestep.getSubstepsMax() ||
+                Timestep.getAlpha() < 0.0 || Timestep.getAlpha() >= 1.0)
+            {
+                ERROR_MSG("Unit test", "Incorrect frame " << i << " (steps=" << nNrOfSteps <<
+                                       ", alpha=" << Timestep.getAlpha() << ").")
+                return EXIT_FAILURE;
+            }
+        }
+        // All time is either stepped, dropped, or left to interpolate
+        const double fTimeSum = Timestep.getNrOfSteps() * Timestep.getTimestep() + Timestep.getTimeDropped() +
+                                Timestep.getAlpha() * Timestep.getTimestep();
+        if (std::abs(fTimeSum - fTime) > TOLERANCE * fTime)
+        {
+            ERROR_MSG("Unit test", "Time lost (" << fTimeSum << " of " << fTime << ").")
+            return EXIT_FAILURE;
+        }
+    }
+
+    INFO_MSG("Unit test", "Change of step size")
+    {
+        CFixedTimestep Timestep;
+        Timestep.setTimestep(0.25);
+        Timestep.advance(0.125);
+
+        // Accumulated time is kept, interpolation relative to new step
+        Timestep.setTimestep(0.5);
+        if (Timestep.getAlpha() != 0.25)
+        {
+            ERROR_MSG("Unit test", "Accumulator not kept (alpha=" << Timestep.getAlpha() << ").")
+            return EXIT_FAILURE;
+        }
+        int nNrOfSteps = Timestep.advance(0.375);
+        if (nNrOfSteps != 1 || Timestep.getAlpha() != 0.0)
+        {
+            ERROR_MSG("Unit test", "Incorrect step after change (steps=" << nNrOfSteps <<
+                                   ", alpha=" << Timestep.getAlpha() << ").")
+            return EXIT_FAILURE;
+        }
+
+        // Accumulated time of at least one new step is discarded
+        Timestep.advance(0.25);
+        Timestep.setTimestep(0.25);
+        if (Timestep.getAlpha() != 0.0)
+        {
+            ERROR_MSG("Unit test", "Accumulator exceeding step kept (alpha=" << Timestep.getAlpha() << ").")
+            return EXIT_FAILURE;
+        }
+        nNrOfSteps = Timestep.advance(0.125);
+        if (nNrOfSteps != 0 || Timestep.getAlpha() != 0.5)
+        {
+            ERROR_MSG("Unit test", "Incorrect step after change (steps=" << nNrOfSteps <<
+                                   ", alpha=" << Timestep.getAlpha() << ").")
+            return EXIT_FAILURE;
+        }
+    }
+
+    INFO_MSG("Unit test", "...done. Test successful.")
+    return EXIT_SUCCESS;
+}
@@ -28,7 +28,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
-/// \file       pw_unit_handle.cpp
+/// \file       bfe_unit_handle.cpp
 /// \brief      Main program for unit test
 ///
 /// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
@@ -41,10 +41,12 @@
 #include <string>
 
 //--- Program header ---------------------------------------------------------//
-#include "conf_pw.h"
+#include "conf_bfengine.h"
 #include "log.h"
 #include "handle.h"
 
+using namespace bfe;
+
 //--- Misc-Header ------------------------------------------------------------//
 
 //--- Constants --------------------------------------------------------------//
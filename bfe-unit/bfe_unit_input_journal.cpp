@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       bfe_unit_input_journal.cpp
+/// \brief      Unit test of input recording and replay
+///
+/// Records a sequence of input events, replays it, and compares events and
+/// their frames. The file format is checked to be independent of platform.
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "conf_bfengine.h"
+#include "input_journal.h"
+
+using namespace bfe;
+
+//--- Misc-Header ------------------------------------------------------------//
+
+//--- Constants --------------------------------------------------------------//
+static constexpr char          JOURNAL_FILE[] = "bfe_unit_input_journal.bin";  ///< Temporary journal
+static constexpr double        JOURNAL_FREQUENCY = 123.25;                     ///< Input frequency recorded
+static constexpr std::uint64_t FRAME_TIME = 1000000000u;                       ///< Time between frames in ns
+
+/// Recorded event with its frame
+struct FrameEventType
+{
+    std::uint32_t   unFrame;    ///< Input frame of event
+    InputEventType  Event;      ///< Event
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// This is the entrance point for program startup.
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    INFO_MSG("Unit test", "Starting unit test...")
+
+    // Events of several frames, including negative values and frames
+    // without events
+    const std::vector<FrameEventType> Events =
+    {
+        {0u, {0u, 0, 0, InputEventKindType::KEY_PRESSED, 0u}},
+        {0u, {2000u, 800, 600, InputEventKindType::RESIZED, 0u}},
+        {3u, {3*FRAME_TIME + 5000u, -17, 2147483647, InputEventKindType::MOUSE_MOVED, INPUT_BUTTON_LEFT}},
+        {3u, {3*FRAME_TIME + 7000u, -2147483647-1, -1, InputEventKindType::MOUSE_WHEEL, INPUT_BUTTON_RIGHT}},
+        {7u, {7*FRAME_TIME + 999000u, 0x263A, 0, InputEventKindType::TEXT, 0u}}
+    };
+    const std::uint32_t unNrOfFrames = 10u;
+
+    INFO_MSG("Unit test", "Recording")
+    {
+        CInputJournal Journal;
+        if (!Journal.startRecording(JOURNAL_FILE, JOURNAL_FREQUENCY))
+        {
+            ERROR_MSG("Unit test", "Recording could not be started.")
+            return EXIT_FAILURE;
+        }
+        for (const auto& FrameEvent : Events)
+        {
+            Journal.record(FrameEvent.unFrame, FrameEvent.unFrame*FRAME_TIME, FrameEvent.Event);
+        }
+        Journal.stop();
+    }
+
+    INFO_MSG("Unit test", "Checking file format")
+    {
+        std::ifstream InStream(JOURNAL_FILE, std::ios::in|std::ios::binary|std::ios::ate);
+        const std::streamsize nSize = InStream.tellg();
+        if (nSize != std::streamsize(INPUT_JOURNAL_HEADER_SIZE + Events.size()*INPUT_JOURNAL_RECORD_SIZE))
+        {
+            ERROR_MSG("Unit test", "Incorrect size of journal (" << nSize << " bytes).")
+            return EXIT_FAILURE;
+        }
+        // Magic number and a negative value are little endian
+        unsigned char aBytes[INPUT_JOURNAL_HEADER_SIZE + 2*INPUT_JOURNAL_RECORD_SIZE];
+        InStream.seekg(0, std::ios::beg);
+        InStream.read(reinterpret_cast<char*>(aBytes), sizeof(aBytes));
+        if (aBytes[0] != 0x42u || aBytes[1] != 0x46u || aBytes[2] != 0x45u || aBytes[3] != 0x49u)
+        {
+            ERROR_MSG("Unit test", "Incorrect magic number.")
+            return EXIT_FAILURE;
+        }
+        const unsigned char* const pRecord = aBytes + INPUT_JOURNAL_HEADER_SIZE + INPUT_JOURNAL_RECORD_SIZE;
+        if (pRecord[4] != 2u || pRecord[8] != 0x20u || pRecord[9] != 0x03u || pRecord[16] != 1u)
+        {
+            ERROR_MSG("Unit test", "Incorrect encoding of record.")
+            return EXIT_FAILURE;
+        }
+    }
+
+    INFO_MSG("Unit test", "Replaying")
+    {
+        CInputJournal Journal;
+        if (!Journal.startReplay(JOURNAL_FILE))
+        {
+            ERROR_MSG("Unit test", "Replay could not be started.")
+            return EXIT_FAILURE;
+        }
+        if (Journal.getFrequency() != JOURNAL_FREQUENCY)
+        {
+            ERROR_MSG("Unit test", "Incorrect frequency (" << Journal.getFrequency() << ").")
+            return EXIT_FAILURE;
+        }
+
+        // Replay starts at a different time, timestamps are relative to frames
+        const std::uint64_t nStart = 42u*FRAME_TIME;
+        std::size_t nNext = 0u;
+        for (auto unFrame=0u; unFrame<unNrOfFrames; ++unFrame)
+        {
+            const std::uint64_t nFrameTime = nStart + unFrame*FRAME_TIME;
+            InputEventType Event;
+            while (Journal.next(unFrame, nFrameTime, Event))
+            {
+                if (nNext == Events.size())
+                {
+                    ERROR_MSG("Unit test", "Too many events replayed.")
+                    return EXIT_FAILURE;
+                }
+                const FrameEventType& Expected = Events[nNext++];
+                const std::uint64_t nExpectedTime = nFrameTime + Expected.Event.nTime - Expected.unFrame*FRAME_TIME;
+                if (unFrame != Expected.unFrame ||
+                    Event.nTime != nExpectedTime ||
+                    Event.nA != Expected.Event.nA ||
+                    Event.nB != Expected.Event.nB ||
+                    Event.Kind != Expected.Event.Kind ||
+                    Event.nButtons != Expected.Event.nButtons)
+                {
+                    ERROR_MSG("Unit test", "Incorrect event " << nNext-1u << " in frame " << unFrame << ".")
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+        if (nNext != Events.size())
+        {
+            ERROR_MSG("Unit test", "Only " << nNext << " of " << Events.size() << " events replayed.")
+            return EXIT_FAILURE;
+        }
+        if (Journal.isReplaying())
+        {
+            ERROR_MSG("Unit test", "Replay not finished.")
+            return EXIT_FAILURE;
+        }
+    }
+    std::remove(JOURNAL_FILE);
+
+    INFO_MSG("Unit test", "...done. Test successful.")
+    return EXIT_SUCCESS;
+}
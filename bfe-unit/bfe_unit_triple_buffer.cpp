@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       bfe_unit_triple_buffer.cpp
+/// \brief      Unit test of lock free triple buffer
+///
+/// Checks that only the latest packet is taken over, and that packets handed
+/// over from a producer thread to a consumer thread are complete and in
+/// order.
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+
+//--- Program header ---------------------------------------------------------//
+#include "conf_bfengine.h"
+#include "triple_buffer.h"
+
+using namespace bfe;
+
+//--- Misc-Header ------------------------------------------------------------//
+
+//--- Constants --------------------------------------------------------------//
+static constexpr std::uint32_t NR_OF_PACKETS = 1000000u;    ///< Number of packets handed over between threads
+static constexpr std::size_t   PACKET_SIZE = 64u;           ///< Number of values per packet
+
+/// Packet, consistent if all values are derived from its number
+struct PacketType
+{
+    std::uint32_t                               unNr = 0u;  ///< Number of packet
+    std::array<std::uint32_t, PACKET_SIZE>      aValues{};  ///< Values, unNr+i each
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Writes a complete packet of given number
+///
+/// \param _Packet Packet to be written
+/// \param _unNr Number of packet
+///
+////////////////////////////////////////////////////////////////////////////////
+void writePacket(PacketType& _Packet, const std::uint32_t _unNr)
+{
+    _Packet.unNr = _unNr;
+    for (auto i=0u; i<PACKET_SIZE; ++i) _Packet.aValues[i] = _unNr + i;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Checks if packet is complete, i.e. not torn
+///
+/// \param _Packet Packet to be checked
+///
+/// \return Complete?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool isComplete(const PacketType& _Packet)
+{
+    for (auto i=0u; i<PACKET_SIZE; ++i)
+    {
+        if (_Packet.aValues[i] != _Packet.unNr + i) return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// This is the entrance point for program startup.
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    INFO_MSG("Unit test", "Starting unit test...")
+
+    INFO_MSG("Unit test", "Latest packet only")
+    {
+        CTripleBuffer<PacketType> Packets;
+        if (Packets.update())
+        {
+            ERROR_MSG("Unit test", "Packet taken over before publishing.")
+            return EXIT_FAILURE;
+        }
+        for (auto unNr=1u; unNr<=3u; ++unNr)
+        {
+            writePacket(Packets.getWriteBuffer(), unNr);
+            Packets.publish();
+        }
+        if (!Packets.update() || Packets.getReadBuffer().unNr != 3u)
+        {
+            ERROR_MSG("Unit test", "Latest packet not taken over (packet " << Packets.getReadBuffer().unNr << ").")
+            return EXIT_FAILURE;
+        }
+        if (Packets.update() || Packets.getReadBuffer().unNr != 3u)
+        {
+            ERROR_MSG("Unit test", "Packet taken over twice.")
+            return EXIT_FAILURE;
+        }
+        writePacket(Packets.getWriteBuffer(), 4u);
+        if (Packets.getReadBuffer().unNr != 3u)
+        {
+            ERROR_MSG("Unit test", "Packet changed while read.")
+            return EXIT_FAILURE;
+        }
+        Packets.publish();
+        if (!Packets.update() || Packets.getReadBuffer().unNr != 4u)
+        {
+            ERROR_MSG("Unit test", "Packet not taken over after reading.")
+            return EXIT_FAILURE;
+        }
+    }
+
+    INFO_MSG("Unit test", "Producer and consumer thread")
+    {
+        CTripleBuffer<PacketType> Packets;
+
+        std::thread Producer([&Packets]
+        {
+            for (auto unNr=1u; unNr<=NR_OF_PACKETS; ++unNr)
+            {
+                writePacket(Packets.getWriteBuffer(), unNr);
+                Packets.publish();
+            }
+        });
+
+        // Consumer takes over packets until the last one arrived. Each one
+        // has to be complete and newer than the previous one.
+        std::uint32_t unNrLast = 0u;
+        std::uint32_t unNrOfPackets = 0u;
+        bool bSuccess = true;
+        while (unNrLast != NR_OF_PACKETS)
+        {
+            if (!Packets.update()) continue;
+
+            const PacketType& Packet = Packets.getReadBuffer();
+            if (!isComplete(Packet))
+            {
+                ERROR_MSG("Unit test", "Packet " << Packet.unNr << " torn.")
+                bSuccess = false;
+                break;
+            }
+            if (Packet.unNr <= unNrLast)
+            {
+                ERROR_MSG("Unit test", "Packet " << Packet.unNr << " not newer than " << unNrLast << ".")
+                bSuccess = false;
+                break;
+            }
+            unNrLast = Packet.unNr;
+            ++unNrOfPackets;
+        }
+        Producer.join();
+        if (!bSuccess) return EXIT_FAILURE;
+
+        INFO_MSG("Unit test", unNrOfPackets << " of " << NR_OF_PACKETS << " packets taken over.")
+    }
+
+    INFO_MSG("Unit test", "...done. Test successful.")
+    return EXIT_SUCCESS;
+}
@@ -28,7 +28,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
-/// \file       pw_unit_uid.cpp
+/// \file       bfe_unit_uid.cpp
 /// \brief      Main program for unit test
 ///
 /// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
@@ -39,9 +39,11 @@
 //--- Standard header --------------------------------------------------------//
 
 //--- Program header ---------------------------------------------------------//
-#include "conf_pw.h"
+#include "conf_bfengine.h"
 #include "uid.h"
 
+using namespace bfe;
+
 //--- Misc-Header ------------------------------------------------------------//
 
 ////////////////////////////////////////////////////////////////////////////////
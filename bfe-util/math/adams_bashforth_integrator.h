@@ -71,11 +71,13 @@ class CAdamsBashforthIntegrator : public IIntegrator<T>
     protected:
       
         //--- Protected methods ----------------------------------------------//
+        int           derivIndex(const int) const;
         std::istream& myStreamIn(std::istream&);
         std::ostream& myStreamOut(std::ostream&);
 
         //--- Protected Variables --------------------------------------------//
         T    m_Deriv[4];      ///< Derivatives of previous timesteps
+        int  m_nDerivBase;    ///< Index of newest derivative, history is a ring
         T    m_PrevValue;     ///< Calculated value of previous timestep
         T    m_Value;         ///< Calculated value
 
@@ -83,6 +85,26 @@ class CAdamsBashforthIntegrator : public IIntegrator<T>
 
 //--- Implementation is done here for inline optimisation --------------------//
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns index of derivative of given age within the ring
+///
+/// Derivatives are not shifted each timestep, instead, the index of the
+/// newest one is rotated.
+///
+/// \param _nAge Age of derivative, 0 being the newest one
+///
+/// \return Index of derivative
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline int CAdamsBashforthIntegrator<T>::derivIndex(const int _nAge) const
+{
+    METHOD_ENTRY("CAdamsBashforthIntegrator::derivIndex")
+    const int nI = m_nDerivBase + _nAge;
+    return (nI < 4) ? nI : nI-4;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Returns value of the previous timestep
@@ -34,7 +34,7 @@
 ///
 ///////////////////////////////////////////////////////////////////////////////
 template <class T>
-CAdamsBashforthIntegrator<T>::CAdamsBashforthIntegrator() : m_PrevValue(0.0), m_Value(0.0)
+CAdamsBashforthIntegrator<T>::CAdamsBashforthIntegrator() : m_nDerivBase(0), m_PrevValue(0.0), m_Value(0.0)
 {
     METHOD_ENTRY("CAdamsBashforthIntegrator::CAdamsBashforthIntegrator")
     CTOR_CALL("CAdamsBashforthIntegrator::CAdamsBashforthIntegrator")
@@ -51,7 +51,7 @@ CAdamsBashforthIntegrator<T>::CAdamsBashforthIntegrator() : m_PrevValue(0.0), m_
 ///
 ///////////////////////////////////////////////////////////////////////////////
 template <>
-inline CAdamsBashforthIntegrator<Vector2d>::CAdamsBashforthIntegrator()
+inline CAdamsBashforthIntegrator<Vector2d>::CAdamsBashforthIntegrator() : m_nDerivBase(0)
 {
     METHOD_ENTRY("CAdamsBashforthIntegrator::CAdamsBashforthIntegrator")
     CTOR_CALL("CAdamsBashforthIntegrator::CAdamsBashforthIntegrator")
@@ -111,16 +111,14 @@ const T CAdamsBashforthIntegrator<T>::integrate(const T& _V, const double& _fSte
 {
     METHOD_ENTRY("CAdamsBashforthIntegrator::integrate")
 
-    m_Deriv[3] = m_Deriv[2];
-    m_Deriv[2] = m_Deriv[1];
-    m_Deriv[1] = m_Deriv[0];
-    m_Deriv[0] = _V;
+    m_nDerivBase = (m_nDerivBase == 0) ? 3 : m_nDerivBase-1;
+    m_Deriv[m_nDerivBase] = _V;
 
     m_PrevValue = m_Value;
-    m_Value +=   (m_Deriv[0] * 55.0/24.0 - 
-                     m_Deriv[1] * 59.0/24.0 +
-                     m_Deriv[2] * 37.0/24.0 -
-                     m_Deriv[3] *  3.0/ 8.0) *
+    m_Value +=   (m_Deriv[this->derivIndex(0)] * 55.0/24.0 - 
+                     m_Deriv[this->derivIndex(1)] * 59.0/24.0 +
+                     m_Deriv[this->derivIndex(2)] * 37.0/24.0 -
+                     m_Deriv[this->derivIndex(3)] *  3.0/ 8.0) *
                     _fStep;
 
     return m_Value;
@@ -148,16 +146,14 @@ const T CAdamsBashforthIntegrator<T>::integrateClip(const T& _V,
 {
     METHOD_ENTRY("CAdamsBashforthIntegrator::integrate")
 
-    m_Deriv[3] = m_Deriv[2];
-    m_Deriv[2] = m_Deriv[1];
-    m_Deriv[1] = m_Deriv[0];
-    m_Deriv[0] = _V;
+    m_nDerivBase = (m_nDerivBase == 0) ? 3 : m_nDerivBase-1;
+    m_Deriv[m_nDerivBase] = _V;
 
     m_PrevValue = m_Value;
-    m_Value +=   (m_Deriv[0] * 55.0/24.0 - 
-                     m_Deriv[1] * 59.0/24.0 +
-                     m_Deriv[2] * 37.0/24.0 -
-                     m_Deriv[3] *  3.0/ 8.0) *
+    m_Value +=   (m_Deriv[this->derivIndex(0)] * 55.0/24.0 - 
+                     m_Deriv[this->derivIndex(1)] * 59.0/24.0 +
+                     m_Deriv[this->derivIndex(2)] * 37.0/24.0 -
+                     m_Deriv[this->derivIndex(3)] *  3.0/ 8.0) *
                     _fStep;
                
     int nF = floor(m_Value / _Clip);
@@ -191,16 +187,14 @@ inline const Vector2d CAdamsBashforthIntegrator<Vector2d>::integrateClip(const V
 {
     METHOD_ENTRY("CAdamsBashforthIntegrator::integrate")
 
-    m_Deriv[3] = m_Deriv[2];
-    m_Deriv[2] = m_Deriv[1];
-    m_Deriv[1] = m_Deriv[0];
-    m_Deriv[0] = _V;
+    m_nDerivBase = (m_nDerivBase == 0) ? 3 : m_nDerivBase-1;
+    m_Deriv[m_nDerivBase] = _V;
 
     m_PrevValue = m_Value;
-    m_Value +=   (m_Deriv[0] * 55.0/24.0 - 
-                     m_Deriv[1] * 59.0/24.0 +
-                     m_Deriv[2] * 37.0/24.0 -
-                     m_Deriv[3] *  3.0/ 8.0) *
+    m_Value +=   (m_Deriv[this->derivIndex(0)] * 55.0/24.0 - 
+                     m_Deriv[this->derivIndex(1)] * 59.0/24.0 +
+                     m_Deriv[this->derivIndex(2)] * 37.0/24.0 -
+                     m_Deriv[this->derivIndex(3)] *  3.0/ 8.0) *
                     _fStep;
                     
     int nF = floor(m_Value[0] / _Clip[0]);
@@ -235,6 +229,7 @@ void CAdamsBashforthIntegrator<T>::init(const T& _V)
     m_Deriv[1]=0;
     m_Deriv[2]=0;
     m_Deriv[3]=0;
+    m_nDerivBase = 0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -255,6 +250,7 @@ inline void CAdamsBashforthIntegrator<Vector2d>::init(const Vector2d& _V)
     m_Deriv[1].setZero();
     m_Deriv[2].setZero();
     m_Deriv[3].setZero();
+    m_nDerivBase = 0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -273,6 +269,7 @@ void CAdamsBashforthIntegrator<T>::reset()
     m_Deriv[1]=0;
     m_Deriv[2]=0;
     m_Deriv[3]=0;
+    m_nDerivBase = 0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -291,6 +288,7 @@ inline void CAdamsBashforthIntegrator<Vector2d>::reset()
     m_Deriv[1].setZero();
     m_Deriv[2].setZero();
     m_Deriv[3].setZero();
+    m_nDerivBase = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -307,6 +305,7 @@ std::istream& CAdamsBashforthIntegrator<T>::myStreamIn(std::istream& _is)
 {
     METHOD_ENTRY("CAdamsBashforthIntegrator::myStreamIn")
     
+    m_nDerivBase = 0;
     _is >> m_Deriv[0] >> m_Deriv[1] >> m_Deriv[2] >> m_Deriv[3];
     _is >> m_PrevValue;
     _is >> m_Value;
@@ -328,6 +327,7 @@ inline std::istream& CAdamsBashforthIntegrator<Vector2d>::myStreamIn(std::istrea
 {
     METHOD_ENTRY("CAdamsBashforthIntegrator::myStreamIn")
     
+    m_nDerivBase = 0;
     _is >> m_Deriv[0][0] >> m_Deriv[0][1] >> m_Deriv[1][0] >> m_Deriv[1][1] >>
            m_Deriv[2][0] >> m_Deriv[2][1] >> m_Deriv[3][0] >> m_Deriv[3][1];
     _is >> m_PrevValue[0] >> m_PrevValue[1];
@@ -350,10 +350,10 @@ std::ostream& CAdamsBashforthIntegrator<T>::myStreamOut(std::ostream& _os)
 {
     METHOD_ENTRY("CAdamsBashforthIntegrator::myStreamOut")
     
-    _os << m_Deriv[0] << std::endl; 
-    _os << m_Deriv[1] << std::endl;
-    _os << m_Deriv[2] << std::endl;
-    _os << m_Deriv[3] << std::endl;
+    _os << m_Deriv[this->derivIndex(0)] << std::endl; 
+    _os << m_Deriv[this->derivIndex(1)] << std::endl;
+    _os << m_Deriv[this->derivIndex(2)] << std::endl;
+    _os << m_Deriv[this->derivIndex(3)] << std::endl;
     _os << m_PrevValue << std::endl;
     _os << m_Value << std::endl;
     
@@ -374,10 +374,10 @@ inline std::ostream& CAdamsBashforthIntegrator<Vector2d>::myStreamOut(std::ostre
 {
     METHOD_ENTRY("CAdamsBashforthIntegrator::myStreamOut")
     
-    _os << m_Deriv[0][0] << " " << m_Deriv[0][1] << std::endl; 
-    _os << m_Deriv[1][0] << " " << m_Deriv[1][1] << std::endl; 
-    _os << m_Deriv[2][0] << " " << m_Deriv[2][1] << std::endl; 
-    _os << m_Deriv[3][0] << " " << m_Deriv[3][1] << std::endl; 
+    _os << m_Deriv[this->derivIndex(0)][0] << " " << m_Deriv[this->derivIndex(0)][1] << std::endl; 
+    _os << m_Deriv[this->derivIndex(1)][0] << " " << m_Deriv[this->derivIndex(1)][1] << std::endl; 
+    _os << m_Deriv[this->derivIndex(2)][0] << " " << m_Deriv[this->derivIndex(2)][1] << std::endl; 
+    _os << m_Deriv[this->derivIndex(3)][0] << " " << m_Deriv[this->derivIndex(3)][1] << std::endl; 
     _os << m_PrevValue[0] << " " << m_PrevValue[1] << std::endl;
     _os << m_Value[0] << " " << m_Value[1] << std::endl;
     
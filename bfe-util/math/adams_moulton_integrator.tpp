@@ -35,7 +35,7 @@
 ///
 ///////////////////////////////////////////////////////////////////////////////
 template <class T>
-CAdamsMoultonIntegrator<T>::CAdamsMoultonIntegrator() : m_PrevValue(0.0), m_Value(0.0)
+CAdamsMoultonIntegrator<T>::CAdamsMoultonIntegrator() : m_nDerivBase(0), m_PrevValue(0.0), m_Value(0.0)
 {
     METHOD_ENTRY("CAdamsMoultonIntegrator::CAdamsMoultonIntegrator")
     CTOR_CALL("CAdamsMoultonIntegrator::CAdamsMoultonIntegrator")
@@ -53,7 +53,7 @@ CAdamsMoultonIntegrator<T>::CAdamsMoultonIntegrator() : m_PrevValue(0.0), m_Valu
 ///
 ///////////////////////////////////////////////////////////////////////////////
 template <>
-inline CAdamsMoultonIntegrator<Vector2d>::CAdamsMoultonIntegrator()
+inline CAdamsMoultonIntegrator<Vector2d>::CAdamsMoultonIntegrator() : m_nDerivBase(0)
 {
     METHOD_ENTRY("CAdamsMoultonIntegrator::CAdamsMoultonIntegrator")
     CTOR_CALL("CAdamsMoultonIntegrator::CAdamsMoultonIntegrator")
@@ -115,18 +115,15 @@ const T CAdamsMoultonIntegrator<T>::integrate(const T& _V,
 {
     METHOD_ENTRY("CAdamsMoultonIntegrator::integrate")
 
-    m_Deriv[4] = m_Deriv[3];
-    m_Deriv[3] = m_Deriv[2];
-    m_Deriv[2] = m_Deriv[1];
-    m_Deriv[1] = m_Deriv[0];
-    m_Deriv[0] = _V;
+    m_nDerivBase = (m_nDerivBase == 0) ? 4 : m_nDerivBase-1;
+    m_Deriv[m_nDerivBase] = _V;
 
     m_PrevValue = m_Value;
-    m_Value   += (m_Deriv[0] * 251.0/720.0 + 
-                  m_Deriv[1] * 646.0/720.0 -
-                  m_Deriv[2] * 264.0/720.0 +
-                  m_Deriv[3] * 106.0/720.0 -
-                  m_Deriv[4] * 19.0 /720.0) *
+    m_Value   += (m_Deriv[this->derivIndex(0)] * 251.0/720.0 + 
+                  m_Deriv[this->derivIndex(1)] * 646.0/720.0 -
+                  m_Deriv[this->derivIndex(2)] * 264.0/720.0 +
+                  m_Deriv[this->derivIndex(3)] * 106.0/720.0 -
+                  m_Deriv[this->derivIndex(4)] * 19.0 /720.0) *
                   _fStep;
     return m_Value;
 }
@@ -153,18 +150,15 @@ const T CAdamsMoultonIntegrator<T>::integrateClip(const T& _V,
 {
     METHOD_ENTRY("CAdamsMoultonIntegrator::integrate")
 
-    m_Deriv[4] = m_Deriv[3];
-    m_Deriv[3] = m_Deriv[2];
-    m_Deriv[2] = m_Deriv[1];
-    m_Deriv[1] = m_Deriv[0];
-    m_Deriv[0] = _V;
+    m_nDerivBase = (m_nDerivBase == 0) ? 4 : m_nDerivBase-1;
+    m_Deriv[m_nDerivBase] = _V;
 
     m_PrevValue = m_Value;
-    m_Value   += (m_Deriv[0] * 251.0/720.0 + 
-                  m_Deriv[1] * 646.0/720.0 -
-                  m_Deriv[2] * 264.0/720.0 +
-                  m_Deriv[3] * 106.0/720.0 -
-                  m_Deriv[4] * 19.0 /720.0) *
+    m_Value   += (m_Deriv[this->derivIndex(0)] * 251.0/720.0 + 
+                  m_Deriv[this->derivIndex(1)] * 646.0/720.0 -
+                  m_Deriv[this->derivIndex(2)] * 264.0/720.0 +
+                  m_Deriv[this->derivIndex(3)] * 106.0/720.0 -
+                  m_Deriv[this->derivIndex(4)] * 19.0 /720.0) *
                   _fStep;
                   
     int nF = floor(m_Value / _Clip);
@@ -198,18 +192,15 @@ inline const Vector2d CAdamsMoultonIntegrator<Vector2d>::integrateClip(const Vec
 {
     METHOD_ENTRY("CAdamsMoultonIntegrator::integrate")
 
-    m_Deriv[4] = m_Deriv[3];
-    m_Deriv[3] = m_Deriv[2];
-    m_Deriv[2] = m_Deriv[1];
-    m_Deriv[1] = m_Deriv[0];
-    m_Deriv[0] = _V;
+    m_nDerivBase = (m_nDerivBase == 0) ? 4 : m_nDerivBase-1;
+    m_Deriv[m_nDerivBase] = _V;
 
     m_PrevValue = m_Value;
-    m_Value   += (m_Deriv[0] * 251.0/720.0 + 
-                  m_Deriv[1] * 646.0/720.0 -
-                  m_Deriv[2] * 264.0/720.0 +
-                  m_Deriv[3] * 106.0/720.0 -
-                  m_Deriv[4] * 19.0 /720.0) *
+    m_Value   += (m_Deriv[this->derivIndex(0)] * 251.0/720.0 + 
+                  m_Deriv[this->derivIndex(1)] * 646.0/720.0 -
+                  m_Deriv[this->derivIndex(2)] * 264.0/720.0 +
+                  m_Deriv[this->derivIndex(3)] * 106.0/720.0 -
+                  m_Deriv[this->derivIndex(4)] * 19.0 /720.0) *
                   _fStep;
                   
     int nF = floor(m_Value[0] / _Clip[0]);
@@ -245,7 +236,7 @@ void CAdamsMoultonIntegrator<T>::init(const T& _V)
     m_Deriv[2]=0;
     m_Deriv[3]=0;
     m_Deriv[4]=0;
-
+    m_nDerivBase = 0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -267,6 +258,7 @@ inline void CAdamsMoultonIntegrator<Vector2d>::init(const Vector2d& _V)
     m_Deriv[2].setZero();
     m_Deriv[3].setZero();
     m_Deriv[4].setZero();
+    m_nDerivBase = 0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -286,6 +278,7 @@ void CAdamsMoultonIntegrator<T>::reset()
     m_Deriv[2]=0;
     m_Deriv[3]=0;
     m_Deriv[4]=0;
+    m_nDerivBase = 0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -305,6 +298,7 @@ inline void CAdamsMoultonIntegrator<Vector2d>::reset()
     m_Deriv[2].setZero();
     m_Deriv[3].setZero();
     m_Deriv[4].setZero();
+    m_nDerivBase = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -321,6 +315,7 @@ std::istream& CAdamsMoultonIntegrator<T>::myStreamIn(std::istream& _is)
 {
     METHOD_ENTRY("CAdamsMoultonIntegrator::myStreamIn")
     
+    m_nDerivBase = 0;
     _is >> m_Deriv[0] >> m_Deriv[1] >> m_Deriv[2] >> m_Deriv[3] >> m_Deriv[4];
     _is >> m_PrevValue;
     _is >> m_Value;
@@ -342,9 +337,10 @@ inline std::istream& CAdamsMoultonIntegrator<Vector2d>::myStreamIn(std::istream&
 {
     METHOD_ENTRY("CAdamsMoultonIntegrator::myStreamIn")
     
+    m_nDerivBase = 0;
     _is >> m_Deriv[0][0] >> m_Deriv[0][1] >> m_Deriv[1][0] >> m_Deriv[1][1] >>
            m_Deriv[2][0] >> m_Deriv[2][1] >> m_Deriv[3][0] >> m_Deriv[3][1] >>
-           m_Deriv[4][0] >> m_Deriv[4][0];
+           m_Deriv[4][0] >> m_Deriv[4][1];
     _is >> m_PrevValue[0] >> m_PrevValue[1];
     _is >> m_Value[0] >> m_Value[1];
     
@@ -365,11 +361,11 @@ std::ostream& CAdamsMoultonIntegrator<T>::myStreamOut(std::ostream& _os)
 {
     METHOD_ENTRY("CAdamsMoultonIntegrator::myStreamOut")
     
-    _os << m_Deriv[0] << std::endl; 
-    _os << m_Deriv[1] << std::endl;
-    _os << m_Deriv[2] << std::endl;
-    _os << m_Deriv[3] << std::endl;
-    _os << m_Deriv[4] << std::endl;
+    _os << m_Deriv[this->derivIndex(0)] << std::endl; 
+    _os << m_Deriv[this->derivIndex(1)] << std::endl;
+    _os << m_Deriv[this->derivIndex(2)] << std::endl;
+    _os << m_Deriv[this->derivIndex(3)] << std::endl;
+    _os << m_Deriv[this->derivIndex(4)] << std::endl;
     _os << m_PrevValue << std::endl;
     _os << m_Value << std::endl;
     
@@ -390,11 +386,11 @@ inline std::ostream& CAdamsMoultonIntegrator<Vector2d>::myStreamOut(std::ostream
 {
     METHOD_ENTRY("CAdamsMoultonIntegrator::myStreamOut")
     
-    _os << m_Deriv[0][0] << " " << m_Deriv[0][1] << std::endl; 
-    _os << m_Deriv[1][0] << " " << m_Deriv[1][1] << std::endl; 
-    _os << m_Deriv[2][0] << " " << m_Deriv[2][1] << std::endl; 
-    _os << m_Deriv[3][0] << " " << m_Deriv[3][1] << std::endl;
-    _os << m_Deriv[4][0] << " " << m_Deriv[4][1] << std::endl; 
+    _os << m_Deriv[this->derivIndex(0)][0] << " " << m_Deriv[this->derivIndex(0)][1] << std::endl; 
+    _os << m_Deriv[this->derivIndex(1)][0] << " " << m_Deriv[this->derivIndex(1)][1] << std::endl; 
+    _os << m_Deriv[this->derivIndex(2)][0] << " " << m_Deriv[this->derivIndex(2)][1] << std::endl; 
+    _os << m_Deriv[this->derivIndex(3)][0] << " " << m_Deriv[this->derivIndex(3)][1] << std::endl;
+    _os << m_Deriv[this->derivIndex(4)][0] << " " << m_Deriv[this->derivIndex(4)][1] << std::endl; 
     _os << m_PrevValue[0] << " " << m_PrevValue[1] << std::endl;
     _os << m_Value[0] << " " << m_Value[1] << std::endl;
     
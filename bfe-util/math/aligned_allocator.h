@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       aligned_allocator.h
+/// \brief      Prototype of template class "CAlignedAllocator"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ALIGNED_ALLOCATOR_H
+#define ALIGNED_ALLOCATOR_H
+
+//--- Standard header --------------------------------------------------------//
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+
+/// BFEngine namespace
+namespace bfe
+{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Allocator for standard containers, aligning storage to given
+///        boundary
+///
+/// Used for arrays processed in chunks of cache lines, e.g. by
+/// CBatchIntegrator, so chunks start at a cache line boundary. Memory is
+/// over-allocated, the original address is stored right in front of the
+/// aligned storage. Alignment must be a power of two.
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, std::size_t TAlign>
+class CAlignedAllocator
+{
+
+    static_assert((TAlign & (TAlign-1u)) == 0u && TAlign >= sizeof(void*),
+                  "Alignment must be a power of two, at least the size of a pointer.");
+
+    public:
+
+        typedef T value_type;
+
+        /// Same allocator for other types, required due to alignment parameter
+        template <class U>
+        struct rebind
+        {
+            typedef CAlignedAllocator<U, TAlign> other; ///< Allocator of type U
+        };
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CAlignedAllocator() = default;
+        template <class U>
+        CAlignedAllocator(const CAlignedAllocator<U, TAlign>&) {}
+
+        //--- Methods --------------------------------------------------------//
+        T*   allocate(const std::size_t);
+        void deallocate(T* const, const std::size_t);
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Allocates aligned storage for given number of elements
+///
+/// \param _nNrOfElements Number of elements
+///
+/// \return Aligned storage
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, std::size_t TAlign>
+inline T* CAlignedAllocator<T, TAlign>::allocate(const std::size_t _nNrOfElements)
+{
+    if (_nNrOfElements > (std::numeric_limits<std::size_t>::max() - TAlign - sizeof(void*)) / sizeof(T))
+        throw std::bad_alloc();
+
+    void* const pRaw = ::operator new(_nNrOfElements*sizeof(T) + TAlign + sizeof(void*));
+    const std::uintptr_t nAligned = (reinterpret_cast<std::uintptr_t>(pRaw) + sizeof(void*) + TAlign - 1u) &
+                                    ~std::uintptr_t(TAlign - 1u);
+    reinterpret_cast<void**>(nAligned)[-1] = pRaw;
+    return reinterpret_cast<T*>(nAligned);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Frees storage allocated by \ref allocate
+///
+/// \param _p Aligned storage
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, std::size_t TAlign>
+inline void CAlignedAllocator<T, TAlign>::deallocate(T* const _p, const std::size_t)
+{
+    if (_p != nullptr) ::operator delete(reinterpret_cast<void**>(_p)[-1]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Allocators are stateless, hence, all of them are equal
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class U, std::size_t TAlign>
+inline bool operator==(const CAlignedAllocator<T, TAlign>&, const CAlignedAllocator<U, TAlign>&)
+{
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Allocators are stateless, hence, all of them are equal
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class U, std::size_t TAlign>
+inline bool operator!=(const CAlignedAllocator<T, TAlign>&, const CAlignedAllocator<U, TAlign>&)
+{
+    return false;
+}
+
+} // namespace bfe
+
+#endif // ALIGNED_ALLOCATOR_H
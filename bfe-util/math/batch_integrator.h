@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       batch_integrator.h
+/// \brief      Prototype of template class "CBatchIntegrator"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-16
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BATCH_INTEGRATOR_H
+#define BATCH_INTEGRATOR_H
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "aligned_allocator.h"
+#include "batch_integrator_kernels.h"
+#include "integrator.h"
+
+/// BFEngine namespace
+namespace bfe
+{
+
+//--- Constants --------------------------------------------------------------//
+constexpr std::size_t BATCH_INTEGRATOR_CACHE_LINE_SIZE = 64u;   ///< Size of cache line in bytes, chunks are a multiple
+constexpr std::size_t BATCH_INTEGRATOR_CHUNK_SIZE_MIN = 8192u;  ///< Minimum number of elements per chunk for parallel integration
+constexpr std::size_t BATCH_INTEGRATOR_CHUNKS_PER_THREAD = 4u;  ///< Chunks per thread, allowing for load balancing
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Class integrating a batch of states at once
+///
+/// In contrast to the per object integrators (e.g. CAdamsBashforthIntegrator)
+/// all states are stored as structure of arrays: each component (e.g. x and
+/// y of a Vector2d) is a contiguous plane of all states, the derivative
+/// history is a set of planes, too. A single call of \ref integrate advances
+/// all states using vectorised kernels. Derivatives are expected in the same
+/// layout, i.e. all x components, followed by all y components and so on.
+///
+/// The history of derivatives is a ring of planes shared by all states of
+/// the batch. It is not shifted, instead, a single base index is rotated
+/// per batch and timestep.
+///
+/// Derivatives may be stored with lower precision than values by giving
+/// TDeriv, e.g. CBatchIntegrator<double, float>. Since the derivative
+/// history makes up most of the memory of multistep methods, this reduces
+/// memory bandwidth significantly, while accumulation is still done in
+/// double precision. The error introduced is relative to the increment per
+/// timestep, not to the value.
+///
+/// For parallel integration, the batch is partitioned into chunks of whole
+/// cache lines, which are processed by a thread pool (e.g. CThreadPool).
+/// Planes are aligned to cache lines, hence, chunks do not share lines.
+/// Since every element is calculated by the same sequence of operations,
+/// independent of chunk and thread, results are bit-identical for any
+/// number of threads.
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class TDeriv = T>
+class CBatchIntegrator
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CBatchIntegrator();
+
+        //--- Constant Methods -----------------------------------------------//
+        int             getNrOfComponents() const {return m_nNrOfComponents;}
+        std::size_t     getNrOfStates() const {return m_nNrOfStates;}
+        IntegratorType  getType() const {return m_Type;}
+        const T*        getPrevValues(const int = 0) const;
+        const T*        getValues(const int = 0) const;
+        T               getValue(const std::size_t, const int = 0) const;
+
+        //--- Methods --------------------------------------------------------//
+        void init(const IntegratorType, const std::size_t, const int = 1);
+        void integrate(const T* const, const double&);
+        void integrate(const std::vector<T>&, const double&);
+        template <class TThreadPool>
+        void integrate(const T* const, const double&, TThreadPool&);
+        void integrateClip(const T* const, const double&, const T&);
+        void reset();
+        void setValue(const std::size_t, const int, const T&);
+
+    private:
+
+        //--- Methods [private] ----------------------------------------------//
+        void integrateRange(const T* const, const double&, const std::size_t, const std::size_t);
+        void rotate();
+
+        //--- Variables [private] --------------------------------------------//
+        IntegratorType  m_Type;                 ///< Integration method
+        int             m_nNrOfComponents;      ///< Components per state, e.g. 2 for Vector2d
+        int             m_nDerivBase;           ///< Plane of newest derivatives
+        int             m_nNrOfSteps;           ///< Number of derivatives used by method
+        std::size_t     m_nNrOfStates;          ///< Number of states in batch
+        std::size_t     m_nSize;                ///< Number of elements per plane set (states*components)
+
+        std::array<double, BATCH_INTEGRATOR_KERNEL_STEPS_MAX> m_afCoeffs; ///< Coefficients of method, newest first
+
+        /// Plane set, aligned to cache lines
+        template <class U>
+        using PlaneType = std::vector<U, CAlignedAllocator<U, BATCH_INTEGRATOR_CACHE_LINE_SIZE>>;
+
+        PlaneType<T>    m_PrevValues;           ///< Values of previous timestep
+        PlaneType<T>    m_Values;               ///< Calculated values
+        std::array<PlaneType<TDeriv>, BATCH_INTEGRATOR_KERNEL_STEPS_MAX> m_Derivs; ///< Derivative planes
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns plane of given component of previous timestep
+///
+/// \param _nComp Component
+///
+/// \return Pointer to values of component of all states
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class TDeriv>
+inline const T* CBatchIntegrator<T, TDeriv>::getPrevValues(const int _nComp) const
+{
+    METHOD_ENTRY("CBatchIntegrator::getPrevValues")
+    return m_PrevValues.data() + _nComp*m_nNrOfStates;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns plane of given component
+///
+/// \param _nComp Component
+///
+/// \return Pointer to values of component of all states
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class TDeriv>
+inline const T* CBatchIntegrator<T, TDeriv>::getValues(const int _nComp) const
+{
+    METHOD_ENTRY("CBatchIntegrator::getValues")
+    return m_Values.data() + _nComp*m_nNrOfStates;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns value of given state and component
+///
+/// \param _nState State
+/// \param _nComp Component
+///
+/// \return Value
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class TDeriv>
+inline T CBatchIntegrator<T, TDeriv>::getValue(const std::size_t _nState, const int _nComp) const
+{
+    METHOD_ENTRY("CBatchIntegrator::getValue")
+    return m_Values[_nComp*m_nNrOfStates + _nState];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Integrates the next timestep of all states
+///
+/// \param _Derivs Derivatives of all states, component planes
+/// \param _fStep Timestep
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class TDeriv>
+inline void CBatchIntegrator<T, TDeriv>::integrate(const std::vector<T>& _Derivs, const double& _fStep)
+{
+    METHOD_ENTRY("CBatchIntegrator::integrate")
+
+    DOM_DEV(
+        if (_Derivs.size() != m_nSize)
+        {
+            ERROR_MSG("Batch Integrator", "Size of derivatives (" << _Derivs.size() <<
+                                          ") does not match batch (" << m_nSize << ").")
+            return;
+        }
+    )
+    this->integrate(_Derivs.data(), _fStep);
+}
+
+//--- Implementation of template members -------------------------------------//
+#include "batch_integrator.tpp"
+
+} // namespace bfe
+
+#endif // BATCH_INTEGRATOR_H
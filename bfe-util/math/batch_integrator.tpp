@@ -0,0 +1,295 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       batch_integrator.tpp
+/// \brief      Implementation of template class "CBatchIntegrator"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-16
+///
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TDeriv>
+CBatchIntegrator<T, TDeriv>::CBatchIntegrator() : m_Type(INTEGRATOR_ADAMS_BASHFORTH),
+                                          m_nNrOfComponents(1),
+                                          m_nDerivBase(0),
+                                          m_nNrOfSteps(0),
+                                          m_nNrOfStates(0u),
+                                          m_nSize(0u)
+{
+    METHOD_ENTRY("CBatchIntegrator::CBatchIntegrator")
+    CTOR_CALL("CBatchIntegrator::CBatchIntegrator")
+
+    m_afCoeffs.fill(0.0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Initialises batch with given method and number of states
+///
+/// All values and derivatives are set to zero. The coefficients of the
+/// method are chosen once here, not per state and timestep.
+///
+/// \param _Type Integration method
+/// \param _nNrOfStates Number of states in batch
+/// \param _nNrOfComponents Number of components per state, e.g. 2 for Vector2d
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TDeriv>
+void CBatchIntegrator<T, TDeriv>::init(const IntegratorType _Type,
+                               const std::size_t _nNrOfStates,
+                               const int _nNrOfComponents)
+{
+    METHOD_ENTRY("CBatchIntegrator::init")
+
+    m_Type = _Type;
+    m_nNrOfStates = _nNrOfStates;
+    m_nNrOfComponents = _nNrOfComponents;
+    m_nSize = _nNrOfStates * _nNrOfComponents;
+
+    m_afCoeffs.fill(0.0);
+    switch (_Type)
+    {
+        case INTEGRATOR_EULER:
+            m_nNrOfSteps = 1;
+            m_afCoeffs[0] = 1.0;
+            break;
+        case INTEGRATOR_ADAMS_BASHFORTH:
+            m_nNrOfSteps = 4;
+            m_afCoeffs[0] =  55.0/24.0;
+            m_afCoeffs[1] = -59.0/24.0;
+            m_afCoeffs[2] =  37.0/24.0;
+            m_afCoeffs[3] =  -3.0/ 8.0;
+            break;
+        case INTEGRATOR_ADAMS_MOULTON:
+            m_nNrOfSteps = 5;
+            m_afCoeffs[0] =  251.0/720.0;
+            m_afCoeffs[1] =  646.0/720.0;
+            m_afCoeffs[2] = -264.0/720.0;
+            m_afCoeffs[3] =  106.0/720.0;
+            m_afCoeffs[4] =  -19.0/720.0;
+            break;
+    }
+
+    m_Values.assign(m_nSize, T(0));
+    m_PrevValues.assign(m_nSize, T(0));
+    for (auto k=0; k<BATCH_INTEGRATOR_KERNEL_STEPS_MAX; ++k)
+    {
+        if (k < m_nNrOfSteps)
+            m_Derivs[k].assign(m_nSize, TDeriv(0));
+        else
+            m_Derivs[k].clear();
+    }
+    m_nDerivBase = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Integrates the next timestep of all states
+///
+/// \param _pDerivs Derivatives of all states, component planes
+/// \param _fStep Timestep
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TDeriv>
+void CBatchIntegrator<T, TDeriv>::integrate(const T* const _pDerivs, const double& _fStep)
+{
+    METHOD_ENTRY("CBatchIntegrator::integrate")
+
+    if (m_nNrOfSteps == 0)
+    {
+        ERROR_MSG("Batch Integrator", "Integration before initialisation, call init first.")
+        return;
+    }
+
+    this->rotate();
+    this->integrateRange(_pDerivs, _fStep, 0u, m_nSize);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Integrates the next timestep of all states using given thread pool
+///
+/// The batch is partitioned into chunks of whole cache lines, at least
+/// BATCH_INTEGRATOR_CHUNK_SIZE_MIN elements, to keep overhead and false
+/// sharing low. Results do not depend on the number of threads.
+///
+/// \param _pDerivs Derivatives of all states, component planes
+/// \param _fStep Timestep
+/// \param _ThreadPool Thread pool to process chunks, providing
+///                    getNrOfThreads() and run(tasks, function(task))
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TDeriv>
+template <class TThreadPool>
+void CBatchIntegrator<T, TDeriv>::integrate(const T* const _pDerivs, const double& _fStep,
+                                    TThreadPool& _ThreadPool)
+{
+    METHOD_ENTRY("CBatchIntegrator::integrate")
+
+    if (m_nNrOfSteps == 0)
+    {
+        ERROR_MSG("Batch Integrator", "Integration before initialisation, call init first.")
+        return;
+    }
+
+    // Chunks must consist of whole cache lines for values and derivatives
+    constexpr std::size_t nElemSize = sizeof(T) < sizeof(TDeriv) ? sizeof(T) : sizeof(TDeriv);
+    constexpr std::size_t nLine = BATCH_INTEGRATOR_CACHE_LINE_SIZE / nElemSize > 0u ?
+                                  BATCH_INTEGRATOR_CACHE_LINE_SIZE / nElemSize : 1u;
+
+    std::size_t nChunkSize = m_nSize / (_ThreadPool.getNrOfThreads() * BATCH_INTEGRATOR_CHUNKS_PER_THREAD);
+    nChunkSize = std::max(nChunkSize, BATCH_INTEGRATOR_CHUNK_SIZE_MIN);
+    nChunkSize = (nChunkSize + nLine - 1u) / nLine * nLine;
+    const std::size_t nNrOfChunks = (m_nSize + nChunkSize - 1u) / nChunkSize;
+
+    this->rotate();
+    _ThreadPool.run(nNrOfChunks, [&](const std::size_t _nChunk)
+    {
+        this->integrateRange(_pDerivs, _fStep, _nChunk*nChunkSize,
+                             std::min(m_nSize, (_nChunk+1u)*nChunkSize));
+    });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Integrates the next timestep of all states with clipping
+///
+/// This method integrates but also clips the result with respect to support
+/// point, like the per object integrators. Thus, values like angles may be
+/// integrated without overflow problems.
+///
+/// \param _pDerivs Derivatives of all states, component planes
+/// \param _fStep Timestep
+/// \param _Clip Min/Max Value to clip
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TDeriv>
+void CBatchIntegrator<T, TDeriv>::integrateClip(const T* const _pDerivs,
+                                        const double& _fStep,
+                                        const T& _Clip)
+{
+    METHOD_ENTRY("CBatchIntegrator::integrateClip")
+
+    this->integrate(_pDerivs, _fStep);
+
+    for (auto i=0u; i<m_nSize; ++i)
+    {
+        int nF = floor(m_Values[i] / _Clip);
+        if (nF >= 1)
+            m_Values[i] -= nF*_Clip;
+        else if (nF <= -2)
+            m_Values[i] -= (nF+1)*_Clip;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Reset the integrator, i.e. clear values and derivatives of all
+///        states
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TDeriv>
+void CBatchIntegrator<T, TDeriv>::reset()
+{
+    METHOD_ENTRY("CBatchIntegrator::reset")
+
+    std::fill(m_Values.begin(), m_Values.end(), T(0));
+    std::fill(m_PrevValues.begin(), m_PrevValues.end(), T(0));
+    for (auto& Derivs : m_Derivs) std::fill(Derivs.begin(), Derivs.end(), TDeriv(0));
+    m_nDerivBase = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Integrates given range of elements, timestep must be begun by
+///        \ref rotate
+///
+/// \param _pDerivs Derivatives of all states, component planes
+/// \param _fStep Timestep
+/// \param _nBegin First element
+/// \param _nEnd Element after last element
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TDeriv>
+void CBatchIntegrator<T, TDeriv>::integrateRange(const T* const _pDerivs, const double& _fStep,
+                                         const std::size_t _nBegin, const std::size_t _nEnd)
+{
+    METHOD_ENTRY("CBatchIntegrator::integrateRange")
+
+    std::transform(_pDerivs+_nBegin, _pDerivs+_nEnd, m_Derivs[m_nDerivBase].begin()+_nBegin,
+                   [](const T& _D){return TDeriv(_D);});
+
+    const TDeriv* apDerivs[BATCH_INTEGRATOR_KERNEL_STEPS_MAX];
+    for (auto k=0; k<m_nNrOfSteps; ++k)
+    {
+        const int nI = m_nDerivBase + k;
+        apDerivs[k] = m_Derivs[(nI < m_nNrOfSteps) ? nI : nI-m_nNrOfSteps].data() + _nBegin;
+    }
+
+    batchIntegrate(m_Values.data()+_nBegin, m_PrevValues.data()+_nBegin, apDerivs,
+                      m_afCoeffs.data(), m_nNrOfSteps, _fStep, _nEnd-_nBegin);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Begins a timestep
+///
+/// The plane of the oldest derivatives is reused for the new ones, other
+/// planes are not touched, only the base index of the ring is rotated.
+/// Calculated values become values of previous timestep.
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TDeriv>
+void CBatchIntegrator<T, TDeriv>::rotate()
+{
+    METHOD_ENTRY("CBatchIntegrator::rotate")
+
+    m_nDerivBase = (m_nDerivBase == 0) ? m_nNrOfSteps-1 : m_nDerivBase-1;
+    m_Values.swap(m_PrevValues);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets value of given state and component
+///
+/// The value of the previous timestep is set, too, like on initialisation of
+/// per object integrators.
+///
+/// \param _nState State
+/// \param _nComp Component
+/// \param _V Value
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TDeriv>
+void CBatchIntegrator<T, TDeriv>::setValue(const std::size_t _nState, const int _nComp, const T& _V)
+{
+    METHOD_ENTRY("CBatchIntegrator::setValue")
+
+    m_Values[_nComp*m_nNrOfStates + _nState] = _V;
+    m_PrevValues[_nComp*m_nNrOfStates + _nState] = _V;
+}
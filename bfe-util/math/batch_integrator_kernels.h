@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       batch_integrator_kernels.h
+/// \brief      Vectorised kernels for batch integration
+///
+/// All kernels compute pValue[i] = pPrev[i] + sum_k(c_k*dt * pDeriv_k[i])
+/// for contiguous arrays. Coefficients are given in the order of the
+/// derivative history, newest first. Derivatives may be stored with lower
+/// precision than values, the sum is always accumulated in double. For
+/// double precision values, AVX or SSE2 is used if enabled at compile time
+/// (e.g. BFE_NATIVE_ARCH), otherwise and for remainders, a scalar loop is
+/// used. Vectorised and scalar loops
+/// use the same order of operations, hence, results do not depend on the
+/// position of an element within the array.
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-16
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BATCH_INTEGRATOR_KERNELS_H
+#define BATCH_INTEGRATOR_KERNELS_H
+
+//--- Standard header --------------------------------------------------------//
+#include <cstddef>
+
+//--- Misc header ------------------------------------------------------------//
+#if defined(__AVX__) || defined(__SSE2__)
+    #include <immintrin.h>
+#endif
+
+/// BFEngine namespace
+namespace bfe
+{
+
+//--- Constants --------------------------------------------------------------//
+constexpr int BATCH_INTEGRATOR_KERNEL_STEPS_MAX = 5; ///< Maximum number of derivatives used by kernels
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Scalar kernel, used as fallback and for remainders
+///
+/// \param _pValue Values to be calculated
+/// \param _pPrev Values of previous timestep
+/// \param _ppDerivs Derivative planes, newest first
+/// \param _pfCoeffs Coefficients for each derivative plane
+/// \param _nNrOfSteps Number of derivative planes used
+/// \param _fStep Timestep
+/// \param _nBegin First index to be calculated
+/// \param _nEnd Index after last index to be calculated
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class TDeriv>
+inline void batchIntegrateScalar(T* const _pValue, const T* const _pPrev,
+                                 const TDeriv* const* const _ppDerivs, const double* const _pfCoeffs,
+                                 const int _nNrOfSteps, const double& _fStep,
+                                 const std::size_t _nBegin, const std::size_t _nEnd)
+{
+    double afCoeffs[BATCH_INTEGRATOR_KERNEL_STEPS_MAX];
+    for (auto k=0; k<_nNrOfSteps; ++k) afCoeffs[k] = _pfCoeffs[k] * _fStep;
+
+    for (auto i=_nBegin; i<_nEnd; ++i)
+    {
+        double fSum = _pPrev[i];
+        for (auto k=0; k<_nNrOfSteps; ++k)
+            fSum += afCoeffs[k] * double(_ppDerivs[k][i]);
+        _pValue[i] = T(fSum);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Generic kernel, scalar only
+///
+/// \param _pValue Values to be calculated
+/// \param _pPrev Values of previous timestep
+/// \param _ppDerivs Derivative planes, newest first
+/// \param _pfCoeffs Coefficients for each derivative plane
+/// \param _nNrOfSteps Number of derivative planes used
+/// \param _fStep Timestep
+/// \param _nSize Number of elements
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class TDeriv>
+inline void batchIntegrate(T* const _pValue, const T* const _pPrev,
+                           const TDeriv* const* const _ppDerivs, const double* const _pfCoeffs,
+                           const int _nNrOfSteps, const double& _fStep,
+                           const std::size_t _nSize)
+{
+    batchIntegrateScalar(_pValue, _pPrev, _ppDerivs, _pfCoeffs, _nNrOfSteps, _fStep, 0u, _nSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Kernel for double precision, vectorised if available
+///
+/// \param _pValue Values to be calculated
+/// \param _pPrev Values of previous timestep
+/// \param _ppDerivs Derivative planes, newest first
+/// \param _pfCoeffs Coefficients for each derivative plane
+/// \param _nNrOfSteps Number of derivative planes used
+/// \param _fStep Timestep
+/// \param _nSize Number of elements
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void batchIntegrate(double* const _pValue, const double* const _pPrev,
+                           const double* const* const _ppDerivs, const double* const _pfCoeffs,
+                           const int _nNrOfSteps, const double& _fStep,
+                           const std::size_t _nSize)
+{
+    std::size_t i = 0u;
+
+    #if defined(__AVX__)
+        __m256d aCoeffs[BATCH_INTEGRATOR_KERNEL_STEPS_MAX];
+        for (auto k=0; k<_nNrOfSteps; ++k) aCoeffs[k] = _mm256_set1_pd(_pfCoeffs[k] * _fStep);
+
+        for (; i+4u <= _nSize; i+=4u)
+        {
+            __m256d Sum = _mm256_loadu_pd(_pPrev+i);
+            for (auto k=0; k<_nNrOfSteps; ++k)
+                Sum = _mm256_add_pd(Sum, _mm256_mul_pd(aCoeffs[k], _mm256_loadu_pd(_ppDerivs[k]+i)));
+            _mm256_storeu_pd(_pValue+i, Sum);
+        }
+    #elif defined(__SSE2__)
+        __m128d aCoeffs[BATCH_INTEGRATOR_KERNEL_STEPS_MAX];
+        for (auto k=0; k<_nNrOfSteps; ++k) aCoeffs[k] = _mm_set1_pd(_pfCoeffs[k] * _fStep);
+
+        for (; i+2u <= _nSize; i+=2u)
+        {
+            __m128d Sum = _mm_loadu_pd(_pPrev+i);
+            for (auto k=0; k<_nNrOfSteps; ++k)
+                Sum = _mm_add_pd(Sum, _mm_mul_pd(aCoeffs[k], _mm_loadu_pd(_ppDerivs[k]+i)));
+            _mm_storeu_pd(_pValue+i, Sum);
+        }
+    #endif
+
+    batchIntegrateScalar(_pValue, _pPrev, _ppDerivs, _pfCoeffs, _nNrOfSteps, _fStep, i, _nSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Kernel for double precision values and single precision
+///        derivatives, vectorised if available
+///
+/// Derivatives are converted to double before multiplication, hence, only
+/// storage of derivatives loses precision, not accumulation.
+///
+/// \param _pValue Values to be calculated
+/// \param _pPrev Values of previous timestep
+/// \param _ppDerivs Derivative planes, newest first
+/// \param _pfCoeffs Coefficients for each derivative plane
+/// \param _nNrOfSteps Number of derivative planes used
+/// \param _fStep Timestep
+/// \param _nSize Number of elements
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void batchIntegrate(double* const _pValue, const double* const _pPrev,
+                           const float* const* const _ppDerivs, const double* const _pfCoeffs,
+                           const int _nNrOfSteps, const double& _fStep,
+                           const std::size_t _nSize)
+{
+    std::size_t i = 0u;
+
+    #if defined(__AVX__)
+        __m256d aCoeffs[BATCH_INTEGRATOR_KERNEL_STEPS_MAX];
+        for (auto k=0; k<_nNrOfSteps; ++k) aCoeffs[k] = _mm256_set1_pd(_pfCoeffs[k] * _fStep);
+
+        for (; i+4u <= _nSize; i+=4u)
+        {
+            __m256d Sum = _mm256_loadu_pd(_pPrev+i);
+            for (auto k=0; k<_nNrOfSteps; ++k)
+                Sum = _mm256_add_pd(Sum, _mm256_mul_pd(aCoeffs[k], _mm256_cvtps_pd(_mm_loadu_ps(_ppDerivs[k]+i))));
+            _mm256_storeu_pd(_pValue+i, Sum);
+        }
+    #elif defined(__SSE2__)
+        __m128d aCoeffs[BATCH_INTEGRATOR_KERNEL_STEPS_MAX];
+        for (auto k=0; k<_nNrOfSteps; ++k) aCoeffs[k] = _mm_set1_pd(_pfCoeffs[k] * _fStep);
+
+        for (; i+2u <= _nSize; i+=2u)
+        {
+            __m128d Sum = _mm_loadu_pd(_pPrev+i);
+            for (auto k=0; k<_nNrOfSteps; ++k)
+            {
+                // Load two floats (64 bit) and convert to two doubles
+                const __m128 Derivs = _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(_ppDerivs[k]+i)));
+                Sum = _mm_add_pd(Sum, _mm_mul_pd(aCoeffs[k], _mm_cvtps_pd(Derivs)));
+            }
+            _mm_storeu_pd(_pValue+i, Sum);
+        }
+    #endif
+
+    batchIntegrateScalar(_pValue, _pPrev, _ppDerivs, _pfCoeffs, _nNrOfSteps, _fStep, i, _nSize);
+}
+
+} // namespace bfe
+
+#endif // BATCH_INTEGRATOR_KERNELS_H
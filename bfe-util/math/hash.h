@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       hash.h
+/// \brief      Non-cryptographic hash functions (FNV-1a, 64 bit)
+///
+/// Used as keys of caches on disk (shader programs, font atlases) and for
+/// hash indices, e.g. of name lists. Results must not change, otherwise
+/// existing caches are invalidated.
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef HASH_H
+#define HASH_H
+
+//--- Standard header --------------------------------------------------------//
+#include <cstddef>
+#include <cstdint>
+
+/// BFEngine namespace
+namespace bfe
+{
+
+//--- Constants --------------------------------------------------------------//
+constexpr std::uint64_t HASH_FNV1A_OFFSET = 14695981039346656037ull; ///< Initial value of FNV-1a hash
+constexpr std::uint64_t HASH_FNV1A_PRIME = 1099511628211ull;         ///< Prime of FNV-1a hash
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Hashes given bytes (FNV-1a)
+///
+/// \param _pData Data to be hashed
+/// \param _nSize Number of bytes
+/// \param _unHash Hash to continue, e.g. of previous data
+///
+/// \return Hash
+///
+////////////////////////////////////////////////////////////////////////////////
+inline std::uint64_t fnv1a(const void* const _pData, const std::size_t _nSize,
+                           std::uint64_t _unHash = HASH_FNV1A_OFFSET)
+{
+    const std::uint8_t* const pData = static_cast<const std::uint8_t*>(_pData);
+    for (std::size_t i=0u; i<_nSize; ++i)
+    {
+        _unHash ^= pData[i];
+        _unHash *= HASH_FNV1A_PRIME;
+    }
+    return _unHash;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Combines given hash with a value in one FNV-1a step
+///
+/// The value is combined as a whole, not bytewise, e.g. for combining hashes
+/// of parts.
+///
+/// \param _unHash Hash to continue
+/// \param _unValue Value to be combined
+///
+/// \return Hash
+///
+////////////////////////////////////////////////////////////////////////////////
+inline std::uint64_t fnv1aCombine(const std::uint64_t _unHash, const std::uint64_t _unValue)
+{
+    return (_unHash ^ _unValue) * HASH_FNV1A_PRIME;
+}
+
+} // namespace bfe
+
+#endif // HASH_H
@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       multi_rate_integrator.h
+/// \brief      Prototype of template class "CMultiRateIntegrator"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MULTI_RATE_INTEGRATOR_H
+#define MULTI_RATE_INTEGRATOR_H
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "static_integrator.h"
+
+/// BFEngine namespace
+namespace bfe
+{
+
+//--- Constants --------------------------------------------------------------//
+constexpr int    MULTI_RATE_NR_OF_LEVELS = 4;               ///< Number of rate buckets, 1x to 8x base step
+constexpr double MULTI_RATE_TOLERANCE_DEFAULT = 1.0e-3;     ///< Default tolerance of error estimate
+constexpr double MULTI_RATE_HYSTERESIS = 0.5;               ///< Fraction of tolerance to be met for coarser step
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Scheduler, integrating states at different rates
+///
+/// States are grouped into buckets of 1x, 2x, 4x ... the base timestep. A
+/// bucket of level L is due every 2^L base steps, other buckets are skipped,
+/// including evaluation of their derivatives. Hence, integration work
+/// depends on activity instead of number of states.
+///
+/// After integration, the change of derivative within one step is used as
+/// error estimate. If it exceeds the tolerance, the state is moved to a
+/// finer bucket, if the estimate for the coarser bucket is well below, it
+/// is moved to the coarser one. Alternatively, the level can be given as a
+/// hint. Levels only change at timesteps that are aligned to both buckets,
+/// and the derivative history is rescaled to the new timestep. Since
+/// rescaling needs a complete history, levels are kept until the state was
+/// integrated at least once per derivative of the method.
+///
+/// A state of level L is integrated at the beginning of its 2^L base steps,
+/// i.e. its value is ahead of the current base step until its next
+/// integration. When moving to a finer bucket, a state is skipped until it
+/// is due again.
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class TMethod>
+class CMultiRateIntegrator
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CMultiRateIntegrator();
+
+        //--- Constant Methods -----------------------------------------------//
+        double          getBaseStep() const {return m_fBaseStep;}
+        int             getLevel(const std::size_t _nState) const {return m_States[_nState].nLevel;}
+        std::size_t     getNrOfIntegrations() const {return m_nNrOfIntegrations;}
+        std::size_t     getNrOfStates() const {return m_States.size();}
+        std::size_t     getNrOfStatesInLevel(const int _nLevel) const {return m_Buckets[_nLevel].size();}
+        double          getTolerance() const {return m_fTolerance;}
+        const T&        getValue(const std::size_t _nState) const {return m_States[_nState].Integrator.getValue();}
+
+        //--- Methods --------------------------------------------------------//
+        void init(const std::size_t, const double&);
+        void initState(const std::size_t, const T&);
+        void setLevel(const std::size_t, const int, const bool = true);
+        void setTolerance(const double& _fTol) {m_fTolerance = _fTol;}
+
+        template <class TDerivFunc>
+        void step(TDerivFunc&&);
+
+    private:
+
+        /// State with integrator and bucket information
+        struct StateType
+        {
+            CStaticIntegrator<T, TMethod> Integrator;   ///< Integrator of state
+            std::uint64_t nDue = 0u;                    ///< Base step of next integration
+            int         nNrOfSteps = 0;                 ///< Integrations since initialisation
+            std::size_t nPos = 0u;                      ///< Position in bucket
+            int         nLevel = 0;                     ///< Level of bucket
+            int         nLevelHint = 0;                 ///< Level given as hint
+            bool        bFixed = false;                 ///< Indicates, if level is given by hint
+        };
+
+        //--- Methods [private] ----------------------------------------------//
+        void changeLevel(const std::size_t, const int);
+        int  findLevel(const StateType&, const double&) const;
+
+        //--- Variables [private] --------------------------------------------//
+        std::vector<StateType>  m_States;                                   ///< All states
+        std::array<std::vector<std::size_t>, MULTI_RATE_NR_OF_LEVELS> m_Buckets; ///< States by level
+        std::vector<std::pair<std::size_t, int>> m_LevelChanges;            ///< Level changes of current step
+
+        double          m_fBaseStep;            ///< Timestep of finest bucket
+        double          m_fTolerance;           ///< Tolerance of error estimate
+        std::uint64_t   m_nStep;                ///< Number of base steps
+        std::size_t     m_nNrOfIntegrations;    ///< Number of states integrated in last step
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Advances by one base step, integrating all due buckets
+///
+/// \param _DerivFunc Function returning derivative of given state, only
+///                   called for states that are due
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class TMethod>
+template <class TDerivFunc>
+inline void CMultiRateIntegrator<T, TMethod>::step(TDerivFunc&& _DerivFunc)
+{
+    METHOD_ENTRY("CMultiRateIntegrator::step")
+
+    m_nNrOfIntegrations = 0u;
+
+    // Buckets are nested, if one is not due, coarser ones are neither
+    for (auto l=0; l<MULTI_RATE_NR_OF_LEVELS && (m_nStep % (1u << l)) == 0u; ++l)
+    {
+        const double fStep = m_fBaseStep * (1u << l);
+        for (const auto nState : m_Buckets[l])
+        {
+            StateType& State = m_States[nState];
+
+            // States that just moved to a finer bucket are still ahead
+            if (State.nDue != m_nStep) continue;
+
+            State.Integrator.integrate(_DerivFunc(nState), fStep);
+            State.nDue = m_nStep + (1u << l);
+            ++State.nNrOfSteps;
+            ++m_nNrOfIntegrations;
+
+            const int nLevel = this->findLevel(State, fStep);
+            if (nLevel != l) m_LevelChanges.push_back({nState, nLevel});
+        }
+    }
+
+    for (const auto& Change : m_LevelChanges) this->changeLevel(Change.first, Change.second);
+    m_LevelChanges.clear();
+
+    ++m_nStep;
+}
+
+//--- Implementation of template members -------------------------------------//
+#include "multi_rate_integrator.tpp"
+
+} // namespace bfe
+
+#endif // MULTI_RATE_INTEGRATOR_H
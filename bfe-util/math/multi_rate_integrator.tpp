@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       multi_rate_integrator.tpp
+/// \brief      Implementation of template class "CMultiRateIntegrator"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TMethod>
+CMultiRateIntegrator<T, TMethod>::CMultiRateIntegrator() : m_fBaseStep(0.0),
+                                                           m_fTolerance(MULTI_RATE_TOLERANCE_DEFAULT),
+                                                           m_nStep(0u),
+                                                           m_nNrOfIntegrations(0u)
+{
+    METHOD_ENTRY("CMultiRateIntegrator::CMultiRateIntegrator")
+    CTOR_CALL("CMultiRateIntegrator::CMultiRateIntegrator")
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Initialises given number of states, all in finest bucket
+///
+/// \param _nNrOfStates Number of states
+/// \param _fBaseStep Timestep of finest bucket
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TMethod>
+void CMultiRateIntegrator<T, TMethod>::init(const std::size_t _nNrOfStates, const double& _fBaseStep)
+{
+    METHOD_ENTRY("CMultiRateIntegrator::init")
+
+    m_fBaseStep = _fBaseStep;
+    m_nStep = 0u;
+    m_nNrOfIntegrations = 0u;
+
+    m_States.clear();
+    m_States.resize(_nNrOfStates);
+    for (auto& Bucket : m_Buckets) Bucket.clear();
+    m_Buckets[0].reserve(_nNrOfStates);
+    for (auto i=0u; i<_nNrOfStates; ++i)
+    {
+        m_States[i].nPos = i;
+        m_Buckets[0].push_back(i);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Initialises value of given state
+///
+/// \param _nState State
+/// \param _V Initial value
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TMethod>
+void CMultiRateIntegrator<T, TMethod>::initState(const std::size_t _nState, const T& _V)
+{
+    METHOD_ENTRY("CMultiRateIntegrator::initState")
+    m_States[_nState].Integrator.init(_V);
+    m_States[_nState].nNrOfSteps = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Gives a hint on the level of a state
+///
+/// The level is changed after the next integration of the state, as soon as
+/// timesteps are aligned.
+///
+/// \param _nState State
+/// \param _nLevel Level, 0 being the base step
+/// \param _bFixed Keep level instead of using error estimate?
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TMethod>
+void CMultiRateIntegrator<T, TMethod>::setLevel(const std::size_t _nState, const int _nLevel, const bool _bFixed)
+{
+    METHOD_ENTRY("CMultiRateIntegrator::setLevel")
+
+    if (_nLevel < 0 || _nLevel >= MULTI_RATE_NR_OF_LEVELS)
+    {
+        WARNING_MSG("Multi Rate Integrator", "Invalid level " << _nLevel << ", not set.")
+        return;
+    }
+    m_States[_nState].nLevelHint = _nLevel;
+    m_States[_nState].bFixed = _bFixed;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Moves state to bucket of given level
+///
+/// \param _nState State
+/// \param _nLevel New level
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TMethod>
+void CMultiRateIntegrator<T, TMethod>::changeLevel(const std::size_t _nState, const int _nLevel)
+{
+    METHOD_ENTRY("CMultiRateIntegrator::changeLevel")
+
+    StateType& State = m_States[_nState];
+    std::vector<std::size_t>& Bucket = m_Buckets[State.nLevel];
+
+    // Remove from old bucket by swapping with last state
+    m_States[Bucket.back()].nPos = State.nPos;
+    Bucket[State.nPos] = Bucket.back();
+    Bucket.pop_back();
+
+    State.Integrator.rescale(double(1u << _nLevel) / double(1u << State.nLevel));
+    State.nLevel = _nLevel;
+    State.nPos = m_Buckets[_nLevel].size();
+    m_Buckets[_nLevel].push_back(_nState);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Finds level of state after integration
+///
+/// A coarser level is only chosen if the next integration of the state is
+/// aligned to it, a finer level is always possible.
+///
+/// \param _State State that has just been integrated
+/// \param _fStep Timestep of current level
+///
+/// \return Level for next integration
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TMethod>
+int CMultiRateIntegrator<T, TMethod>::findLevel(const StateType& _State, const double& _fStep) const
+{
+    METHOD_ENTRY("CMultiRateIntegrator::findLevel")
+
+    // Derivative history must be complete before it is rescaled
+    if (_State.nNrOfSteps < TMethod::NR_OF_STEPS) return _State.nLevel;
+
+    int nLevel = _State.nLevel;
+    if (_State.bFixed)
+    {
+        nLevel = _State.nLevelHint;
+    }
+    else if (TMethod::NR_OF_STEPS > 1)
+    {
+        // Change of derivative within one step, it doubles together with
+        // the step on the next coarser level
+        const double fEstimate = integratorNorm<T>(_State.Integrator.getDeriv(0) -
+                                                   _State.Integrator.getDeriv(1)) * _fStep;
+        if (fEstimate > m_fTolerance)
+            --nLevel;
+        else if (4.0 * fEstimate < m_fTolerance * MULTI_RATE_HYSTERESIS)
+            ++nLevel;
+        nLevel = std::max(0, std::min(MULTI_RATE_NR_OF_LEVELS-1, nLevel));
+    }
+
+    // Next integration of state must be due on coarser level
+    while (nLevel > _State.nLevel && (_State.nDue % (1u << nLevel)) != 0u) --nLevel;
+
+    return nLevel;
+}
@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       static_integrator.h
+/// \brief      Prototype of template class "CStaticIntegrator" and its
+///             integration methods
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef STATIC_INTEGRATOR_H
+#define STATIC_INTEGRATOR_H
+
+//--- Standard header --------------------------------------------------------//
+#include <cmath>
+
+//--- Program header ---------------------------------------------------------//
+#include "integrator.h"
+
+/// BFEngine namespace
+namespace bfe
+{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Euler integration method
+///
+/// Methods provide the number of derivatives used and the increment per
+/// unit timestep, given access to the derivatives by age (0 being the
+/// newest). Increments are calculated exactly like the per object
+/// integrators, hence, results are identical.
+///
+////////////////////////////////////////////////////////////////////////////////
+struct CEulerMethod
+{
+    static constexpr int            NR_OF_STEPS = 1;                    ///< Number of derivatives used
+    static constexpr IntegratorType TYPE = INTEGRATOR_EULER;            ///< Runtime type of method
+
+    template <class T, class TDerivs>
+    static T increment(const TDerivs& _D) {return _D(0);}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief 4th order Adams-Bashforth integration method
+///
+////////////////////////////////////////////////////////////////////////////////
+struct CAdamsBashforthMethod
+{
+    static constexpr int            NR_OF_STEPS = 4;                    ///< Number of derivatives used
+    static constexpr IntegratorType TYPE = INTEGRATOR_ADAMS_BASHFORTH;  ///< Runtime type of method
+
+    template <class T, class TDerivs>
+    static T increment(const TDerivs& _D)
+    {
+        return _D(0) * 55.0/24.0 -
+               _D(1) * 59.0/24.0 +
+               _D(2) * 37.0/24.0 -
+               _D(3) *  3.0/ 8.0;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adams-Moulton integration method
+///
+////////////////////////////////////////////////////////////////////////////////
+struct CAdamsMoultonMethod
+{
+    static constexpr int            NR_OF_STEPS = 5;                    ///< Number of derivatives used
+    static constexpr IntegratorType TYPE = INTEGRATOR_ADAMS_MOULTON;    ///< Runtime type of method
+
+    template <class T, class TDerivs>
+    static T increment(const TDerivs& _D)
+    {
+        return _D(0) * 251.0/720.0 +
+               _D(1) * 646.0/720.0 -
+               _D(2) * 264.0/720.0 +
+               _D(3) * 106.0/720.0 -
+               _D(4) * 19.0 /720.0;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Integrator with integration method chosen at compile time
+///
+/// In contrast to the integrators derived from IIntegrator, there are no
+/// virtual calls and no heap allocations. Objects embed the integrator by
+/// value and all methods may be inlined. Values are returned by reference.
+///
+/// If the method is chosen at runtime, dispatch once per loop, i.e. switch
+/// on IntegratorType and call a function template integrating all objects.
+/// A tagged union of all methods, dispatching per object, would be sized
+/// for the largest method and is slower than virtual calls for Euler.
+///
+/// \tparam T Type of value, e.g. double or Vector2d
+/// \tparam TMethod Integration method, e.g. CAdamsBashforthMethod
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class TMethod>
+class CStaticIntegrator
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CStaticIntegrator();
+
+        //--- Constant Methods -----------------------------------------------//
+        const T&        getDeriv(const int) const;
+        const T&        getPrevValue() const {return m_PrevValue;}
+        const T&        getValue() const {return m_Value;}
+        IntegratorType  getType() const {return TMethod::TYPE;}
+
+        //--- Methods --------------------------------------------------------//
+        const T& integrate(const T&, const double&);
+        const T& integrateClip(const T&, const double&, const T&);
+        void     init(const T&);
+        void     rescale(const double&);
+        void     reset();
+
+    private:
+
+        //--- Variables [private] --------------------------------------------//
+        T    m_Deriv[TMethod::NR_OF_STEPS];   ///< Derivatives of previous timesteps
+        int  m_nDerivBase;                    ///< Index of newest derivative, history is a ring
+        T    m_PrevValue;                     ///< Calculated value of previous timestep
+        T    m_Value;                         ///< Calculated value
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns zero of given type
+///
+/// \return Zero
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline T integratorZero()
+{
+    return T(0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns zero vector
+///
+/// \return Zero vector
+///
+////////////////////////////////////////////////////////////////////////////////
+template <>
+inline Vector2d integratorZero<Vector2d>()
+{
+    return Vector2d::Zero();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns magnitude of given value
+///
+/// \param _V Value
+///
+/// \return Magnitude
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline double integratorNorm(const T& _V)
+{
+    return std::abs(_V);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns magnitude of given vector
+///
+/// \param _V Vector
+///
+/// \return Magnitude
+///
+////////////////////////////////////////////////////////////////////////////////
+template <>
+inline double integratorNorm<Vector2d>(const Vector2d& _V)
+{
+    return _V.norm();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Clips value with respect to support point
+///
+/// \param _V Value to be clipped
+/// \param _Clip Min/Max Value to clip
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline void integratorClip(T& _V, const T& _Clip)
+{
+    int nF = floor(_V / _Clip);
+    if (nF >= 1)
+        _V -= nF*_Clip;
+    else if (nF <= -2)
+        _V -= (nF+1)*_Clip;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Clips vector with respect to support point, component wise
+///
+/// \param _V Vector to be clipped
+/// \param _Clip Min/Max Value to clip
+///
+////////////////////////////////////////////////////////////////////////////////
+template <>
+inline void integratorClip<Vector2d>(Vector2d& _V, const Vector2d& _Clip)
+{
+    integratorClip(_V[0], _Clip[0]);
+    integratorClip(_V[1], _Clip[1]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns derivative of given age
+///
+/// \param _nAge Age of derivative, 0 being the newest one
+///
+/// \return Derivative
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class TMethod>
+inline const T& CStaticIntegrator<T, TMethod>::getDeriv(const int _nAge) const
+{
+    METHOD_ENTRY("CStaticIntegrator::getDeriv")
+    const int nI = m_nDerivBase + _nAge;
+    return m_Deriv[(nI < TMethod::NR_OF_STEPS) ? nI : nI-TMethod::NR_OF_STEPS];
+}
+
+//--- Implementation of template members -------------------------------------//
+#include "static_integrator.tpp"
+
+} // namespace bfe
+
+#endif // STATIC_INTEGRATOR_H
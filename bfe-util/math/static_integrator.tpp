@@ -0,0 +1,176 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       static_integrator.tpp
+/// \brief      Implementation of template class "CStaticIntegrator"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TMethod>
+inline CStaticIntegrator<T, TMethod>::CStaticIntegrator()
+{
+    METHOD_ENTRY("CStaticIntegrator::CStaticIntegrator")
+    CTOR_CALL("CStaticIntegrator::CStaticIntegrator")
+
+    this->reset();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Integrates the next timestep
+///
+/// \param _V Integration value
+/// \param _fStep Timestep
+///
+/// \return New value
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TMethod>
+inline const T& CStaticIntegrator<T, TMethod>::integrate(const T& _V, const double& _fStep)
+{
+    METHOD_ENTRY("CStaticIntegrator::integrate")
+
+    m_nDerivBase = (m_nDerivBase == 0) ? TMethod::NR_OF_STEPS-1 : m_nDerivBase-1;
+    m_Deriv[m_nDerivBase] = _V;
+
+    m_PrevValue = m_Value;
+    m_Value += TMethod::template increment<T>([this](const int _nAge) -> const T&
+                                              {return this->getDeriv(_nAge);}) * _fStep;
+    return m_Value;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Integrates the next timestep with clipping
+///
+/// This method integrates but also clips the result with respect to support
+/// point. Thus, values like angles may be integrated without overflow
+/// problems.
+///
+/// \param _V Integration value
+/// \param _fStep Timestep
+/// \param _Clip Min/Max Value to clip
+///
+/// \return New value
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TMethod>
+inline const T& CStaticIntegrator<T, TMethod>::integrateClip(const T& _V,
+                                                             const double& _fStep,
+                                                             const T& _Clip)
+{
+    METHOD_ENTRY("CStaticIntegrator::integrateClip")
+
+    this->integrate(_V, _fStep);
+    integratorClip(m_Value, _Clip);
+
+    return m_Value;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Initializes integrator with given value
+///
+/// \param _V Initial value
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TMethod>
+inline void CStaticIntegrator<T, TMethod>::init(const T& _V)
+{
+    METHOD_ENTRY("CStaticIntegrator::init")
+
+    this->reset();
+    m_PrevValue = _V;
+    m_Value = _V;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Rescales derivative history to a new timestep
+///
+/// Multistep methods expect derivatives of equidistant timesteps. If the
+/// timestep changes, the history is resampled at the new timestep by
+/// polynomial interpolation through the stored derivatives. Samples older
+/// than the history are not extrapolated but set to the oldest derivative.
+///
+/// \param _fRatio Ratio of new timestep to old timestep
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TMethod>
+void CStaticIntegrator<T, TMethod>::rescale(const double& _fRatio)
+{
+    METHOD_ENTRY("CStaticIntegrator::rescale")
+
+    constexpr int nN = TMethod::NR_OF_STEPS;
+    if (nN < 2 || _fRatio == 1.0) return;
+
+    T Derivs[nN];
+    for (auto j=0; j<nN; ++j) Derivs[j] = this->getDeriv(j);
+
+    // Newest derivative is kept, older ones are interpolated
+    for (auto k=1; k<nN; ++k)
+    {
+        const double fAge = k * _fRatio;
+        T& Deriv = m_Deriv[(m_nDerivBase+k < nN) ? m_nDerivBase+k : m_nDerivBase+k-nN];
+
+        if (fAge >= nN-1)
+        {
+            Deriv = Derivs[nN-1];
+            continue;
+        }
+
+        Deriv = integratorZero<T>();
+        for (auto j=0; j<nN; ++j)
+        {
+            double fW = 1.0;
+            for (auto m=0; m<nN; ++m)
+            {
+                if (m != j) fW *= (fAge - m) / (j - m);
+            }
+            Deriv += Derivs[j] * fW;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Reset the integrator, i.e. clear it's last value
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T, class TMethod>
+inline void CStaticIntegrator<T, TMethod>::reset()
+{
+    METHOD_ENTRY("CStaticIntegrator::reset")
+
+    for (auto& Deriv : m_Deriv) Deriv = integratorZero<T>();
+    m_nDerivBase = 0;
+    m_PrevValue = integratorZero<T>();
+    m_Value = integratorZero<T>();
+}
@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       name_list.cpp
+/// \brief      Implementation of class "CNameList"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+
+#include "name_list.h"
+#include "hash.h"
+
+using namespace bfe;
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+///////////////////////////////////////////////////////////////////////////////
+CNameList::CNameList() : m_Offsets(1u, 0u),
+                         m_nNrOfIndexed(0u)
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds a name, if it is not part of the list, yet
+///
+/// \param _pcName Characters of name
+/// \param _nLength Number of characters
+///
+/// \return Name was added?
+///
+///////////////////////////////////////////////////////////////////////////////
+bool CNameList::addUnique(const char* const _pcName, const std::size_t _nLength)
+{
+    this->updateIndex();
+    if (2u * (m_nNrOfIndexed+1u) > m_Index.size()) this->growIndex();
+
+    const std::uint64_t nHash = hash(_pcName, _nLength);
+    const std::uint64_t nTag = nHash & NAME_LIST_INDEX_TAG_MASK;
+    const std::size_t nMask = m_Index.size() - 1u;
+    std::size_t nSlot = nHash & nMask;
+    while (m_Index[nSlot] != 0u)
+    {
+        // Only access arena if upper hash bits are equal
+        if ((m_Index[nSlot] & NAME_LIST_INDEX_TAG_MASK) == nTag &&
+            this->equals((m_Index[nSlot] & ~NAME_LIST_INDEX_TAG_MASK)-1u, _pcName, _nLength)) return false;
+        nSlot = (nSlot + 1u) & nMask;
+    }
+
+    this->add(_pcName, _nLength);
+    m_Index[nSlot] = nTag | this->size();
+    ++m_nNrOfIndexed;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Appends all names of given list
+///
+/// \param _Names List of names to be appended
+/// \param _bUnique Skip names that are part of this list already
+///
+/// \return Number of names appended
+///
+///////////////////////////////////////////////////////////////////////////////
+std::size_t CNameList::append(const CNameList& _Names, const bool _bUnique)
+{
+    this->reserve(this->size() + _Names.size(), m_strArena.size() + _Names.m_strArena.size());
+
+    if (!_bUnique)
+    {
+        const std::uint32_t nBase = std::uint32_t(m_strArena.size());
+        m_strArena += _Names.m_strArena;
+        for (auto i=1u; i<_Names.m_Offsets.size(); ++i)
+            m_Offsets.push_back(nBase + _Names.m_Offsets[i]);
+        return _Names.size();
+    }
+
+    std::size_t nNrOfAdded = 0u;
+    for (auto i=0u; i<_Names.size(); ++i)
+    {
+        if (this->addUnique(_Names.getData(i), _Names.getLength(i))) ++nNrOfAdded;
+    }
+    return nNrOfAdded;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Removes all names
+///
+///////////////////////////////////////////////////////////////////////////////
+void CNameList::clear()
+{
+    m_strArena.clear();
+    m_Offsets.assign(1u, 0u);
+    m_Index.clear();
+    m_nNrOfIndexed = 0u;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Reserves memory for given number of names and characters
+///
+/// \param _nNrOfNames Total number of names
+/// \param _nNrOfChars Total number of characters
+///
+///////////////////////////////////////////////////////////////////////////////
+void CNameList::reserve(const std::size_t _nNrOfNames, const std::size_t _nNrOfChars)
+{
+    m_Offsets.reserve(_nNrOfNames + 1u);
+    m_strArena.reserve(_nNrOfChars);
+
+    // Avoid rebuilding the hash index while growing, if it is used
+    if (!m_Index.empty() && m_Index.size() < 2u * _nNrOfNames)
+    {
+        std::size_t nSize = m_Index.size();
+        while (nSize < 2u * _nNrOfNames) nSize *= 2u;
+        m_Index.assign(nSize, 0u);
+        m_nNrOfIndexed = 0u;
+        this->updateIndex();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Compares given name of list with given characters
+///
+/// \param _nName Index of name
+/// \param _pcName Characters of name
+/// \param _nLength Number of characters
+///
+/// \return Names are equal?
+///
+///////////////////////////////////////////////////////////////////////////////
+bool CNameList::equals(const std::size_t _nName, const char* const _pcName, const std::size_t _nLength) const
+{
+    return (this->getLength(_nName) == _nLength) &&
+           (std::memcmp(this->getData(_nName), _pcName, _nLength) == 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Hashes given characters (FNV-1a)
+///
+/// \param _pcName Characters of name
+/// \param _nLength Number of characters
+///
+/// \return Hash
+///
+///////////////////////////////////////////////////////////////////////////////
+std::uint64_t CNameList::hash(const char* const _pcName, const std::size_t _nLength)
+{
+    return fnv1a(_pcName, _nLength);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Doubles size of hash index and rebuilds it
+///
+///////////////////////////////////////////////////////////////////////////////
+void CNameList::growIndex()
+{
+    m_Index.assign(std::max(NAME_LIST_INDEX_SIZE_MIN, 2u * m_Index.size()), 0u);
+    m_nNrOfIndexed = 0u;
+    this->updateIndex();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds names to hash index that were added without uniqueness check
+///
+/// Duplicates among those names are indexed as well, uniqueness is only
+/// guaranteed for names added by \ref addUnique.
+///
+///////////////////////////////////////////////////////////////////////////////
+void CNameList::updateIndex()
+{
+    if (m_nNrOfIndexed == this->size()) return;
+
+    if (m_Index.size() < 2u * this->size())
+    {
+        std::size_t nSize = NAME_LIST_INDEX_SIZE_MIN;
+        while (nSize < 2u * this->size()) nSize *= 2u;
+        m_Index.assign(nSize, 0u);
+        m_nNrOfIndexed = 0u;
+    }
+
+    const std::size_t nMask = m_Index.size() - 1u;
+    for (auto i=m_nNrOfIndexed; i<this->size(); ++i)
+    {
+        const std::uint64_t nHash = hash(this->getData(i), this->getLength(i));
+        std::size_t nSlot = nHash & nMask;
+        while (m_Index[nSlot] != 0u) nSlot = (nSlot + 1u) & nMask;
+        m_Index[nSlot] = (nHash & NAME_LIST_INDEX_TAG_MASK) | (i + 1u);
+    }
+    m_nNrOfIndexed = this->size();
+}
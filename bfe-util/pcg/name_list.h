@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       name_list.h
+/// \brief      Prototype of class "CNameList"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NAME_LIST_H
+#define NAME_LIST_H
+
+//--- Standard header --------------------------------------------------------//
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// BFEngine namespace
+namespace bfe
+{
+
+const std::size_t   NAME_LIST_INDEX_SIZE_MIN = 64u;                     ///< Minimum number of slots of hash index
+const std::uint64_t NAME_LIST_INDEX_TAG_MASK = 0xffffffff00000000ULL;  ///< Upper hash bits, stored with name index
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief List of names, stored in a single contiguous arena
+///
+/// All characters are stored in one string without terminators, names are
+/// given by offsets into this arena. Thus, a list of thousands of names
+/// needs two allocations instead of one per name.
+///
+/// For uniqueness, an open addressing hash index of name indices is kept.
+/// It is only built on the first call of \ref addUnique and then includes
+/// all names of the list, also those added by \ref add before. Each slot
+/// also holds the upper 32 bits of the hash, so most collisions are resolved
+/// without accessing the arena. Names are compared completely if these bits
+/// are equal, so uniqueness is exact.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CNameList
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CNameList();
+
+        //--- Constant Methods -----------------------------------------------//
+        const std::string&  getArena() const {return m_strArena;}
+        const char*         getData(const std::size_t) const;
+        std::size_t         getLength(const std::size_t) const;
+        std::string         getName(const std::size_t) const;
+        std::size_t         size() const {return m_Offsets.size() - 1u;}
+
+        //--- Methods --------------------------------------------------------//
+        void        add(const char* const, const std::size_t);
+        bool        addUnique(const char* const, const std::size_t);
+        std::size_t append(const CNameList&, const bool = false);
+        void        clear();
+        void        reserve(const std::size_t, const std::size_t);
+
+    private:
+
+        //--- Constant Methods [private] -------------------------------------//
+        bool        equals(const std::size_t, const char* const, const std::size_t) const;
+
+        //--- Static Methods [private] ---------------------------------------//
+        static std::uint64_t hash(const char* const, const std::size_t);
+
+        //--- Methods [private] ----------------------------------------------//
+        void        growIndex();
+        void        updateIndex();
+
+        //--- Variables [private] --------------------------------------------//
+        std::string                 m_strArena;     ///< Characters of all names
+        std::vector<std::uint32_t>  m_Offsets;      ///< Offsets of names in arena, one more than names
+        std::vector<std::uint64_t>  m_Index;        ///< Hash index, upper hash bits | name index + 1, 0 if empty
+        std::size_t                 m_nNrOfIndexed; ///< Number of names in hash index
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns characters of given name, not null terminated
+///
+/// \param _nName Index of name
+///
+/// \return Pointer to first character of name
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const char* CNameList::getData(const std::size_t _nName) const
+{
+    return m_strArena.data() + m_Offsets[_nName];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns length of given name
+///
+/// \param _nName Index of name
+///
+/// \return Number of characters
+///
+////////////////////////////////////////////////////////////////////////////////
+inline std::size_t CNameList::getLength(const std::size_t _nName) const
+{
+    return m_Offsets[_nName+1u] - m_Offsets[_nName];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns copy of given name
+///
+/// \param _nName Index of name
+///
+/// \return Name
+///
+////////////////////////////////////////////////////////////////////////////////
+inline std::string CNameList::getName(const std::size_t _nName) const
+{
+    return m_strArena.substr(m_Offsets[_nName], this->getLength(_nName));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds a name without check for uniqueness
+///
+/// \param _pcName Characters of name
+/// \param _nLength Number of characters
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CNameList::add(const char* const _pcName, const std::size_t _nLength)
+{
+    m_strArena.append(_pcName, _nLength);
+    m_Offsets.push_back(std::uint32_t(m_strArena.size()));
+}
+
+} // namespace bfe
+
+#endif // NAME_LIST_H
@@ -28,8 +28,8 @@
 ///
 ////////////////////////////////////////////////////////////////////////////////
 
-#include <algorithm>
-#include <random>
+#include <cctype>
+#include <cmath>
 
 #include "namegenerator.h"
 
@@ -43,6 +43,7 @@ using namespace bfe;
 CNameGenerator::CNameGenerator()
 {
     m_Generator.seed(1);
+    this->initLengths();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -50,11 +51,13 @@ CNameGenerator::CNameGenerator()
 /// \brief Constructor, setting the seed for random name generation.
 ///
 /// \param _nSeed Seed for random name generation
+/// \param _nStream Stream of random numbers, e.g. index of thread
 ///
 ///////////////////////////////////////////////////////////////////////////////
-CNameGenerator::CNameGenerator(const int& _nSeed)
+CNameGenerator::CNameGenerator(const int& _nSeed, const std::uint64_t& _nStream)
 {
-    m_Generator.seed(_nSeed);
+    m_Generator.seed(_nSeed, _nStream);
+    this->initLengths();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -66,19 +69,113 @@ CNameGenerator::CNameGenerator(const int& _nSeed)
 ///////////////////////////////////////////////////////////////////////////////
 const std::string CNameGenerator::getName()
 {
-    std::uniform_int_distribution<int>  CharDistribution(0,25);
-    std::poisson_distribution<int>      LengthDistribution(NAME_GENERATOR_LENGTH_MEAN);
+    char acName[NAME_GENERATOR_LENGTH_MAX];
+    const int nLength = this->createName(acName);
     
-    int nMode = 0;
+    return std::string(acName, nLength);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds given number of random names to given list
+///
+/// If uniqueness is requested, names that are part of the list already are
+/// drawn again. Since the number of possible names is limited, generation
+/// stops after NAME_GENERATOR_TRIALS_MAX failed trials in a row.
+///
+/// \param _Names List to add names to
+/// \param _nNrOfNames Number of names to be added
+/// \param _bUnique Only add names that are not part of the list, yet
+///
+/// \return Number of names added
+///
+///////////////////////////////////////////////////////////////////////////////
+std::size_t CNameGenerator::getNames(CNameList& _Names, const std::size_t _nNrOfNames, const bool _bUnique)
+{
+    char acName[NAME_GENERATOR_LENGTH_MAX];
     
-    std::string strOut("");
+    _Names.reserve(_Names.size() + _nNrOfNames,
+                   _Names.getArena().size() + _nNrOfNames * NAME_GENERATOR_LENGTH_MEAN);
     
-    int nLength = LengthDistribution(m_Generator);
-    while (nLength > NAME_GENERATOR_LENGTH_MAX || nLength < NAME_GENERATOR_LENGTH_MIN) nLength = LengthDistribution(m_Generator);
+    std::size_t nNrOfAdded = 0u;
+    int nNrOfFailed = 0;
+    while (nNrOfAdded < _nNrOfNames && nNrOfFailed < NAME_GENERATOR_TRIALS_MAX)
+    {
+        const int nLength = this->createName(acName);
+        if (!_bUnique)
+        {
+            _Names.add(acName, nLength);
+            ++nNrOfAdded;
+        }
+        else if (_Names.addUnique(acName, nLength))
+        {
+            ++nNrOfAdded;
+            nNrOfFailed = 0;
+        }
+        else
+        {
+            ++nNrOfFailed;
+        }
+    }
+    return nNrOfAdded;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Merges names of partitions in order of partitions
+///
+/// Names of partitions are unique within each partition only. Hence, if
+/// uniqueness is requested, duplicates across partitions are skipped and
+/// replaced by names of an additional stream, following the streams of the
+/// partitions. The result is independent of the order in which partitions
+/// were generated.
+///
+/// \param _Names List to add names to
+/// \param _Partitions Names of each partition
+/// \param _nNrOfNames Number of names to be added
+/// \param _nSeed Seed of all partitions
+/// \param _bUnique Only add names that are not part of the list, yet
+///
+/// \return Number of names added
+///
+///////////////////////////////////////////////////////////////////////////////
+std::size_t CNameGenerator::mergeNames(CNameList& _Names, const std::vector<CNameList>& _Partitions,
+                                       const std::size_t _nNrOfNames, const int& _nSeed,
+                                       const bool _bUnique)
+{
+    std::size_t nNrOfAdded = 0u;
+    for (const auto& Partition : _Partitions) nNrOfAdded += _Names.append(Partition, _bUnique);
+    
+    if (nNrOfAdded < _nNrOfNames)
+    {
+        CNameGenerator NameGenerator(_nSeed, _Partitions.size());
+        nNrOfAdded += NameGenerator.getNames(_Names, _nNrOfNames - nNrOfAdded, _bUnique);
+    }
+    return nNrOfAdded;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Writes a random name to given buffer
+///
+/// \param _pcName Buffer of at least NAME_GENERATOR_LENGTH_MAX characters
+///
+/// \return Length of name
+///
+///////////////////////////////////////////////////////////////////////////////
+int CNameGenerator::createName(char* const _pcName)
+{
+    int nMode = 0;
+    int nOut = 0;
+    
+    const std::uint32_t nRandom = m_Generator();
+    int nLength = NAME_GENERATOR_LENGTH_MIN;
+    for (const auto nThreshold : m_LengthThresholds)
+        if (nRandom >= nThreshold) ++nLength;
        
     while (nLength-- > 0)
     {
-        int nChar = CharDistribution(m_Generator);
+        int nChar = int(m_Generator.bounded(26));
         
         switch (nChar)
         {
@@ -88,27 +185,54 @@ const std::string CNameGenerator::getName()
             case 14:
             case 20:
               nMode = 1;
-              strOut += ALPHABET[nChar];
+              _pcName[nOut++] = ALPHABET[nChar];
               break;
             default:
               if (nMode == 2)
               {
                   if (nChar == 18)
-                    strOut += ALPHABET[nChar];
+                    _pcName[nOut++] = ALPHABET[nChar];
                   else
                     nLength++;
               }
               else
               {
-                  strOut += ALPHABET[nChar];
+                  _pcName[nOut++] = ALPHABET[nChar];
                   nMode = 2;
               }
         }
     }
 
     // First character to upper case
-    std::transform(strOut.begin(), strOut.begin()+1,strOut.begin(), ::toupper);
+    _pcName[0] = char(::toupper(_pcName[0]));
     
-    return strOut;
+    return nOut;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Tabulates cumulative distribution of name lengths
+///
+/// The Poisson distribution is truncated to minimum and maximum length and
+/// scaled to the range of 32 bit random numbers.
+///
+///////////////////////////////////////////////////////////////////////////////
+void CNameGenerator::initLengths()
+{
+    std::array<double, NAME_GENERATOR_NR_OF_LENGTHS> afP;
+    double fSum = 0.0;
+    for (auto i=0; i<NAME_GENERATOR_NR_OF_LENGTHS; ++i)
+    {
+        const int nLength = NAME_GENERATOR_LENGTH_MIN + i;
+        afP[i] = std::exp(nLength * std::log(double(NAME_GENERATOR_LENGTH_MEAN)) -
+                          NAME_GENERATOR_LENGTH_MEAN - std::lgamma(nLength + 1.0));
+        fSum += afP[i];
+    }
+    
+    double fCumulative = 0.0;
+    for (auto i=0u; i<m_LengthThresholds.size(); ++i)
+    {
+        fCumulative += afP[i] / fSum;
+        m_LengthThresholds[i] = std::uint32_t(fCumulative * 4294967296.0);
+    }
+}
@@ -31,6 +31,17 @@
 #ifndef NAME_GENERATOR_H
 #define NAME_GENERATOR_H
 
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "name_list.h"
+#include "pcg_random.h"
+
 /// BFEngine namespace
 namespace bfe
 {
@@ -41,11 +52,24 @@ const char ALPHABET[26] = {'a','b','c','d','e','f','g','h','i','j','k','l','m','
 const int NAME_GENERATOR_LENGTH_MIN  =  3; ///< Minimum length for generated names
 const int NAME_GENERATOR_LENGTH_MAX  =  9; ///< Maximum length for generated names
 const int NAME_GENERATOR_LENGTH_MEAN =  5; ///< Mean length for generated names
+const int NAME_GENERATOR_NR_OF_LENGTHS = NAME_GENERATOR_LENGTH_MAX - NAME_GENERATOR_LENGTH_MIN + 1; ///< Number of possible lengths
+const int NAME_GENERATOR_TRIALS_MAX = 1000; ///< Maximum number of failed trials in a row for unique names
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Class for procedural creation of names.
 ///
+/// Name lengths follow a Poisson distribution, truncated to the minimum and
+/// maximum length. Its cumulative distribution is tabulated on construction,
+/// so a length is drawn by a single random number. Generators of different
+/// streams are independent, e.g. one per worker thread, and produce the same
+/// names on every platform for equal seed and stream.
+///
+/// Names can be generated in bulk into a \ref CNameList, optionally unique.
+/// For parallel generation, names are partitioned, each partition being
+/// generated by its own stream of the same seed. The result only depends on
+/// seed and number of partitions, not on the number of threads.
+///
 ////////////////////////////////////////////////////////////////////////////////
 class CNameGenerator
 {
@@ -54,17 +78,69 @@ class CNameGenerator
         
         //--- Constructor/Destructor -----------------------------------------//
         CNameGenerator();
-        CNameGenerator(const int&);
+        CNameGenerator(const int&, const std::uint64_t& = PCG32_STREAM_DEFAULT);
         
         //--- Methods --------------------------------------------------------//
         const std::string getName();
+        std::size_t getNames(CNameList&, const std::size_t, const bool = false);
+        
+        //--- Static Methods -------------------------------------------------//
+        template <class TThreadPool>
+        static std::size_t getNames(CNameList&, const std::size_t, const int&,
+                                    const std::size_t, TThreadPool&, const bool = false);
         
     private:
     
+        //--- Methods [private] ----------------------------------------------//
+        int  createName(char* const);
+        void initLengths();
+        
+        //--- Static Methods [private] ---------------------------------------//
+        static std::size_t mergeNames(CNameList&, const std::vector<CNameList>&,
+                                      const std::size_t, const int&, const bool);
+
         //--- Variables ------------------------------------------------------//
-        std::mt19937    m_Generator; ///< Random number Generator
+        CPCG32          m_Generator; ///< Random number Generator
+
+        std::array<std::uint32_t, NAME_GENERATOR_NR_OF_LENGTHS-1> m_LengthThresholds; ///< Cumulative distribution of lengths
 };
 
+//--- Implementation is done here for inline optimisation --------------------//
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds given number of random names to given list, partitioned and
+///        generated by given thread pool
+///
+/// \param _Names List to add names to
+/// \param _nNrOfNames Number of names to be added
+/// \param _nSeed Seed, partition i uses stream i
+/// \param _nNrOfPartitions Number of partitions
+/// \param _ThreadPool Thread pool, providing run(tasks, function(task))
+/// \param _bUnique Only add names that are not part of the list, yet
+///
+/// \return Number of names added
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class TThreadPool>
+inline std::size_t CNameGenerator::getNames(CNameList& _Names, const std::size_t _nNrOfNames,
+                                            const int& _nSeed, const std::size_t _nNrOfPartitions,
+                                            TThreadPool& _ThreadPool, const bool _bUnique)
+{
+    const std::size_t nNrOfPartitions = std::max(std::size_t(1u), _nNrOfPartitions);
+    std::vector<CNameList> Partitions(nNrOfPartitions);
+    
+    _ThreadPool.run(nNrOfPartitions, [&](const std::size_t _nPartition)
+    {
+        const std::size_t nNrOfNames = _nNrOfNames / nNrOfPartitions +
+                                       (_nPartition < _nNrOfNames % nNrOfPartitions ? 1u : 0u);
+        CNameGenerator NameGenerator(_nSeed, _nPartition);
+        NameGenerator.getNames(Partitions[_nPartition], nNrOfNames, _bUnique);
+    });
+    
+    return mergeNames(_Names, Partitions, _nNrOfNames, _nSeed, _bUnique);
+}
+
 } // namespace bfe
 
 #endif // CNAMEGENERATOR_H
@@ -0,0 +1,365 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of BFEngine, a 2D simulation engine.
+// Copyright (C) 2019 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       pcg_random.h
+/// \brief      Prototype of classes "CPCG32" and "CPCG64"
+///
+/// Permuted congruential generators (PCG) by M. E. O'Neill, see
+/// http://www.pcg-random.org. Output matches the reference implementation
+/// for equal seed and stream (pcg32 is XSH-RR 64/32, pcg64 is XSL-RR
+/// 128/64). Both classes are uniform random bit generators, hence, they can
+/// be used with the distributions of the standard library.
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2019-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PCG_RANDOM_H
+#define PCG_RANDOM_H
+
+//--- Standard header --------------------------------------------------------//
+#include <cstdint>
+#include <limits>
+
+/// BFEngine namespace
+namespace bfe
+{
+
+//--- Constants --------------------------------------------------------------//
+constexpr std::uint64_t PCG32_MULTIPLIER = 6364136223846793005ULL;      ///< Multiplier of 64 bit LCG
+constexpr std::uint64_t PCG32_STATE_DEFAULT = 0x853c49e6748fea9bULL;    ///< Default initial state
+constexpr std::uint64_t PCG32_STREAM_DEFAULT = 0xda3e39cb94b95bdbULL;   ///< Default stream
+
+constexpr std::uint64_t PCG64_MULTIPLIER_HI = 2549297995355413924ULL;   ///< Multiplier of 128 bit LCG, high part
+constexpr std::uint64_t PCG64_MULTIPLIER_LO = 4865540595714422341ULL;   ///< Multiplier of 128 bit LCG, low part
+constexpr std::uint64_t PCG64_STATE_DEFAULT = 0x979c9a98d8462005ULL;    ///< Default initial state
+constexpr std::uint64_t PCG64_STREAM_DEFAULT = 0x7d3e9cb6cfe0549bULL;   ///< Default stream
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief PCG with 64 bit state and 32 bit output
+///
+/// The state is 16 bytes (state and stream increment), seeding is a few
+/// multiplications. Generators with equal seed but different streams are
+/// independent, e.g. one per worker thread. With \ref advance, a single
+/// stream can be partitioned instead, jumping ahead in logarithmic time.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CPCG32
+{
+
+    public:
+
+        typedef std::uint32_t result_type;  ///< Type of generated numbers
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CPCG32(const std::uint64_t _nSeed = PCG32_STATE_DEFAULT,
+               const std::uint64_t _nStream = PCG32_STREAM_DEFAULT) {this->seed(_nSeed, _nStream);}
+
+        //--- Static Methods -------------------------------------------------//
+        static constexpr result_type min() {return 0u;}
+        static constexpr result_type max() {return std::numeric_limits<result_type>::max();}
+
+        //--- Methods --------------------------------------------------------//
+        result_type operator()();
+        void        advance(std::uint64_t);
+        result_type bounded(const result_type);
+        void        discard(const std::uint64_t _nNr) {this->advance(_nNr);}
+        void        seed(const std::uint64_t, const std::uint64_t = PCG32_STREAM_DEFAULT);
+
+    private:
+
+        //--- Variables [private] --------------------------------------------//
+        std::uint64_t m_nState;     ///< State of LCG
+        std::uint64_t m_nInc;       ///< Increment of LCG, odd, selects stream
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief PCG with 128 bit state and 64 bit output
+///
+/// The 128 bit arithmetic is implemented by two 64 bit halves, using the
+/// compilers 128 bit integers for multiplication if available. Usage is
+/// equal to \ref CPCG32.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CPCG64
+{
+
+    public:
+
+        typedef std::uint64_t result_type;  ///< Type of generated numbers
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CPCG64(const std::uint64_t _nSeed = PCG64_STATE_DEFAULT,
+               const std::uint64_t _nStream = PCG64_STREAM_DEFAULT) {this->seed(_nSeed, _nStream);}
+
+        //--- Static Methods -------------------------------------------------//
+        static constexpr result_type min() {return 0u;}
+        static constexpr result_type max() {return std::numeric_limits<result_type>::max();}
+
+        //--- Methods --------------------------------------------------------//
+        result_type operator()();
+        void        advance(std::uint64_t);
+        result_type bounded(const result_type);
+        void        discard(const std::uint64_t _nNr) {this->advance(_nNr);}
+        void        seed(const std::uint64_t, const std::uint64_t = PCG64_STREAM_DEFAULT);
+
+    private:
+
+        /// Unsigned 128 bit integer
+        struct UInt128Type
+        {
+            std::uint64_t nHi;  ///< Upper 64 bit
+            std::uint64_t nLo;  ///< Lower 64 bit
+        };
+
+        //--- Static Methods [private] ---------------------------------------//
+        static UInt128Type add(const UInt128Type&, const UInt128Type&);
+        static UInt128Type mul(const UInt128Type&, const UInt128Type&);
+
+        //--- Variables [private] --------------------------------------------//
+        UInt128Type m_State;    ///< State of LCG
+        UInt128Type m_Inc;      ///< Increment of LCG, odd, selects stream
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns next random number
+///
+/// \return Random number
+///
+////////////////////////////////////////////////////////////////////////////////
+inline CPCG32::result_type CPCG32::operator()()
+{
+    const std::uint64_t nOld = m_nState;
+    m_nState = nOld * PCG32_MULTIPLIER + m_nInc;
+
+    const std::uint32_t nXorShifted = std::uint32_t(((nOld >> 18u) ^ nOld) >> 27u);
+    const std::uint32_t nRot = std::uint32_t(nOld >> 59u);
+    return (nXorShifted >> nRot) | (nXorShifted << ((32u - nRot) & 31u));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Jumps ahead in stream, as if given number of random numbers were
+///        drawn
+///
+/// \param _nDelta Number of random numbers to skip
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CPCG32::advance(std::uint64_t _nDelta)
+{
+    std::uint64_t nAccMult = 1u;
+    std::uint64_t nAccPlus = 0u;
+    std::uint64_t nCurMult = PCG32_MULTIPLIER;
+    std::uint64_t nCurPlus = m_nInc;
+
+    while (_nDelta > 0u)
+    {
+        if (_nDelta & 1u)
+        {
+            nAccMult *= nCurMult;
+            nAccPlus = nAccPlus * nCurMult + nCurPlus;
+        }
+        nCurPlus = (nCurMult + 1u) * nCurPlus;
+        nCurMult *= nCurMult;
+        _nDelta >>= 1u;
+    }
+    m_nState = nAccMult * m_nState + nAccPlus;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns uniformly distributed random number in [0, _nBound)
+///
+/// Unbiased, using multiplication instead of division in most cases
+/// (D. Lemire, "Fast Random Integer Generation in an Interval").
+///
+/// \param _nBound Upper bound, exclusive
+///
+/// \return Random number
+///
+////////////////////////////////////////////////////////////////////////////////
+inline CPCG32::result_type CPCG32::bounded(const result_type _nBound)
+{
+    std::uint64_t nM = std::uint64_t((*this)()) * _nBound;
+    std::uint32_t nL = std::uint32_t(nM);
+    if (nL < _nBound)
+    {
+        const std::uint32_t nT = (0u - _nBound) % _nBound;
+        while (nL < nT)
+        {
+            nM = std::uint64_t((*this)()) * _nBound;
+            nL = std::uint32_t(nM);
+        }
+    }
+    return std::uint32_t(nM >> 32u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Seeds generator
+///
+/// \param _nSeed Initial state
+/// \param _nStream Stream, generators of different streams are independent
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CPCG32::seed(const std::uint64_t _nSeed, const std::uint64_t _nStream)
+{
+    m_nInc = (_nStream << 1u) | 1u;
+    m_nState = (_nSeed + m_nInc) * PCG32_MULTIPLIER + m_nInc;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns next random number
+///
+/// \return Random number
+///
+////////////////////////////////////////////////////////////////////////////////
+inline CPCG64::result_type CPCG64::operator()()
+{
+    m_State = add(mul(m_State, {PCG64_MULTIPLIER_HI, PCG64_MULTIPLIER_LO}), m_Inc);
+
+    const std::uint64_t nXor = m_State.nHi ^ m_State.nLo;
+    const std::uint32_t nRot = std::uint32_t(m_State.nHi >> 58u);
+    return (nXor >> nRot) | (nXor << ((64u - nRot) & 63u));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Jumps ahead in stream, as if given number of random numbers were
+///        drawn
+///
+/// \param _nDelta Number of random numbers to skip
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CPCG64::advance(std::uint64_t _nDelta)
+{
+    UInt128Type AccMult = {0u, 1u};
+    UInt128Type AccPlus = {0u, 0u};
+    UInt128Type CurMult = {PCG64_MULTIPLIER_HI, PCG64_MULTIPLIER_LO};
+    UInt128Type CurPlus = m_Inc;
+
+    while (_nDelta > 0u)
+    {
+        if (_nDelta & 1u)
+        {
+            AccMult = mul(AccMult, CurMult);
+            AccPlus = add(mul(AccPlus, CurMult), CurPlus);
+        }
+        CurPlus = mul(add(CurMult, {0u, 1u}), CurPlus);
+        CurMult = mul(CurMult, CurMult);
+        _nDelta >>= 1u;
+    }
+    m_State = add(mul(AccMult, m_State), AccPlus);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns uniformly distributed random number in [0, _nBound)
+///
+/// \param _nBound Upper bound, exclusive
+///
+/// \return Random number
+///
+////////////////////////////////////////////////////////////////////////////////
+inline CPCG64::result_type CPCG64::bounded(const result_type _nBound)
+{
+    // Numbers below threshold would introduce bias
+    const std::uint64_t nThreshold = (0u - _nBound) % _nBound;
+    std::uint64_t nR = (*this)();
+    while (nR < nThreshold) nR = (*this)();
+    return nR % _nBound;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Seeds generator
+///
+/// \param _nSeed Initial state
+/// \param _nStream Stream, generators of different streams are independent
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CPCG64::seed(const std::uint64_t _nSeed, const std::uint64_t _nStream)
+{
+    m_Inc = {_nStream >> 63u, (_nStream << 1u) | 1u};
+    m_State = add(mul(add({0u, _nSeed}, m_Inc), {PCG64_MULTIPLIER_HI, PCG64_MULTIPLIER_LO}), m_Inc);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds two 128 bit integers, modulo 2^128
+///
+/// \param _A First summand
+/// \param _B Second summand
+///
+/// \return Sum
+///
+////////////////////////////////////////////////////////////////////////////////
+inline CPCG64::UInt128Type CPCG64::add(const UInt128Type& _A, const UInt128Type& _B)
+{
+    const std::uint64_t nLo = _A.nLo + _B.nLo;
+    return {_A.nHi + _B.nHi + (nLo < _A.nLo ? 1u : 0u), nLo};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Multiplies two 128 bit integers, modulo 2^128
+///
+/// \param _A First factor
+/// \param _B Second factor
+///
+/// \return Product
+///
+////////////////////////////////////////////////////////////////////////////////
+inline CPCG64::UInt128Type CPCG64::mul(const UInt128Type& _A, const UInt128Type& _B)
+{
+    #ifdef __SIZEOF_INT128__
+        __extension__ typedef unsigned __int128 UInt128Native;
+        const UInt128Native nLoLo = UInt128Native(_A.nLo) * _B.nLo;
+        const std::uint64_t nLoLoHi = std::uint64_t(nLoLo >> 64u);
+        const std::uint64_t nLoLoLo = std::uint64_t(nLoLo);
+    #else
+        // Full 64x64 bit product of lower halves by 32 bit parts
+        const std::uint64_t nA0 = _A.nLo & 0xffffffffu;
+        const std::uint64_t nA1 = _A.nLo >> 32u;
+        const std::uint64_t nB0 = _B.nLo & 0xffffffffu;
+        const std::uint64_t nB1 = _B.nLo >> 32u;
+        const std::uint64_t nP00 = nA0 * nB0;
+        const std::uint64_t nP01 = nA0 * nB1;
+        const std::uint64_t nP10 = nA1 * nB0;
+        const std::uint64_t nP11 = nA1 * nB1;
+        const std::uint64_t nMid = (nP00 >> 32u) + (nP01 & 0xffffffffu) + (nP10 & 0xffffffffu);
+        const std::uint64_t nLoLoHi = nP11 + (nP01 >> 32u) + (nP10 >> 32u) + (nMid >> 32u);
+        const std::uint64_t nLoLoLo = (nMid << 32u) | (nP00 & 0xffffffffu);
+    #endif
+    return {nLoLoHi + _A.nLo * _B.nHi + _A.nHi * _B.nLo, nLoLoLo};
+}
+
+} // namespace bfe
+
+#endif // PCG_RANDOM_H